@@ -3,9 +3,9 @@
  * SPDX-License-Identifier: Apache-2.0.
  */
 
+#include <aws/checksums/checksums.h>
 #include <aws/checksums/crc.h>
-#include <aws/checksums/private/crc64_priv.h>
-#include <aws/checksums/private/crc32_priv.h>
+#include <aws/checksums/crc_kernels.h>
 
 #include <aws/common/allocator.h>
 #include <aws/common/byte_buf.h>
@@ -21,41 +21,43 @@ struct aws_allocator_types {
 };
 
 struct checksum_profile_run {
-    void (*profile_run)(struct aws_byte_cursor checksum_this);
-    const char *name;
+    void (*profile_run)(const struct checksum_profile_run *run, struct aws_byte_cursor checksum_this);
+    /* set for runs of a single kernel from the registry */
+    uint32_t (*crc32_fn)(const uint8_t *input, int length, uint32_t previous_crc);
+    uint64_t (*crc64_fn)(const uint8_t *input, int length, uint64_t previous_crc);
+    char name[64];
 };
 
-static void s_runcrc32_sw(struct aws_byte_cursor checksum_this) {
-    uint32_t crc = aws_checksums_crc32_sw(checksum_this.ptr, (int)checksum_this.len, 0);
+static void s_run_crc32_kernel(const struct checksum_profile_run *run, struct aws_byte_cursor checksum_this) {
+    uint32_t crc = run->crc32_fn(checksum_this.ptr, (int)checksum_this.len, 0);
     (void)crc;
 }
 
-static void s_runcrc32(struct aws_byte_cursor checksum_this) {
-    uint32_t crc = aws_checksums_crc32(checksum_this.ptr, (int)checksum_this.len, 0);
+static void s_run_crc64_kernel(const struct checksum_profile_run *run, struct aws_byte_cursor checksum_this) {
+    uint64_t crc = run->crc64_fn(checksum_this.ptr, (int)checksum_this.len, 0);
     (void)crc;
 }
 
-static void s_runcrc32c_sw(struct aws_byte_cursor checksum_this) {
-    uint32_t crc = aws_checksums_crc32c_sw(checksum_this.ptr, (int)checksum_this.len, 0);
+static void s_runcrc32(const struct checksum_profile_run *run, struct aws_byte_cursor checksum_this) {
+    (void)run;
+    uint32_t crc = aws_checksums_crc32(checksum_this.ptr, (int)checksum_this.len, 0);
     (void)crc;
 }
 
-static void s_runcrc32c(struct aws_byte_cursor checksum_this) {
+static void s_runcrc32c(const struct checksum_profile_run *run, struct aws_byte_cursor checksum_this) {
+    (void)run;
     uint32_t crc = aws_checksums_crc32c(checksum_this.ptr, (int)checksum_this.len, 0);
     (void)crc;
 }
 
-static void s_runcrc64_sw(struct aws_byte_cursor checksum_this) {
-    uint64_t crc = aws_checksums_crc64nvme_sw(checksum_this.ptr, (int)checksum_this.len, 0);
-    (void)crc;
-}
-
-static void s_runcrc64(struct aws_byte_cursor checksum_this) {
+static void s_runcrc64(const struct checksum_profile_run *run, struct aws_byte_cursor checksum_this) {
+    (void)run;
     uint64_t crc = aws_checksums_crc64nvme(checksum_this.ptr, (int)checksum_this.len, 0);
     (void)crc;
 }
 
-static void s_runcrc64_multi(struct aws_byte_cursor checksum_this) {
+static void s_runcrc64_multi(const struct checksum_profile_run *run, struct aws_byte_cursor checksum_this) {
+    (void)run;
     if (checksum_this.len <= 8 * 1024) {
         uint64_t crc = aws_checksums_crc64nvme(checksum_this.ptr, (int)checksum_this.len, 0);
         (void)crc;
@@ -72,6 +74,15 @@ static void s_runcrc64_multi(struct aws_byte_cursor checksum_this) {
     }
 }
 
+static void s_add_run(
+    struct checksum_profile_run *runs,
+    size_t *runs_len,
+    size_t runs_capacity,
+    struct checksum_profile_run run) {
+    AWS_FATAL_ASSERT(*runs_len < runs_capacity);
+    runs[(*runs_len)++] = run;
+}
+
 #define KB_TO_BYTES(kb) ((kb) * 1024)
 #define MB_TO_BYTES(mb) ((mb) * 1024 * 1024)
 #define GB_TO_BYTES(gb) ((gb) * 1024 * 1024 * 1024ULL)
@@ -96,20 +107,56 @@ int main(void) {
     allocators[1].allocator = aws_aligned_allocator();
     allocators[1].name = "Aligned allocator";
 
-    struct checksum_profile_run profile_runs[] = {
-        {.profile_run = s_runcrc32_sw, .name = "crc32 C only"},
-        {.profile_run = s_runcrc32, .name = "crc32 with hw optimizations"},
-        {.profile_run = s_runcrc32c_sw, .name = "crc32c C only"},
-        {.profile_run = s_runcrc32c, .name = "crc32c with hw optimizations"},
-        {.profile_run = s_runcrc64_sw, .name = "crc64nvme C only"},
-        {.profile_run = s_runcrc64, .name = "crc64nvme with hw optimizations"},
-        {.profile_run = s_runcrc64_multi, .name = "crc64nvme with hw optimizations(multi)"},
-    };
+    aws_checksums_library_init(allocators[0].allocator);
+
+    struct checksum_profile_run profile_runs[32];
+    size_t profile_runs_len = 0;
+
+    /* every kernel this cpu supports, called directly, followed by the dispatched entry points */
+    for (size_t algorithm = 0; algorithm < AWS_CHECKSUMS_CRC_ALGORITHM_COUNT; ++algorithm) {
+        size_t kernel_count = aws_checksums_crc_kernel_count(algorithm);
+        for (size_t i = 0; i < kernel_count; ++i) {
+            struct aws_checksums_crc_kernel_info info;
+            aws_checksums_crc_kernel_get_info(algorithm, i, &info);
+            if (!info.supported) {
+                continue;
+            }
+
+            struct checksum_profile_run run = {
+                .profile_run = info.crc32_fn != NULL ? s_run_crc32_kernel : s_run_crc64_kernel,
+                .crc32_fn = info.crc32_fn,
+                .crc64_fn = info.crc64_fn,
+            };
+            snprintf(run.name, sizeof(run.name), "%s %s", aws_checksums_crc_algorithm_name(algorithm), info.name);
+            s_add_run(profile_runs, &profile_runs_len, AWS_ARRAY_SIZE(profile_runs), run);
+        }
+    }
+
+    s_add_run(
+        profile_runs,
+        &profile_runs_len,
+        AWS_ARRAY_SIZE(profile_runs),
+        (struct checksum_profile_run){.profile_run = s_runcrc32, .name = "crc32 with hw optimizations"});
+    s_add_run(
+        profile_runs,
+        &profile_runs_len,
+        AWS_ARRAY_SIZE(profile_runs),
+        (struct checksum_profile_run){.profile_run = s_runcrc32c, .name = "crc32c with hw optimizations"});
+    s_add_run(
+        profile_runs,
+        &profile_runs_len,
+        AWS_ARRAY_SIZE(profile_runs),
+        (struct checksum_profile_run){.profile_run = s_runcrc64, .name = "crc64nvme with hw optimizations"});
+    s_add_run(
+        profile_runs,
+        &profile_runs_len,
+        AWS_ARRAY_SIZE(profile_runs),
+        (struct checksum_profile_run){
+            .profile_run = s_runcrc64_multi, .name = "crc64nvme with hw optimizations(multi)"});
 
     const size_t allocators_array_size = AWS_ARRAY_SIZE(allocators);
-    const size_t profile_runs_size = AWS_ARRAY_SIZE(profile_runs);
 
-    for (size_t i = 0; i < profile_runs_size; ++i) {
+    for (size_t i = 0; i < profile_runs_len; ++i) {
         fprintf(stdout, "--------Profile %s---------\n", profile_runs[i].name);
 
         for (size_t j = 0; j < allocators_array_size; ++j) {
@@ -125,7 +172,7 @@ int main(void) {
 
             // warm it up to factor out the cpuid checks:
             struct aws_byte_cursor warmup_cur = aws_byte_cursor_from_array(buffer_sizes, buffer_sizes_len);
-            profile_runs[i].profile_run(warmup_cur);
+            profile_runs[i].profile_run(&profile_runs[i], warmup_cur);
 
             for (size_t k = 0; k < buffer_sizes_len; ++k) {
                 struct aws_byte_buf x_bytes;
@@ -133,7 +180,7 @@ int main(void) {
                 aws_device_random_buffer(&x_bytes);
                 uint64_t start_time = 0;
                 aws_high_res_clock_get_ticks(&start_time);
-                profile_runs[i].profile_run(aws_byte_cursor_from_buf(&x_bytes));
+                profile_runs[i].profile_run(&profile_runs[i], aws_byte_cursor_from_buf(&x_bytes));
                 uint64_t end_time = 0;
                 aws_high_res_clock_get_ticks(&end_time);
                 fprintf(
@@ -147,5 +194,7 @@ int main(void) {
             fprintf(stdout, "\n");
         }
     }
+
+    aws_checksums_library_clean_up();
     return 0;
 }
@@ -0,0 +1,103 @@
+#ifndef AWS_CHECKSUMS_CHECKSUM_H
+#define AWS_CHECKSUMS_CHECKSUM_H
+/**
+ * Copyright Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0.
+ */
+
+#include <aws/checksums/exports.h>
+#include <aws/common/byte_buf.h>
+
+AWS_PUSH_SANE_WARNING_LEVEL
+
+/*
+ * One streaming interface for every algorithm in the library, for callers that pick the algorithm at runtime.
+ * struct aws_checksum holds the state of any algorithm inline, so it can live on the stack or inside another struct
+ * and checksumming needs no heap allocation.
+ */
+
+enum aws_checksum_algorithm {
+    AWS_CHECKSUM_CRC32,
+    AWS_CHECKSUM_CRC32C,
+    AWS_CHECKSUM_CRC64NVME,
+    AWS_CHECKSUM_XXHASH64,
+    AWS_CHECKSUM_XXHASH3_64,
+    AWS_CHECKSUM_XXHASH3_128,
+    AWS_CHECKSUM_ALGORITHM_COUNT,
+};
+
+/* Largest digest of any algorithm (XXHASH3_128), in bytes. */
+#define AWS_CHECKSUM_MAX_DIGEST_SIZE 16
+
+/* Bytes reserved for the largest algorithm state (XXH3's). Checked against the real size when building the library. */
+#define AWS_CHECKSUM_STATE_SIZE 640
+
+struct aws_checksum_state_storage {
+    uint64_t words[AWS_CHECKSUM_STATE_SIZE / sizeof(uint64_t)];
+};
+
+/* xxhash3 states need 64 byte alignment for their vector accumulators */
+AWS_ALIGNED_TYPEDEF(struct aws_checksum_state_storage, aws_checksum_state_storage_t, 64);
+
+/*
+ * Treat the members as private. Plain struct copies are fine and duplicate the stream at that point.
+ */
+struct aws_checksum {
+    enum aws_checksum_algorithm algorithm;
+    uint64_t seed;
+    union {
+        uint32_t crc32;
+        uint64_t crc64;
+        aws_checksum_state_storage_t xxhash;
+    } state;
+};
+
+AWS_EXTERN_C_BEGIN
+
+/**
+ * Initializes checksum in place for algorithm. For the xxhashes seed is the hash seed, for the crcs it is the
+ * previous crc to continue from (truncated to 32 bits for the crc32s), so 0 starts a new one.
+ * Raises AWS_ERROR_INVALID_ARGUMENT for an unknown algorithm.
+ * Nothing needs to be cleaned up afterwards.
+ */
+AWS_CHECKSUMS_API int aws_checksum_init(
+    struct aws_checksum *checksum,
+    enum aws_checksum_algorithm algorithm,
+    uint64_t seed);
+
+/**
+ * Returns checksum to the state right after aws_checksum_init(), with the same algorithm and seed.
+ */
+AWS_CHECKSUMS_API int aws_checksum_reset(struct aws_checksum *checksum);
+
+/**
+ * Update checksum state from the data.
+ * Can return error. Checksum is unusable after error until reset.
+ */
+AWS_CHECKSUMS_API int aws_checksum_update(struct aws_checksum *checksum, struct aws_byte_cursor data);
+
+/**
+ * Appends the digest of the data so far to out, in big-endian (network) order. out needs
+ * aws_checksum_digest_size() bytes of free capacity, otherwise AWS_ERROR_INVALID_BUFFER_SIZE is raised.
+ * Finalizing does not end the stream, more data can be pushed through the checksum after.
+ */
+AWS_CHECKSUMS_API int aws_checksum_finalize(struct aws_checksum *checksum, struct aws_byte_buf *out);
+
+/**
+ * Returns the digest size of algorithm in bytes, or 0 for an unknown algorithm.
+ */
+AWS_CHECKSUMS_API size_t aws_checksum_digest_size(enum aws_checksum_algorithm algorithm);
+
+/**
+ * One-shot. Appends the digest of data to out, same as init, update and finalize.
+ */
+AWS_CHECKSUMS_API int aws_checksum_compute(
+    enum aws_checksum_algorithm algorithm,
+    uint64_t seed,
+    struct aws_byte_cursor data,
+    struct aws_byte_buf *out);
+
+AWS_EXTERN_C_END
+AWS_POP_SANE_WARNING_LEVEL
+
+#endif /* AWS_CHECKSUMS_CHECKSUM_H */
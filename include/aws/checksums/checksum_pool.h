@@ -0,0 +1,63 @@
+#ifndef AWS_CHECKSUMS_CHECKSUM_POOL_H
+#define AWS_CHECKSUMS_CHECKSUM_POOL_H
+/**
+ * Copyright Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0.
+ */
+
+#include <aws/checksums/checksum.h>
+
+AWS_PUSH_SANE_WARNING_LEVEL
+
+/*
+ * Recycles struct aws_checksum contexts of one algorithm and seed, for servers running many concurrent streams.
+ * Contexts come out of the pool already initialized and cache line aligned, and go back reset and ready for the next
+ * stream. Each thread keeps a small free list of its own, so acquire and release usually take no lock and touch
+ * memory that is already in that thread's cache. The pool refills and drains the per-thread lists in batches, under
+ * a lock, from a shared list backed by slabs of contexts.
+ *
+ * A context may be released on a different thread from the one that acquired it. Contexts cached by a thread that
+ * exits are not reused, but their memory is still freed with the pool.
+ */
+struct aws_checksum_pool;
+
+AWS_EXTERN_C_BEGIN
+
+/**
+ * Creates a pool handing out contexts initialized as by aws_checksum_init(checksum, algorithm, seed).
+ * Returns NULL and raises AWS_ERROR_INVALID_ARGUMENT for an unknown algorithm.
+ */
+AWS_CHECKSUMS_API struct aws_checksum_pool *aws_checksum_pool_new(
+    struct aws_allocator *allocator,
+    enum aws_checksum_algorithm algorithm,
+    uint64_t seed);
+
+/**
+ * Frees the pool and every context it handed out. No context from the pool may be in use anymore.
+ */
+AWS_CHECKSUMS_API void aws_checksum_pool_destroy(struct aws_checksum_pool *pool);
+
+/**
+ * Returns a context ready for aws_checksum_update(). Hand it back with aws_checksum_pool_finalize() or
+ * aws_checksum_pool_release().
+ */
+AWS_CHECKSUMS_API struct aws_checksum *aws_checksum_pool_acquire(struct aws_checksum_pool *pool);
+
+/**
+ * Appends the digest of checksum to out, as aws_checksum_finalize() does, then returns checksum to the pool.
+ * checksum goes back to the pool even if writing the digest fails.
+ */
+AWS_CHECKSUMS_API int aws_checksum_pool_finalize(
+    struct aws_checksum_pool *pool,
+    struct aws_checksum *checksum,
+    struct aws_byte_buf *out);
+
+/**
+ * Returns checksum to the pool without producing a digest, e.g. for an aborted stream. NULL is a no-op.
+ */
+AWS_CHECKSUMS_API void aws_checksum_pool_release(struct aws_checksum_pool *pool, struct aws_checksum *checksum);
+
+AWS_EXTERN_C_END
+AWS_POP_SANE_WARNING_LEVEL
+
+#endif /* AWS_CHECKSUMS_CHECKSUM_POOL_H */
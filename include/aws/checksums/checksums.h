@@ -19,6 +19,42 @@ AWS_EXTERN_C_BEGIN
  */
 AWS_CHECKSUMS_API void aws_checksums_library_init(struct aws_allocator *allocator);
 
+/**
+ * Optional tuning for aws_checksums_library_init_with_options().
+ */
+struct aws_checksums_library_options {
+    /**
+     * Cpu feature flags do not always predict the fastest crc kernel (i.e. vpclmulqdq vs crc32q on some parts,
+     * avx512 downclocking, differences between Graviton generations). When set, init microbenchmarks every
+     * compiled-in kernel of every crc algorithm for each input size class and installs the fastest. This takes a
+     * few milliseconds.
+     * Calibration can also be enabled without code changes by setting the AWS_CHECKSUMS_CALIBRATION environment
+     * variable to "calibrate".
+     */
+    bool calibrate;
+
+    /**
+     * Optional. When calibrating, a result previously saved to this file is installed instead of re-running the
+     * microbenchmarks, as long as every kernel it names is supported on this host. Otherwise calibration runs and
+     * its result is written to the file. Lets a fleet of identical hosts pay the calibration cost once.
+     */
+    const char *calibration_file_path;
+};
+
+/**
+ * Same as aws_checksums_library_init(), with additional options. options can be NULL.
+ *
+ * If the AWS_CHECKSUMS_CALIBRATION environment variable holds a calibration result (the contents of a file written
+ * via calibration_file_path), it is installed and takes precedence over both options.
+ * Builds using AWS_CHECKSUMS_STATIC_DISPATCH fix the kernels at compile time, so they ignore both options and the
+ * environment variable.
+ * Kernels pinned via the AWS_CHECKSUMS_CRC_KERNEL_PIN environment variable (see crc_kernels.h) are applied after
+ * calibration and override its choices.
+ */
+AWS_CHECKSUMS_API void aws_checksums_library_init_with_options(
+    struct aws_allocator *allocator,
+    const struct aws_checksums_library_options *options);
+
 /**
  * Shuts down the internal data structures used by aws-checksums.
  */
@@ -6,10 +6,21 @@
  */
 
 #include <aws/checksums/exports.h>
+#include <aws/common/byte_buf.h>
 #include <aws/common/macros.h>
 #include <aws/common/stdint.h>
 
 AWS_PUSH_SANE_WARNING_LEVEL
+
+/**
+ * One part of a larger object, for the combine_many functions: the checksum of the part and its length in bytes.
+ * CRC32 and CRC32C checksums are stored in the low 32 bits of crc.
+ */
+struct aws_crc_segment {
+    uint64_t crc;
+    uint64_t length;
+};
+
 AWS_EXTERN_C_BEGIN
 
 /**
@@ -67,6 +78,131 @@ AWS_CHECKSUMS_API uint64_t aws_checksums_crc64nvme(const uint8_t *input, int len
  */
 AWS_CHECKSUMS_API uint64_t aws_checksums_crc64nvme_ex(const uint8_t *input, size_t length, uint64_t previous_crc64);
 
+/**
+ * Computes the CRC32 (Ethernet, gzip) of the concatenation of count segments, i.e. a message received as a chain of
+ * fragments. Produces the same result as calling aws_checksums_crc32_ex() on each segment in order, but small
+ * segments are coalesced so a chain of many fragments costs about the same as one contiguous buffer.
+ * Pass 0 in the previous_crc32 parameter as an initial value unless continuing to update a running crc.
+ */
+AWS_CHECKSUMS_API uint32_t aws_checksums_crc32_iov(
+    const struct aws_byte_cursor *segments,
+    size_t count,
+    uint32_t previous_crc32);
+
+/**
+ * Computes the Castagnoli CRC32c (iSCSI) of the concatenation of count segments, i.e. a message received as a chain
+ * of fragments. Produces the same result as calling aws_checksums_crc32c_ex() on each segment in order, but small
+ * segments are coalesced so a chain of many fragments costs about the same as one contiguous buffer.
+ * Pass 0 in the previous_crc32c parameter as an initial value unless continuing to update a running crc.
+ */
+AWS_CHECKSUMS_API uint32_t aws_checksums_crc32c_iov(
+    const struct aws_byte_cursor *segments,
+    size_t count,
+    uint32_t previous_crc32c);
+
+/**
+ * Computes the CRC64-NVME of the concatenation of count segments, i.e. a message received as a chain of fragments.
+ * Produces the same result as calling aws_checksums_crc64nvme_ex() on each segment in order, but small segments are
+ * coalesced so a chain of many fragments costs about the same as one contiguous buffer.
+ * Pass 0 in the previous_crc64 parameter as an initial value unless continuing to update a running crc.
+ */
+AWS_CHECKSUMS_API uint64_t aws_checksums_crc64nvme_iov(
+    const struct aws_byte_cursor *segments,
+    size_t count,
+    uint64_t previous_crc64);
+
+/**
+ * Copies length bytes from src to dst (which must not overlap, as with memcpy) and returns the CRC32 (Ethernet, gzip)
+ * of the copied bytes. Same result as aws_checksums_crc32_ex() over src, but the data is read from memory once
+ * instead of once for the copy and again for the checksum.
+ * Pass 0 in the previous_crc32 parameter as an initial value unless continuing to update a running crc.
+ */
+AWS_CHECKSUMS_API uint32_t aws_checksums_crc32_copy(
+    uint8_t *dst,
+    const uint8_t *src,
+    size_t length,
+    uint32_t previous_crc32);
+
+/**
+ * Same as aws_checksums_crc32_copy(), but writes dst with non-temporal (cache bypassing) stores where the cpu has
+ * them. Use it for large copies into memory that is not read again soon, e.g. a page cache or arena buffer, so the
+ * copy does not evict everything else from the caches. On small buffers it is slower than the regular version.
+ */
+AWS_CHECKSUMS_API uint32_t aws_checksums_crc32_copy_nt(
+    uint8_t *dst,
+    const uint8_t *src,
+    size_t length,
+    uint32_t previous_crc32);
+
+/**
+ * Copies length bytes from src to dst (which must not overlap, as with memcpy) and returns the Castagnoli CRC32c
+ * (iSCSI) of the copied bytes. See aws_checksums_crc32_copy().
+ * Pass 0 in the previous_crc32c parameter as an initial value unless continuing to update a running crc.
+ */
+AWS_CHECKSUMS_API uint32_t aws_checksums_crc32c_copy(
+    uint8_t *dst,
+    const uint8_t *src,
+    size_t length,
+    uint32_t previous_crc32c);
+
+/**
+ * Non-temporal store version of aws_checksums_crc32c_copy(). See aws_checksums_crc32_copy_nt().
+ */
+AWS_CHECKSUMS_API uint32_t aws_checksums_crc32c_copy_nt(
+    uint8_t *dst,
+    const uint8_t *src,
+    size_t length,
+    uint32_t previous_crc32c);
+
+/**
+ * Copies length bytes from src to dst (which must not overlap, as with memcpy) and returns the CRC64-NVME of the
+ * copied bytes. See aws_checksums_crc32_copy().
+ * Pass 0 in the previous_crc64 parameter as an initial value unless continuing to update a running crc.
+ */
+AWS_CHECKSUMS_API uint64_t aws_checksums_crc64nvme_copy(
+    uint8_t *dst,
+    const uint8_t *src,
+    size_t length,
+    uint64_t previous_crc64);
+
+/**
+ * Non-temporal store version of aws_checksums_crc64nvme_copy(). See aws_checksums_crc32_copy_nt().
+ */
+AWS_CHECKSUMS_API uint64_t aws_checksums_crc64nvme_copy_nt(
+    uint8_t *dst,
+    const uint8_t *src,
+    size_t length,
+    uint64_t previous_crc64);
+
+/**
+ * Computes the CRC32 (Ethernet, gzip) of count independent buffers, writing the crc of inputs[i] to out_crcs[i].
+ * Equivalent to calling aws_checksums_crc32_ex() on each buffer with a previous crc of 0, but on cpus with a crc32
+ * instruction, small buffers are processed four at a time to raise throughput on a single core.
+ */
+AWS_CHECKSUMS_API void aws_checksums_crc32_batch(
+    const struct aws_byte_cursor *inputs,
+    uint32_t *out_crcs,
+    size_t count);
+
+/**
+ * Computes the Castagnoli CRC32c (iSCSI) of count independent buffers, writing the crc of inputs[i] to out_crcs[i].
+ * Equivalent to calling aws_checksums_crc32c_ex() on each buffer with a previous crc of 0, but on cpus with a crc32c
+ * instruction, small buffers are processed four at a time to raise throughput on a single core.
+ */
+AWS_CHECKSUMS_API void aws_checksums_crc32c_batch(
+    const struct aws_byte_cursor *inputs,
+    uint32_t *out_crcs,
+    size_t count);
+
+/**
+ * Computes the CRC64-NVME of count independent buffers, writing the crc of inputs[i] to out_crcs[i].
+ * Equivalent to calling aws_checksums_crc64nvme_ex() on each buffer with a previous crc of 0.
+ */
+AWS_CHECKSUMS_API void aws_checksums_crc64nvme_batch(
+    const struct aws_byte_cursor *inputs,
+    uint64_t *out_crcs,
+    size_t count);
+
 /**
  * Combines two CRC32 (Ethernet, gzip) checksums computed over separate data blocks.
  * This is equivalent to computing the CRC32 of the concatenated data blocks without
@@ -130,6 +266,166 @@ AWS_CHECKSUMS_API uint32_t aws_checksums_crc32c_combine(uint32_t crc1, uint32_t
  */
 AWS_CHECKSUMS_API uint64_t aws_checksums_crc64nvme_combine(uint64_t crc1, uint64_t crc2, uint64_t len2);
 
+/**
+ * Extends a CRC32 (Ethernet, gzip) checksum with zero bytes without touching any data.
+ *
+ * Given:
+ *   crc = CRC32(data_block)
+ *
+ * This function computes:
+ *   result = CRC32(data_block || num_zero_bytes zero bytes)
+ *
+ * in O(log(num_zero_bytes)) time, e.g. to checksum holes in sparse files or zero filled extents.
+ *
+ * @param crc The CRC32 checksum of the data so far, 0 for no data
+ * @param num_zero_bytes The number of zero bytes appended to the data
+ * @return The CRC32 checksum of the data followed by the zero bytes
+ */
+AWS_CHECKSUMS_API uint32_t aws_checksums_crc32_zero_extend(uint32_t crc, uint64_t num_zero_bytes);
+
+/**
+ * Extends a CRC32C (Castagnoli, iSCSI) checksum with num_zero_bytes zero bytes without touching any data.
+ * See aws_checksums_crc32_zero_extend() for details.
+ */
+AWS_CHECKSUMS_API uint32_t aws_checksums_crc32c_zero_extend(uint32_t crc, uint64_t num_zero_bytes);
+
+/**
+ * Extends a CRC64-NVME (CRC64-Rocksoft) checksum with num_zero_bytes zero bytes without touching any data.
+ * See aws_checksums_crc32_zero_extend() for details.
+ */
+AWS_CHECKSUMS_API uint64_t aws_checksums_crc64nvme_zero_extend(uint64_t crc, uint64_t num_zero_bytes);
+
+/**
+ * Removes a known suffix from a CRC32 (Ethernet, gzip) checksum, the inverse of aws_checksums_crc32_combine().
+ *
+ * Given:
+ *   crc_ab = CRC32(data_block_A || data_block_B)
+ *   crc_b = CRC32(data_block_B)
+ *
+ * This function computes:
+ *   result = CRC32(data_block_A)
+ *
+ * in O(log(len_b)) time, e.g. after truncating a log segment or stripping a trailer, without rescanning data_block_A.
+ *
+ * @param crc_ab The CRC32 checksum of the whole data
+ * @param crc_b The CRC32 checksum of the removed suffix
+ * @param len_b The length (in bytes) of the removed suffix
+ * @return The CRC32 checksum of the remaining prefix
+ */
+AWS_CHECKSUMS_API uint32_t aws_checksums_crc32_uncombine_suffix(uint32_t crc_ab, uint32_t crc_b, uint64_t len_b);
+
+/**
+ * Removes a known prefix from a CRC32 (Ethernet, gzip) checksum.
+ *
+ * Given:
+ *   crc_ab = CRC32(data_block_A || data_block_B)
+ *   crc_a = CRC32(data_block_A)
+ *
+ * This function computes:
+ *   result = CRC32(data_block_B)
+ *
+ * in O(log(len_b)) time. Note that it takes the length of the remaining suffix, not of the removed prefix.
+ *
+ * @param crc_ab The CRC32 checksum of the whole data
+ * @param crc_a The CRC32 checksum of the removed prefix
+ * @param len_b The length (in bytes) of the remaining suffix
+ * @return The CRC32 checksum of the remaining suffix
+ */
+AWS_CHECKSUMS_API uint32_t aws_checksums_crc32_uncombine_prefix(uint32_t crc_ab, uint32_t crc_a, uint64_t len_b);
+
+/**
+ * Removes a known suffix from a CRC32C (Castagnoli, iSCSI) checksum.
+ * See aws_checksums_crc32_uncombine_suffix() for details.
+ */
+AWS_CHECKSUMS_API uint32_t aws_checksums_crc32c_uncombine_suffix(uint32_t crc_ab, uint32_t crc_b, uint64_t len_b);
+
+/**
+ * Removes a known prefix from a CRC32C (Castagnoli, iSCSI) checksum.
+ * See aws_checksums_crc32_uncombine_prefix() for details.
+ */
+AWS_CHECKSUMS_API uint32_t aws_checksums_crc32c_uncombine_prefix(uint32_t crc_ab, uint32_t crc_a, uint64_t len_b);
+
+/**
+ * Removes a known suffix from a CRC64-NVME (CRC64-Rocksoft) checksum.
+ * See aws_checksums_crc32_uncombine_suffix() for details.
+ */
+AWS_CHECKSUMS_API uint64_t aws_checksums_crc64nvme_uncombine_suffix(uint64_t crc_ab, uint64_t crc_b, uint64_t len_b);
+
+/**
+ * Removes a known prefix from a CRC64-NVME (CRC64-Rocksoft) checksum.
+ * See aws_checksums_crc32_uncombine_prefix() for details.
+ */
+AWS_CHECKSUMS_API uint64_t aws_checksums_crc64nvme_uncombine_prefix(uint64_t crc_ab, uint64_t crc_a, uint64_t len_b);
+
+/**
+ * Updates the CRC32 (Ethernet, gzip) of an object of total_len bytes after the len bytes at offset were overwritten,
+ * e.g. by a partial write to a stored block. old_bytes and new_bytes are the contents of that range before and after.
+ * Takes O(len + log(total_len)) time, without reading the rest of the object. offset + len must not exceed total_len.
+ *
+ * @param old_crc The CRC32 checksum of the object before the write
+ * @param total_len The length (in bytes) of the object
+ * @param offset Offset of the overwritten range within the object
+ * @param old_bytes The len bytes at offset before the write
+ * @param new_bytes The len bytes at offset after the write
+ * @param len The length (in bytes) of the overwritten range
+ * @return The CRC32 checksum of the object after the write
+ */
+AWS_CHECKSUMS_API uint32_t aws_checksums_crc32_patch(
+    uint32_t old_crc,
+    uint64_t total_len,
+    uint64_t offset,
+    const uint8_t *old_bytes,
+    const uint8_t *new_bytes,
+    size_t len);
+
+/**
+ * Updates the Castagnoli CRC32c (iSCSI) of an object after a range of it was overwritten.
+ * See aws_checksums_crc32_patch() for details.
+ */
+AWS_CHECKSUMS_API uint32_t aws_checksums_crc32c_patch(
+    uint32_t old_crc,
+    uint64_t total_len,
+    uint64_t offset,
+    const uint8_t *old_bytes,
+    const uint8_t *new_bytes,
+    size_t len);
+
+/**
+ * Updates the CRC64-NVME of an object after a range of it was overwritten.
+ * See aws_checksums_crc32_patch() for details.
+ */
+AWS_CHECKSUMS_API uint64_t aws_checksums_crc64nvme_patch(
+    uint64_t old_crc,
+    uint64_t total_len,
+    uint64_t offset,
+    const uint8_t *old_bytes,
+    const uint8_t *new_bytes,
+    size_t len);
+
+/**
+ * Combines the CRC32 (Ethernet, gzip) checksums of n consecutive parts into the CRC32 of their concatenation, e.g. a
+ * full object checksum from the part checksums of a multipart upload. The result is the same as folding the parts in
+ * order with aws_checksums_crc32_combine(), but runs of equal part lengths cost a few table lookups per part instead
+ * of a full combine, and mixed lengths are combined in several independent chains at once.
+ *
+ * @param segs The checksums and lengths of the parts, in order
+ * @param n The number of parts. 0 returns 0, the CRC32 of no data
+ * @return The CRC32 checksum of the whole object
+ */
+AWS_CHECKSUMS_API uint32_t aws_checksums_crc32_combine_many(const struct aws_crc_segment *segs, size_t n);
+
+/**
+ * Combines the CRC32C (Castagnoli, iSCSI) checksums of n consecutive parts into the checksum of their concatenation.
+ * See aws_checksums_crc32_combine_many() for details.
+ */
+AWS_CHECKSUMS_API uint32_t aws_checksums_crc32c_combine_many(const struct aws_crc_segment *segs, size_t n);
+
+/**
+ * Combines the CRC64-NVME (CRC64-Rocksoft) checksums of n consecutive parts into the checksum of their concatenation.
+ * See aws_checksums_crc32_combine_many() for details.
+ */
+AWS_CHECKSUMS_API uint64_t aws_checksums_crc64nvme_combine_many(const struct aws_crc_segment *segs, size_t n);
+
 AWS_EXTERN_C_END
 AWS_POP_SANE_WARNING_LEVEL
 
@@ -0,0 +1,96 @@
+#ifndef AWS_CHECKSUMS_CRC_KERNELS_H
+#define AWS_CHECKSUMS_CRC_KERNELS_H
+/**
+ * Copyright Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0.
+ */
+
+#include <aws/checksums/exports.h>
+#include <aws/common/common.h>
+
+AWS_PUSH_SANE_WARNING_LEVEL
+
+/*
+ * Registry of the crc implementations ("kernels") compiled into the library.
+ * By default the library picks a kernel per algorithm and input size based on cpu features. The functions below let
+ * callers see those choices, call a specific kernel directly, and override the choice (i.e. for A/B performance
+ * rollouts, or to pin a known-good kernel during an incident).
+ *
+ * Kernels can also be pinned without code changes through the AWS_CHECKSUMS_CRC_KERNEL_PIN environment variable,
+ * which aws_checksums_library_init() reads. It holds ';' separated algorithm=kernel pairs,
+ * i.e. "crc32c=sse42;crc64nvme=sw". Pairs naming an unknown or unsupported kernel are ignored.
+ *
+ * In builds using AWS_CHECKSUMS_STATIC_DISPATCH kernels are fixed at compile time and can not be pinned.
+ */
+
+enum aws_checksums_crc_algorithm {
+    AWS_CHECKSUMS_CRC_ALGORITHM_CRC32,
+    AWS_CHECKSUMS_CRC_ALGORITHM_CRC32C,
+    AWS_CHECKSUMS_CRC_ALGORITHM_CRC64NVME,
+    AWS_CHECKSUMS_CRC_ALGORITHM_COUNT,
+};
+
+struct aws_checksums_crc_kernel_info {
+    /* Short identifier that is stable across releases, i.e. "sw", "sse42", "avx512", "pmull". */
+    const char *name;
+
+    /* Comma separated cpu features the kernel requires, i.e. "avx512,vpclmulqdq". Empty for portable kernels. */
+    const char *required_features;
+
+    /* Whether this cpu has the required features. Only supported kernels may be called or pinned. */
+    bool supported;
+
+    /*
+     * Entry point of the kernel, with the same contract as the matching function in crc.h.
+     * crc32_fn is set for crc32 and crc32c kernels, crc64_fn for crc64nvme kernels.
+     */
+    uint32_t (*crc32_fn)(const uint8_t *input, int length, uint32_t previous_crc);
+    uint64_t (*crc64_fn)(const uint8_t *input, int length, uint64_t previous_crc);
+};
+
+AWS_EXTERN_C_BEGIN
+
+/**
+ * Returns the lowercase name of the algorithm, i.e. "crc32c", as used in AWS_CHECKSUMS_CRC_KERNEL_PIN.
+ */
+AWS_CHECKSUMS_API const char *aws_checksums_crc_algorithm_name(enum aws_checksums_crc_algorithm algorithm);
+
+/**
+ * Returns how many kernels are compiled in for the algorithm, including ones this cpu does not support.
+ */
+AWS_CHECKSUMS_API size_t aws_checksums_crc_kernel_count(enum aws_checksums_crc_algorithm algorithm);
+
+/**
+ * Fills out_info with the description of the kernel at index, where index < aws_checksums_crc_kernel_count().
+ * Raises AWS_ERROR_INVALID_INDEX if index is out of range.
+ */
+AWS_CHECKSUMS_API int aws_checksums_crc_kernel_get_info(
+    enum aws_checksums_crc_algorithm algorithm,
+    size_t index,
+    struct aws_checksums_crc_kernel_info *out_info);
+
+/**
+ * Returns the name of the kernel the algorithm currently uses for inputs of the given length.
+ */
+AWS_CHECKSUMS_API const char *aws_checksums_crc_active_kernel_name(
+    enum aws_checksums_crc_algorithm algorithm,
+    size_t input_length);
+
+/**
+ * Routes all inputs of the algorithm to the named kernel, replacing the default or calibrated choices.
+ * Raises AWS_ERROR_INVALID_ARGUMENT if no kernel of that name is compiled in or the cpu does not support it, and
+ * AWS_ERROR_UNSUPPORTED_OPERATION in builds using AWS_CHECKSUMS_STATIC_DISPATCH.
+ * Not synchronized with concurrent checksum calls: those keep using either the old or the new kernel, both of which
+ * produce identical results.
+ */
+AWS_CHECKSUMS_API int aws_checksums_crc_pin_kernel(enum aws_checksums_crc_algorithm algorithm, const char *kernel_name);
+
+/**
+ * Undoes aws_checksums_crc_pin_kernel() (or calibration), going back to the default kernel choices for this cpu.
+ */
+AWS_CHECKSUMS_API void aws_checksums_crc_unpin_kernel(enum aws_checksums_crc_algorithm algorithm);
+
+AWS_EXTERN_C_END
+AWS_POP_SANE_WARNING_LEVEL
+
+#endif /* AWS_CHECKSUMS_CRC_KERNELS_H */
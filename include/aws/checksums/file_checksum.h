@@ -0,0 +1,74 @@
+#ifndef AWS_CHECKSUMS_FILE_CHECKSUM_H
+#define AWS_CHECKSUMS_FILE_CHECKSUM_H
+/**
+ * Copyright Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0.
+ */
+
+#include <aws/checksums/parallel.h>
+
+AWS_PUSH_SANE_WARNING_LEVEL
+
+/*
+ * Checksums of files at rest. The range is memory mapped a window at a time and checksummed in place, with the
+ * kernel asked to read ahead of the cursor, so there is no read() into a heap buffer and no extra copy.
+ * The file must not be truncated while it is being checksummed: touching a mapped page past the end of the file
+ * raises SIGBUS on POSIX systems.
+ */
+
+/* Pass as length to checksum from offset to the end of the file. */
+#define AWS_CHECKSUMS_FILE_TO_END UINT64_MAX
+
+/* Bytes mapped at a time when aws_checksums_file_options.window_size is 0. */
+#define AWS_CHECKSUMS_FILE_DEFAULT_WINDOW_SIZE (64 * 1024 * 1024)
+
+struct aws_checksums_file_options {
+    /* Bytes mapped at a time, bounding the address space used. 0 uses AWS_CHECKSUMS_FILE_DEFAULT_WINDOW_SIZE. */
+    size_t window_size;
+
+    /* Optional. Checksums every window with multiple threads, see aws_checksums_crc32_parallel(). */
+    const struct aws_checksums_parallel_options *parallel;
+};
+
+AWS_EXTERN_C_BEGIN
+
+/**
+ * Computes the CRC32 (Ethernet, gzip) of length bytes of the file at path, starting at offset. Same result as
+ * aws_checksums_crc32_ex() over those bytes with a previous crc of 0. options can be NULL for defaults.
+ * Raises AWS_ERROR_INVALID_ARGUMENT if the range extends past the end of the file, and the translated io error if
+ * the file can't be opened or mapped.
+ */
+AWS_CHECKSUMS_API int aws_checksums_file_crc32(
+    struct aws_allocator *allocator,
+    const char *path,
+    uint64_t offset,
+    uint64_t length,
+    const struct aws_checksums_file_options *options,
+    uint32_t *out_crc32);
+
+/**
+ * Computes the Castagnoli CRC32c (iSCSI) of a range of a file. See aws_checksums_file_crc32().
+ */
+AWS_CHECKSUMS_API int aws_checksums_file_crc32c(
+    struct aws_allocator *allocator,
+    const char *path,
+    uint64_t offset,
+    uint64_t length,
+    const struct aws_checksums_file_options *options,
+    uint32_t *out_crc32c);
+
+/**
+ * Computes the CRC64-NVME of a range of a file. See aws_checksums_file_crc32().
+ */
+AWS_CHECKSUMS_API int aws_checksums_file_crc64nvme(
+    struct aws_allocator *allocator,
+    const char *path,
+    uint64_t offset,
+    uint64_t length,
+    const struct aws_checksums_file_options *options,
+    uint64_t *out_crc64);
+
+AWS_EXTERN_C_END
+AWS_POP_SANE_WARNING_LEVEL
+
+#endif /* AWS_CHECKSUMS_FILE_CHECKSUM_H */
@@ -0,0 +1,67 @@
+#ifndef AWS_CHECKSUMS_MULTI_CHECKSUM_H
+#define AWS_CHECKSUMS_MULTI_CHECKSUM_H
+/**
+ * Copyright Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0.
+ */
+
+#include <aws/checksums/exports.h>
+#include <aws/common/byte_buf.h>
+
+AWS_PUSH_SANE_WARNING_LEVEL
+
+/*
+ * Computes several checksums over the same data in one pass. Data is fed to every algorithm one cache resident block
+ * at a time, so on buffers larger than L2 memory is read once instead of once per algorithm.
+ */
+
+/* Algorithms a multi checksum can compute. Combine with | when creating one. */
+enum aws_multi_checksum_algorithm {
+    AWS_MULTI_CHECKSUM_CRC32 = 1 << 0,
+    AWS_MULTI_CHECKSUM_CRC32C = 1 << 1,
+    AWS_MULTI_CHECKSUM_CRC64NVME = 1 << 2,
+    AWS_MULTI_CHECKSUM_XXHASH64 = 1 << 3,
+    AWS_MULTI_CHECKSUM_XXHASH3_64 = 1 << 4,
+    AWS_MULTI_CHECKSUM_XXHASH3_128 = 1 << 5,
+};
+
+struct aws_multi_checksum;
+
+AWS_EXTERN_C_BEGIN
+
+/**
+ * Allocates a context computing every algorithm set in the algorithms bitmask (of enum aws_multi_checksum_algorithm).
+ * xxhash_seed seeds the xxhash algorithms and is ignored by the crcs, which start from 0.
+ * Returns NULL and raises AWS_ERROR_INVALID_ARGUMENT if algorithms is empty or contains unknown bits.
+ */
+AWS_CHECKSUMS_API struct aws_multi_checksum *aws_multi_checksum_new(
+    struct aws_allocator *allocator,
+    uint32_t algorithms,
+    uint64_t xxhash_seed);
+
+/**
+ * Feeds data to every algorithm of the context.
+ * Can return error. Context is unusable after error.
+ */
+AWS_CHECKSUMS_API int aws_multi_checksum_update(struct aws_multi_checksum *checksum, struct aws_byte_cursor data);
+
+/**
+ * Appends the digest of one algorithm over all data so far to out, in big-endian (network) order: 4 bytes for the
+ * crc32s, 8 for crc64nvme and the 64 bit xxhashes, 16 for XXHASH3_128.
+ * Raises AWS_ERROR_INVALID_ARGUMENT if the context was not created with algorithm, and AWS_ERROR_INVALID_BUFFER_SIZE
+ * if out can not fit the digest. As with aws_xxhash_finalize(), more data can be fed afterwards.
+ */
+AWS_CHECKSUMS_API int aws_multi_checksum_finalize(
+    struct aws_multi_checksum *checksum,
+    enum aws_multi_checksum_algorithm algorithm,
+    struct aws_byte_buf *out);
+
+/**
+ * Destroys the context.
+ */
+AWS_CHECKSUMS_API void aws_multi_checksum_destroy(struct aws_multi_checksum *checksum);
+
+AWS_EXTERN_C_END
+AWS_POP_SANE_WARNING_LEVEL
+
+#endif /* AWS_CHECKSUMS_MULTI_CHECKSUM_H */
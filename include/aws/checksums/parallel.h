@@ -0,0 +1,103 @@
+#ifndef AWS_CHECKSUMS_PARALLEL_H
+#define AWS_CHECKSUMS_PARALLEL_H
+/**
+ * Copyright Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0.
+ */
+
+#include <aws/checksums/exports.h>
+#include <aws/common/common.h>
+
+AWS_PUSH_SANE_WARNING_LEVEL
+
+/*
+ * Multithreaded checksums of a single large buffer. The buffer is split into chunks that are checksummed
+ * concurrently and merged with the corresponding aws_checksums_*_combine() function, so the result is identical to
+ * the single threaded functions in crc.h. Meant for buffers of hundreds of MB and more, where one core can not keep
+ * up with memory bandwidth.
+ */
+
+/* Chunk size used when aws_checksums_parallel_options.chunk_size is 0. */
+#define AWS_CHECKSUMS_PARALLEL_DEFAULT_CHUNK_SIZE (4 * 1024 * 1024)
+
+/**
+ * Lets callers run the work on their own thread pool instead of threads created for each call.
+ */
+struct aws_checksums_executor {
+    /*
+     * Runs task_fn(arg) exactly once, on any thread, and returns AWS_OP_SUCCESS. If the task can not be scheduled it
+     * returns AWS_OP_ERR without running it, and the calling thread picks up its share of the work.
+     * Running the task synchronously on the calling thread is allowed, and so is queueing it behind the calling
+     * thread (i.e. on a single threaded event loop): the checksum call returns once all the work is done, and tasks
+     * that only run afterwards find nothing left and return right away.
+     */
+    int (*submit)(struct aws_checksums_executor *executor, void (*task_fn)(void *arg), void *arg);
+    void *impl;
+};
+
+struct aws_checksums_parallel_options {
+    /* Upper bound on the threads working on one call, including the calling thread. 0 uses one per cpu. */
+    size_t max_threads;
+
+    /*
+     * Bytes checksummed per task. 0 uses AWS_CHECKSUMS_PARALLEL_DEFAULT_CHUNK_SIZE. Raised for very large inputs so
+     * each thread gets at most a few dozen tasks, which keeps the final combine pass cheap.
+     */
+    size_t chunk_size;
+
+    /* Optional. Runs the work on a caller managed pool instead of launching aws_threads. */
+    struct aws_checksums_executor *executor;
+
+    /*
+     * Spreads threads evenly over the cpu groups (NUMA nodes) and pins them there, with each group working through
+     * its own contiguous part of the buffer before helping the others. Memory placed with first touch by a similarly
+     * partitioned writer is then mostly read from the local node. Ignored when an executor is set, since placement
+     * is up to the executor then.
+     */
+    bool numa_aware;
+};
+
+AWS_EXTERN_C_BEGIN
+
+/**
+ * Computes the CRC32 (Ethernet, gzip) of input using multiple threads. Same result as aws_checksums_crc32_ex().
+ * options can be NULL for defaults. Buffers under two chunks are checksummed on the calling thread, as is any work
+ * that could not be handed to another thread.
+ * Returns AWS_OP_ERR with AWS_ERROR_INVALID_ARGUMENT if out_crc32 is NULL, or input is NULL with a non-zero length.
+ */
+AWS_CHECKSUMS_API int aws_checksums_crc32_parallel(
+    struct aws_allocator *allocator,
+    const uint8_t *input,
+    size_t length,
+    uint32_t previous_crc32,
+    const struct aws_checksums_parallel_options *options,
+    uint32_t *out_crc32);
+
+/**
+ * Computes the Castagnoli CRC32c (iSCSI) of input using multiple threads. Same result as aws_checksums_crc32c_ex().
+ * See aws_checksums_crc32_parallel() for details.
+ */
+AWS_CHECKSUMS_API int aws_checksums_crc32c_parallel(
+    struct aws_allocator *allocator,
+    const uint8_t *input,
+    size_t length,
+    uint32_t previous_crc32c,
+    const struct aws_checksums_parallel_options *options,
+    uint32_t *out_crc32c);
+
+/**
+ * Computes the CRC64-NVME of input using multiple threads. Same result as aws_checksums_crc64nvme_ex().
+ * See aws_checksums_crc32_parallel() for details.
+ */
+AWS_CHECKSUMS_API int aws_checksums_crc64nvme_parallel(
+    struct aws_allocator *allocator,
+    const uint8_t *input,
+    size_t length,
+    uint64_t previous_crc64,
+    const struct aws_checksums_parallel_options *options,
+    uint64_t *out_crc64);
+
+AWS_EXTERN_C_END
+AWS_POP_SANE_WARNING_LEVEL
+
+#endif /* AWS_CHECKSUMS_PARALLEL_H */
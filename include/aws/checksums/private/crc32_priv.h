@@ -14,6 +14,10 @@
 
 AWS_EXTERN_C_BEGIN
 
+/* Slice-by-16 lookup tables of the reference implementations. [0] is the classic one byte at a time table. */
+extern const uint32_t CRC32_TABLE[16][256];
+extern const uint32_t CRC32C_TABLE[16][256];
+
 /* Computes CRC32 (Ethernet, gzip, et. al.) using a (slow) reference implementation. */
 AWS_CHECKSUMS_API uint32_t aws_checksums_crc32_sw(const uint8_t *input, int length, uint32_t previousCrc32);
 
@@ -24,9 +28,23 @@ AWS_CHECKSUMS_API uint32_t aws_checksums_crc32_combine_sw(uint32_t crc1, uint32_
 
 AWS_CHECKSUMS_API uint32_t aws_checksums_crc32c_combine_sw(uint32_t crc1, uint32_t crc2, uint64_t len);
 
+/* Divides crc by x^(8 * len) modulo the polynomial, the inverse of the shift combine() applies to crc1. */
+AWS_CHECKSUMS_API uint32_t aws_checksums_crc32_unshift_sw(uint32_t crc, uint64_t len);
+
+AWS_CHECKSUMS_API uint32_t aws_checksums_crc32c_unshift_sw(uint32_t crc, uint64_t len);
+
+/*
+ * Multi-buffer kernels: advance the crcs of four independent buffers over their first length bytes at once by
+ * interleaving their dependency chains. crcs holds the previous crc of each buffer on input (same convention as the
+ * single buffer kernels) and the updated crc on output.
+ */
+typedef void(aws_checksums_crc32_x4_fn)(const uint8_t *const inputs[4], int length, uint32_t crcs[4]);
+
 #if defined(AWS_USE_CPU_EXTENSIONS) && defined(AWS_ARCH_ARM64)
 uint32_t aws_checksums_crc32_armv8(const uint8_t *input, int length, uint32_t previous_crc32);
 uint32_t aws_checksums_crc32c_armv8(const uint8_t *input, int length, uint32_t previous_crc32c);
+void aws_checksums_crc32_armv8_x4(const uint8_t *const inputs[4], int length, uint32_t crcs[4]);
+void aws_checksums_crc32c_armv8_x4(const uint8_t *const inputs[4], int length, uint32_t crcs[4]);
 #elif defined(AWS_USE_CPU_EXTENSIONS) && defined(AWS_ARCH_INTEL)
 #    if defined(AWS_ARCH_INTEL_X64)
 typedef uint64_t *slice_ptr_type;
@@ -42,11 +60,20 @@ typedef uint32_t *slice_ptr_type;
 typedef uint32_t slice_ptr_int_type;
 #        define crc_intrin_fn _mm_crc32_u32
 #    endif
+/* Uses only the sse4.2 crc32 instruction. Cheapest option for tiny inputs since it has no setup or feature checks. */
+uint32_t aws_checksums_crc32c_intel_sse42(const uint8_t *input, int length, uint32_t previous_crc32c);
+void aws_checksums_crc32c_intel_sse42_x4(const uint8_t *const inputs[4], int length, uint32_t crcs[4]);
 uint32_t aws_checksums_crc32c_intel_avx512_with_sse_fallback(
     const uint8_t *input,
     int length,
     uint32_t previous_crc32c);
 
+#    if defined(AWS_HAVE_CLMUL) && defined(AWS_ARCH_INTEL_X64)
+/* Same as the combine_sw functions, with pclmulqdq multiplies. */
+uint32_t aws_checksums_crc32_combine_clmul(uint32_t crc1, uint32_t crc2, uint64_t len2);
+uint32_t aws_checksums_crc32c_combine_clmul(uint32_t crc1, uint32_t crc2, uint64_t len2);
+#    endif
+
 #endif
 
 typedef struct {
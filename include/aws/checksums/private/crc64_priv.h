@@ -17,16 +17,19 @@ AWS_CHECKSUMS_API uint64_t aws_checksums_crc64nvme_sw(const uint8_t *input, int
 
 AWS_CHECKSUMS_API uint64_t aws_checksums_crc64nvme_combine_sw(uint64_t crc1, uint64_t crc2, uint64_t len2);
 
+/* Divides crc by x^(8 * len) modulo the polynomial, the inverse of the shift combine() applies to crc1. */
+AWS_CHECKSUMS_API uint64_t aws_checksums_crc64nvme_unshift_sw(uint64_t crc, uint64_t len);
+
 #if defined(AWS_USE_CPU_EXTENSIONS) && defined(AWS_ARCH_INTEL_X64) && defined(AWS_HAVE_CLMUL) &&                       \
     !(defined(_MSC_VER) && _MSC_VER < 1920)
 uint64_t aws_checksums_crc64nvme_intel_clmul(const uint8_t *input, int length, uint64_t previous_crc_64);
+
+uint64_t aws_checksums_crc64nvme_combine_clmul(uint64_t crc1, uint64_t crc2, uint64_t len2);
 #endif /* defined(AWS_ARCH_INTEL_X64) && defined(AWS_HAVE_CLMUL) && !(defined(_MSC_VER) && _MSC_VER < 1920) */
 
 #if defined(AWS_USE_CPU_EXTENSIONS) && defined(AWS_ARCH_INTEL_X64) && defined(AWS_HAVE_AVX2_INTRINSICS) &&             \
     !(defined(_MSC_VER) && _MSC_VER < 1920)
 uint64_t aws_checksums_crc64nvme_intel_avx512(const uint8_t *input, int length, uint64_t previous_crc_64);
-
-uint64_t aws_checksums_crc64nvme_combine_clmul(uint64_t crc1, uint64_t crc2, uint64_t len2);
 #endif /* defined(AWS_ARCH_INTEL_X64) && defined(AWS_HAVE_AVX2_INTRINSICS) && !(defined(_MSC_VER) && _MSC_VER < 1920)  \
         */
 
@@ -0,0 +1,96 @@
+#ifndef AWS_CHECKSUMS_PRIVATE_CRC_KERNELS_PRIV_H
+#define AWS_CHECKSUMS_PRIVATE_CRC_KERNELS_PRIV_H
+/**
+ * Copyright Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0.
+ */
+
+#include <aws/checksums/crc_kernels.h>
+#include <aws/checksums/exports.h>
+#include <aws/common/byte_buf.h>
+#include <aws/common/common.h>
+
+/*
+ * One compiled-in implementation of a crc algorithm.
+ * crc32_fn is set for the 32 bit algorithms and crc64_fn for the 64 bit ones.
+ * crc32_x4_fn optionally runs the same kernel over four buffers at once (see aws_checksums_crc32_x4_fn).
+ */
+struct aws_checksums_crc_kernel {
+    const char *name;
+    const char *required_features;
+    bool (*is_supported)(void);
+    uint32_t (*crc32_fn)(const uint8_t *input, int length, uint32_t previous_crc);
+    uint64_t (*crc64_fn)(const uint8_t *input, int length, uint64_t previous_crc);
+    void (*crc32_x4_fn)(const uint8_t *const inputs[4], int length, uint32_t crcs[4]);
+};
+
+AWS_EXTERN_C_BEGIN
+
+/*
+ * Returns the kernels compiled in for the algorithm and writes their number to count.
+ * Kernels are not necessarily supported by the current cpu, check is_supported before using one.
+ */
+AWS_CHECKSUMS_API const struct aws_checksums_crc_kernel *aws_checksums_crc_kernels(
+    enum aws_checksums_crc_algorithm algorithm,
+    size_t *count);
+
+/* Returns the kernel currently used for inputs of the given enum aws_checksums_size_class. */
+AWS_CHECKSUMS_API const struct aws_checksums_crc_kernel *aws_checksums_crc_active_kernel(
+    enum aws_checksums_crc_algorithm algorithm,
+    size_t size_class);
+
+/* Routes inputs of the given enum aws_checksums_size_class to kernel. Kernel must be supported by the cpu. */
+AWS_CHECKSUMS_API void aws_checksums_crc_install_kernel(
+    enum aws_checksums_crc_algorithm algorithm,
+    size_t size_class,
+    const struct aws_checksums_crc_kernel *kernel);
+
+/* Backends of the above. crc32.c owns crc32 and crc32c, crc64.c owns crc64nvme. */
+void aws_checksums_crc32_install_default_kernels(enum aws_checksums_crc_algorithm algorithm);
+void aws_checksums_crc64_install_default_kernels(void);
+const struct aws_checksums_crc_kernel *aws_checksums_crc32_kernels(
+    enum aws_checksums_crc_algorithm algorithm,
+    size_t *count);
+const struct aws_checksums_crc_kernel *aws_checksums_crc32_active_kernel(
+    enum aws_checksums_crc_algorithm algorithm,
+    size_t size_class);
+void aws_checksums_crc32_install_kernel(
+    enum aws_checksums_crc_algorithm algorithm,
+    size_t size_class,
+    const struct aws_checksums_crc_kernel *kernel);
+
+const struct aws_checksums_crc_kernel *aws_checksums_crc64_kernels(size_t *count);
+const struct aws_checksums_crc_kernel *aws_checksums_crc64_active_kernel(size_t size_class);
+void aws_checksums_crc64_install_kernel(size_t size_class, const struct aws_checksums_crc_kernel *kernel);
+
+/*
+ * Applies pins in the AWS_CHECKSUMS_CRC_KERNEL_PIN format, i.e. "crc32c=sse42;crc64nvme=sw".
+ * Pairs naming an unknown algorithm or an unknown or unsupported kernel are skipped.
+ */
+void aws_checksums_crc_pin_kernels_from_string(struct aws_byte_cursor pins);
+
+/*
+ * Microbenchmarks every supported kernel of every algorithm on a representative length of each size class and
+ * installs the fastest. The default kernel is kept unless a challenger is clearly faster, so noise does not flip
+ * choices between runs. Takes a few milliseconds.
+ * Raises AWS_ERROR_UNSUPPORTED_OPERATION in builds using AWS_CHECKSUMS_STATIC_DISPATCH.
+ */
+AWS_CHECKSUMS_API int aws_checksums_crc_calibrate(struct aws_allocator *allocator);
+
+/*
+ * Serializes the active kernel choices, i.e. "crc32=sw,sw,sw,sw;crc32c=sse42,avx512,avx512,avx512;...".
+ * Appends to out, growing it as needed.
+ */
+AWS_CHECKSUMS_API int aws_checksums_crc_calibration_save(struct aws_byte_buf *out);
+
+/*
+ * Installs kernel choices previously produced by aws_checksums_crc_calibration_save.
+ * Fails with AWS_ERROR_INVALID_ARGUMENT, leaving the active kernels untouched, if the input is malformed or names a
+ * kernel that is not compiled in or not supported by this cpu, and AWS_ERROR_UNSUPPORTED_OPERATION in builds using
+ * AWS_CHECKSUMS_STATIC_DISPATCH.
+ */
+AWS_CHECKSUMS_API int aws_checksums_crc_calibration_load(struct aws_byte_cursor serialized);
+
+AWS_EXTERN_C_END
+
+#endif /* AWS_CHECKSUMS_PRIVATE_CRC_KERNELS_PRIV_H */
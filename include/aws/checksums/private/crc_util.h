@@ -5,11 +5,13 @@
  * SPDX-License-Identifier: Apache-2.0.
  */
 
+#include <aws/common/byte_buf.h>
 #include <aws/common/byte_order.h>
 #include <aws/common/cpuid.h>
 #include <aws/common/stdint.h>
 #include <limits.h>
 #include <stdlib.h>
+#include <string.h>
 
 #define large_buffer_apply_impl(Name, T)                                                                               \
     static T aws_large_buffer_apply_##Name(                                                                            \
@@ -24,6 +26,265 @@
         return val;                                                                                                    \
     }
 
+/*
+ * Segments shorter than AWS_CHECKSUMS_IOV_STAGE_LIMIT are copied into a stack buffer and checksummed together, so a
+ * chain of small fragments pays the kernel's dispatch, alignment prologue and final reduction once per
+ * AWS_CHECKSUMS_IOV_STAGING_SIZE bytes instead of once per fragment. Copying is cheap next to that at these sizes.
+ * Larger segments are checksummed in place.
+ */
+#define AWS_CHECKSUMS_IOV_STAGE_LIMIT 256
+#define AWS_CHECKSUMS_IOV_STAGING_SIZE 4096
+
+/*
+ * Copies a staged fragment. Fragments of a few bytes are copied inline, since a libc call per fragment costs as much
+ * as their crc. Longer ones use memcpy, which is faster once there is something to vectorize.
+ */
+static inline void aws_checksums_stage_copy(uint8_t *dst, const uint8_t *src, size_t len) {
+    if (len > 16) {
+        memcpy(dst, src, len);
+        return;
+    }
+    /* two possibly overlapping fixed size copies cover every length in [n, 2n] */
+    if (len >= 8) {
+        memcpy(dst, src, 8);
+        memcpy(dst + len - 8, src + len - 8, 8);
+    } else if (len >= 4) {
+        memcpy(dst, src, 4);
+        memcpy(dst + len - 4, src + len - 4, 4);
+    } else {
+        while (len-- > 0) {
+            *dst++ = *src++;
+        }
+    }
+}
+
+#define iov_apply_impl(Name, T)                                                                                        \
+    static T aws_iov_apply_##Name(                                                                                     \
+        T (*checksum_fn)(const uint8_t *, size_t, T),                                                                  \
+        const struct aws_byte_cursor *segments,                                                                        \
+        size_t count,                                                                                                  \
+        T previous) {                                                                                                  \
+        AWS_PRECONDITION(segments != NULL || count == 0);                                                              \
+        uint8_t staging[AWS_CHECKSUMS_IOV_STAGING_SIZE];                                                               \
+        size_t staged = 0;                                                                                             \
+        T val = previous;                                                                                              \
+        for (size_t i = 0; i < count; ++i) {                                                                           \
+            const struct aws_byte_cursor *segment = &segments[i];                                                      \
+            if (segment->len < AWS_CHECKSUMS_IOV_STAGE_LIMIT) {                                                        \
+                if (staged + segment->len > sizeof(staging)) {                                                         \
+                    val = checksum_fn(staging, staged, val);                                                           \
+                    staged = 0;                                                                                        \
+                }                                                                                                      \
+                aws_checksums_stage_copy(staging + staged, segment->ptr, segment->len);                                \
+                staged += segment->len;                                                                                \
+                continue;                                                                                              \
+            }                                                                                                          \
+            if (staged > 0) {                                                                                          \
+                val = checksum_fn(staging, staged, val);                                                               \
+                staged = 0;                                                                                            \
+            }                                                                                                          \
+            val = checksum_fn(segment->ptr, segment->len, val);                                                        \
+        }                                                                                                              \
+        if (staged > 0) {                                                                                              \
+            val = checksum_fn(staging, staged, val);                                                                   \
+        }                                                                                                              \
+        return val;                                                                                                    \
+    }
+
+/*
+ * Fused copy-and-checksum walks the input in blocks small enough to stay in L1: the checksum pulls a block of src into
+ * the cache and the copy then reads it from there, so src comes from memory once instead of twice.
+ */
+#define AWS_CHECKSUMS_COPY_BLOCK_SIZE (16 * 1024)
+
+static inline void aws_checksums_copy(uint8_t *dst, const uint8_t *src, size_t len) {
+    memcpy(dst, src, len);
+}
+
+/*
+ * Same as aws_checksums_copy(), but with non-temporal stores where the platform has them, so a large destination
+ * that is not read again soon does not evict the working set from the caches. Falls back to memcpy elsewhere.
+ */
+void aws_checksums_copy_nt(uint8_t *dst, const uint8_t *src, size_t len);
+
+#define copy_apply_impl(Name, T)                                                                                       \
+    static T aws_copy_apply_##Name(                                                                                    \
+        T (*checksum_fn)(const uint8_t *, size_t, T),                                                                  \
+        void (*copy_fn)(uint8_t *, const uint8_t *, size_t),                                                           \
+        uint8_t *dst,                                                                                                  \
+        const uint8_t *src,                                                                                            \
+        size_t length,                                                                                                 \
+        T previous) {                                                                                                  \
+        AWS_PRECONDITION((dst != NULL && src != NULL) || length == 0);                                                 \
+        T val = previous;                                                                                              \
+        while (length > 0) {                                                                                           \
+            size_t block = length < AWS_CHECKSUMS_COPY_BLOCK_SIZE ? length : AWS_CHECKSUMS_COPY_BLOCK_SIZE;            \
+            val = checksum_fn(src, block, val);                                                                        \
+            copy_fn(dst, src, block);                                                                                  \
+            dst += block;                                                                                              \
+            src += block;                                                                                              \
+            length -= block;                                                                                           \
+        }                                                                                                              \
+        return val;                                                                                                    \
+    }
+
+/* dst = a ^ b, a word at a time. */
+static inline void aws_checksums_xor_bytes(uint8_t *dst, const uint8_t *a, const uint8_t *b, size_t len) {
+    size_t i = 0;
+    for (; i + 8 <= len; i += 8) {
+        uint64_t wa;
+        uint64_t wb;
+        memcpy(&wa, a + i, 8);
+        memcpy(&wb, b + i, 8);
+        wa ^= wb;
+        memcpy(dst + i, &wa, 8);
+    }
+    for (; i < len; ++i) {
+        dst[i] = a[i] ^ b[i];
+    }
+}
+
+/*
+ * Crcs are linear: for equal length inputs, crc(a) ^ crc(b) is the crc of a ^ b without the initial and final
+ * inversion (the "raw" crc). So overwriting len bytes at offset changes the crc of the whole input by the raw crc of
+ * old_bytes ^ new_bytes, shifted past the total_len - offset - len bytes that follow it. The xor is staged on the
+ * stack, and seeding the kernels with all ones cancels their initial inversion so they produce the raw crc, inverted.
+ */
+#define patch_apply_impl(Name, T)                                                                                      \
+    static T aws_patch_apply_##Name(                                                                                   \
+        T (*checksum_fn)(const uint8_t *, size_t, T),                                                                  \
+        T (*combine_fn)(T, T, uint64_t),                                                                               \
+        T old_crc,                                                                                                     \
+        uint64_t total_len,                                                                                            \
+        uint64_t offset,                                                                                               \
+        const uint8_t *old_bytes,                                                                                      \
+        const uint8_t *new_bytes,                                                                                      \
+        size_t len) {                                                                                                  \
+        AWS_PRECONDITION(offset <= total_len && len <= total_len - offset);                                            \
+        AWS_PRECONDITION((old_bytes != NULL && new_bytes != NULL) || len == 0);                                        \
+        const uint64_t trailing_len = total_len - offset - len;                                                        \
+        uint8_t delta[AWS_CHECKSUMS_IOV_STAGING_SIZE];                                                                 \
+        T val = (T)~(T)0;                                                                                              \
+        while (len > 0) {                                                                                              \
+            size_t block = len < sizeof(delta) ? len : sizeof(delta);                                                  \
+            aws_checksums_xor_bytes(delta, old_bytes, new_bytes, block);                                               \
+            val = checksum_fn(delta, block, val);                                                                      \
+            old_bytes += block;                                                                                        \
+            new_bytes += block;                                                                                        \
+            len -= block;                                                                                              \
+        }                                                                                                              \
+        return old_crc ^ combine_fn((T)~val, 0, trailing_len);                                                         \
+    }
+
+/*
+ * Appending a segment multiplies the crc so far by x^(8 * length) modulo the polynomial, which combine() does with a
+ * multiplication and a reduction per nonzero nibble of the length, and every segment waits for the previous one.
+ * Multipart objects are mostly equal sized parts, so a run of at least AWS_CHECKSUMS_COMBINE_MANY_MIN_RUN equal lengths
+ * instead multiplies by a table of that one factor times every nibble value at every position. The table is built
+ * once per run from the factor and the bit-reflected polynomial, after which a segment costs a few lookups and no
+ * reduction. Stretches of mixed lengths are split into AWS_CHECKSUMS_COMBINE_MANY_LANES contiguous lanes whose
+ * independent combine() chains are interleaved, and the lane results are combined at the end.
+ */
+#define AWS_CHECKSUMS_COMBINE_MANY_MIN_RUN 8
+#define AWS_CHECKSUMS_COMBINE_MANY_LANES 4
+
+#define combine_many_impl(Name, T)                                                                                     \
+    static T aws_combine_many_chain_##Name(                                                                            \
+        T (*combine_fn)(T, T, uint64_t), T crc, const struct aws_crc_segment *segs, size_t n) {                        \
+        const size_t per_lane = n / AWS_CHECKSUMS_COMBINE_MANY_LANES;                                                  \
+        size_t i = 0;                                                                                                  \
+        if (per_lane > 1) {                                                                                            \
+            T crcs[AWS_CHECKSUMS_COMBINE_MANY_LANES] = {crc};                                                          \
+            uint64_t lengths[AWS_CHECKSUMS_COMBINE_MANY_LANES] = {0};                                                  \
+            for (; i < per_lane; ++i) {                                                                                \
+                for (size_t lane = 0; lane < AWS_CHECKSUMS_COMBINE_MANY_LANES; ++lane) {                               \
+                    const struct aws_crc_segment *seg = &segs[lane * per_lane + i];                                    \
+                    crcs[lane] = combine_fn(crcs[lane], (T)seg->crc, seg->length);                                     \
+                    lengths[lane] += seg->length;                                                                      \
+                }                                                                                                      \
+            }                                                                                                          \
+            crc = crcs[0];                                                                                             \
+            for (size_t lane = 1; lane < AWS_CHECKSUMS_COMBINE_MANY_LANES; ++lane) {                                   \
+                crc = combine_fn(crc, crcs[lane], lengths[lane]);                                                      \
+            }                                                                                                          \
+            i = AWS_CHECKSUMS_COMBINE_MANY_LANES * per_lane;                                                           \
+        }                                                                                                              \
+        for (; i < n; ++i) {                                                                                           \
+            crc = combine_fn(crc, (T)segs[i].crc, segs[i].length);                                                     \
+        }                                                                                                              \
+        return crc;                                                                                                    \
+    }                                                                                                                  \
+                                                                                                                       \
+    static inline T aws_combine_many_shift_##Name(T table[2 * sizeof(T)][16], T crc) {                                 \
+        T shifted = 0;                                                                                                 \
+        for (size_t nibble = 0; nibble < 2 * sizeof(T); ++nibble) {                                                    \
+            shifted ^= table[nibble][(crc >> (4 * nibble)) & 0xf];                                                     \
+        }                                                                                                              \
+        return shifted;                                                                                                \
+    }                                                                                                                  \
+                                                                                                                       \
+    static T aws_combine_many_run_##Name(                                                                              \
+        T (*combine_fn)(T, T, uint64_t), T poly, T crc, const struct aws_crc_segment *segs, size_t n) {                \
+        T table[2 * sizeof(T)][16];                                                                                    \
+        /* bit j of a reflected crc is the coefficient of x^(bits - 1 - j): the top bit times the factor is the */     \
+        /* factor itself, and each lower bit is one more multiplication by x */                                        \
+        T product = combine_fn((T)1 << (8 * sizeof(T) - 1), 0, segs[0].length);                                        \
+        for (size_t nibble = 2 * sizeof(T); nibble-- > 0;) {                                                           \
+            T bits[4];                                                                                                 \
+            for (size_t bit = 4; bit-- > 0;) {                                                                         \
+                bits[bit] = product;                                                                                   \
+                product = (product >> 1) ^ (((T)0 - (product & 1)) & poly);                                            \
+            }                                                                                                          \
+            table[nibble][0] = 0;                                                                                      \
+            for (size_t bit = 0; bit < 4; ++bit) {                                                                     \
+                for (size_t v = 0; v < ((size_t)1 << bit); ++v) {                                                      \
+                    table[nibble][((size_t)1 << bit) | v] = bits[bit] ^ table[nibble][v];                              \
+                }                                                                                                      \
+            }                                                                                                          \
+        }                                                                                                              \
+        /* contiguous lanes of the run, whose chains of lookups are independent and overlap */                         \
+        const size_t per_lane = n / AWS_CHECKSUMS_COMBINE_MANY_LANES;                                                  \
+        size_t i = 0;                                                                                                  \
+        if (per_lane > 1) {                                                                                            \
+            T crcs[AWS_CHECKSUMS_COMBINE_MANY_LANES] = {crc};                                                          \
+            for (; i < per_lane; ++i) {                                                                                \
+                for (size_t lane = 0; lane < AWS_CHECKSUMS_COMBINE_MANY_LANES; ++lane) {                               \
+                    crcs[lane] = aws_combine_many_shift_##Name(table, crcs[lane]) ^ (T)segs[lane * per_lane + i].crc;  \
+                }                                                                                                      \
+            }                                                                                                          \
+            crc = crcs[0];                                                                                             \
+            for (size_t lane = 1; lane < AWS_CHECKSUMS_COMBINE_MANY_LANES; ++lane) {                                   \
+                crc = combine_fn(crc, crcs[lane], per_lane * segs[0].length);                                          \
+            }                                                                                                          \
+            i = AWS_CHECKSUMS_COMBINE_MANY_LANES * per_lane;                                                           \
+        }                                                                                                              \
+        for (; i < n; ++i) {                                                                                           \
+            crc = aws_combine_many_shift_##Name(table, crc) ^ (T)segs[i].crc;                                          \
+        }                                                                                                              \
+        return crc;                                                                                                    \
+    }                                                                                                                  \
+                                                                                                                       \
+    static T aws_combine_many_##Name(                                                                                  \
+        T (*combine_fn)(T, T, uint64_t), T poly, const struct aws_crc_segment *segs, size_t n) {                       \
+        AWS_PRECONDITION(segs != NULL || n == 0);                                                                      \
+        T crc = 0;                                                                                                     \
+        size_t mixed_begin = 0;                                                                                        \
+        size_t i = 0;                                                                                                  \
+        while (i < n) {                                                                                                \
+            size_t run = 1;                                                                                            \
+            while (i + run < n && segs[i + run].length == segs[i].length) {                                            \
+                ++run;                                                                                                 \
+            }                                                                                                          \
+            if (run >= AWS_CHECKSUMS_COMBINE_MANY_MIN_RUN) {                                                           \
+                crc = aws_combine_many_chain_##Name(combine_fn, crc, segs + mixed_begin, i - mixed_begin);             \
+                crc = aws_combine_many_run_##Name(combine_fn, poly, crc, segs + i, run);                               \
+                mixed_begin = i + run;                                                                                 \
+            }                                                                                                          \
+            i += run;                                                                                                  \
+        }                                                                                                              \
+        return aws_combine_many_chain_##Name(combine_fn, crc, segs + mixed_begin, n - mixed_begin);                    \
+    }
+
 /* helper function to reverse byte order on big-endian platforms*/
 static inline uint32_t aws_bswap32_if_be(uint32_t x) {
     if (!aws_is_big_endian()) {
@@ -77,52 +338,120 @@ void aws_checksums_crc32_init(void);
  */
 void aws_checksums_crc64_init(void);
 
+/*
+ * Inputs are bucketed into size classes so each length can use the kernel that is fastest for it. Wide kernels
+ * (i.e. zmm folding) have setup and reduction costs that only pay off once there is enough data to amortize them,
+ * while the scalar instruction loops win on tiny inputs.
+ */
+enum aws_checksums_size_class {
+    AWS_CHECKSUMS_SIZE_CLASS_TINY,   /* < 64 bytes */
+    AWS_CHECKSUMS_SIZE_CLASS_SMALL,  /* < 1 KiB */
+    AWS_CHECKSUMS_SIZE_CLASS_MEDIUM, /* < 64 KiB */
+    AWS_CHECKSUMS_SIZE_CLASS_LARGE,  /* everything else */
+    AWS_CHECKSUMS_SIZE_CLASS_COUNT,
+};
+
+/* Branch free mapping of length to its enum aws_checksums_size_class. */
+static inline size_t aws_checksums_size_class(int length) {
+    return (size_t)(length >= 64) + (size_t)(length >= 1024) + (size_t)(length >= 64 * 1024);
+}
+
+struct aws_checksums_crc_kernel;
+
+/*
+ * Everything the public entry points consult per call, in one place: cpu features for kernels that pick a code
+ * path internally, and the kernel for every algorithm and enum aws_checksums_size_class.
+ * The hot part (features and fns) fits in two cache lines; kernels only serve introspection.
+ * Written only while resolving defaults and by explicit kernel installs (pinning, calibration), never on the hot
+ * path.
+ */
+struct aws_checksums_dispatch_table {
+    bool detection_performed;
+    bool has_sse42;
+    bool has_avx512;
+    bool has_clmul;
+    bool has_vpclmulqdq;
+
+    /* indexed by AWS_CHECKSUMS_CRC_ALGORITHM_CRC32 / AWS_CHECKSUMS_CRC_ALGORITHM_CRC32C */
+    uint32_t (*crc32_combine_fns[2])(uint32_t crc1, uint32_t crc2, uint64_t len2);
+    uint32_t (*crc32_fns[2][AWS_CHECKSUMS_SIZE_CLASS_COUNT])(const uint8_t *input, int length, uint32_t prev_crc);
+
+    uint64_t (*crc64nvme_combine_fn)(uint64_t crc1, uint64_t crc2, uint64_t len2);
+    uint64_t (*crc64nvme_fns[AWS_CHECKSUMS_SIZE_CLASS_COUNT])(const uint8_t *input, int length, uint64_t prev_crc);
+
+    const struct aws_checksums_crc_kernel *crc32_kernels[2][AWS_CHECKSUMS_SIZE_CLASS_COUNT];
+    const struct aws_checksums_crc_kernel *crc64nvme_kernels[AWS_CHECKSUMS_SIZE_CLASS_COUNT];
+};
+
+AWS_ALIGNED_TYPEDEF(struct aws_checksums_dispatch_table, aws_checksums_dispatch_table_t, 64);
+
 /**
  * Note: this is slightly different from our typical pattern.
- * This check is currently performed in a tight loop, so jumping through
- * some hoops with inlining to avoid perf regressions, which forces
- * below functions to be declared in a header.
+ * This table is read in a tight loop, so jumping through some hoops with inlining to avoid perf regressions, which
+ * forces it and the functions below to be declared in a header.
  */
-extern bool s_detection_performed;
-extern bool s_detected_sse42;
-extern bool s_detected_avx512;
-extern bool s_detected_clmul;
-extern bool s_detected_vpclmulqdq;
+extern aws_checksums_dispatch_table_t aws_checksums_dispatch;
+
+/*
+ * With AWS_CHECKSUMS_EAGER_INIT the table is fully resolved by a library constructor before main() runs, so the
+ * lazy initialization checks below (and in the crc entry points) compile away.
+ */
+#if defined(AWS_CHECKSUMS_EAGER_INIT)
+#    define AWS_CHECKSUMS_NEEDS_LAZY_INIT(slot) false
+#else
+#    define AWS_CHECKSUMS_NEEDS_LAZY_INIT(slot) AWS_UNLIKELY(!(slot))
+#endif
 
 static inline void aws_checksums_init_detection_cache(void) {
-    s_detected_clmul = aws_cpu_has_feature(AWS_CPU_FEATURE_CLMUL);
-    s_detected_sse42 = aws_cpu_has_feature(AWS_CPU_FEATURE_SSE_4_2);
-    s_detected_avx512 = aws_cpu_has_feature(AWS_CPU_FEATURE_AVX512);
-    s_detected_vpclmulqdq = aws_cpu_has_feature(AWS_CPU_FEATURE_VPCLMULQDQ);
-    s_detection_performed = true;
+    aws_checksums_dispatch.has_clmul = aws_cpu_has_feature(AWS_CPU_FEATURE_CLMUL);
+    aws_checksums_dispatch.has_sse42 = aws_cpu_has_feature(AWS_CPU_FEATURE_SSE_4_2);
+    aws_checksums_dispatch.has_avx512 = aws_cpu_has_feature(AWS_CPU_FEATURE_AVX512);
+    aws_checksums_dispatch.has_vpclmulqdq = aws_cpu_has_feature(AWS_CPU_FEATURE_VPCLMULQDQ);
+    aws_checksums_dispatch.detection_performed = true;
 }
 
 static inline bool aws_cpu_has_clmul_cached(void) {
-    if (AWS_UNLIKELY(!s_detection_performed)) {
+#if defined(AWS_CHECKSUMS_STATIC_HAS_CLMUL)
+    return true;
+#else
+    if (AWS_CHECKSUMS_NEEDS_LAZY_INIT(aws_checksums_dispatch.detection_performed)) {
         aws_checksums_init_detection_cache();
     }
-    return s_detected_clmul;
+    return aws_checksums_dispatch.has_clmul;
+#endif
 }
 
 static inline bool aws_cpu_has_sse42_cached(void) {
-    if (AWS_UNLIKELY(!s_detection_performed)) {
+#if defined(AWS_CHECKSUMS_STATIC_HAS_SSE42)
+    return true;
+#else
+    if (AWS_CHECKSUMS_NEEDS_LAZY_INIT(aws_checksums_dispatch.detection_performed)) {
         aws_checksums_init_detection_cache();
     }
-    return s_detected_sse42;
+    return aws_checksums_dispatch.has_sse42;
+#endif
 }
 
 static inline bool aws_cpu_has_avx512_cached(void) {
-    if (AWS_UNLIKELY(!s_detection_performed)) {
+#if defined(AWS_CHECKSUMS_STATIC_HAS_AVX512)
+    return true;
+#else
+    if (AWS_CHECKSUMS_NEEDS_LAZY_INIT(aws_checksums_dispatch.detection_performed)) {
         aws_checksums_init_detection_cache();
     }
-    return s_detected_avx512;
+    return aws_checksums_dispatch.has_avx512;
+#endif
 }
 
 static inline bool aws_cpu_has_vpclmulqdq_cached(void) {
-    if (AWS_UNLIKELY(!s_detection_performed)) {
+#if defined(AWS_CHECKSUMS_STATIC_HAS_VPCLMULQDQ)
+    return true;
+#else
+    if (AWS_CHECKSUMS_NEEDS_LAZY_INIT(aws_checksums_dispatch.detection_performed)) {
         aws_checksums_init_detection_cache();
     }
-    return s_detected_vpclmulqdq;
+    return aws_checksums_dispatch.has_vpclmulqdq;
+#endif
 }
 
 #if defined(__SIZEOF_INT128__)
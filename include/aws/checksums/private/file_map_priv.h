@@ -0,0 +1,41 @@
+#ifndef AWS_CHECKSUMS_PRIVATE_FILE_MAP_PRIV_H
+#define AWS_CHECKSUMS_PRIVATE_FILE_MAP_PRIV_H
+/**
+ * Copyright Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0.
+ */
+
+#include <aws/checksums/exports.h>
+#include <aws/common/common.h>
+
+#include <stdio.h>
+
+/*
+ * Platform layer of the file checksums, implemented in source/posix and source/windows.
+ */
+
+struct aws_checksums_file_mapping {
+    /* first byte of the requested range */
+    const uint8_t *data;
+
+    /* whole mapping, which starts at the page (allocation granularity) boundary at or below the requested offset */
+    void *base;
+    size_t base_length;
+};
+
+AWS_EXTERN_C_BEGIN
+
+/*
+ * Maps length bytes of file starting at offset read only, hinting sequential access. length must be non-zero and the
+ * range must be within the file.
+ */
+int aws_checksums_file_map(FILE *file, uint64_t offset, size_t length, struct aws_checksums_file_mapping *out_mapping);
+
+void aws_checksums_file_unmap(struct aws_checksums_file_mapping *mapping);
+
+/* Asks the OS to start reading the pages of a mapped range in the background. Best effort, no errors. */
+void aws_checksums_file_prefetch(const uint8_t *data, size_t length);
+
+AWS_EXTERN_C_END
+
+#endif /* AWS_CHECKSUMS_PRIVATE_FILE_MAP_PRIV_H */
@@ -0,0 +1,30 @@
+#ifndef AWS_CHECKSUMS_PRIVATE_PARALLEL_PRIV_H
+#define AWS_CHECKSUMS_PRIVATE_PARALLEL_PRIV_H
+/**
+ * Copyright Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0.
+ */
+
+#include <aws/checksums/parallel.h>
+
+AWS_EXTERN_C_BEGIN
+
+/*
+ * Fork-join helper: calls task_fn(task_index, user_data) once for every index in [0, task_count), spread over up to
+ * options->max_threads threads (the calling thread included), and returns once all of them finished.
+ * Tasks are handed out in index order, so consecutive indices should cover consecutive memory.
+ * Never fails: work that could not be handed to another thread runs on the calling thread.
+ */
+void aws_checksums_parallel_for(
+    struct aws_allocator *allocator,
+    const struct aws_checksums_parallel_options *options,
+    size_t task_count,
+    void (*task_fn)(size_t task_index, void *user_data),
+    void *user_data);
+
+/* Number of threads aws_checksums_parallel_for() would use at most, including the calling thread. */
+size_t aws_checksums_parallel_max_threads(const struct aws_checksums_parallel_options *options);
+
+AWS_EXTERN_C_END
+
+#endif /* AWS_CHECKSUMS_PRIVATE_PARALLEL_PRIV_H */
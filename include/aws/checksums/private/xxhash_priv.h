@@ -7,12 +7,50 @@
  */
 
 #include <aws/checksums/exports.h>
+#include <aws/checksums/xxhash.h>
 #include <aws/common/macros.h>
 
 AWS_EXTERN_C_BEGIN
 
 void aws_checksums_xxhash_init(struct aws_allocator *allocator);
 
+/*
+ * Streaming xxhash on caller provided state storage, which must be 64 byte aligned and at least
+ * AWS_CHECKSUM_STATE_SIZE bytes. Same dispatch and output format as the aws_xxhash_* functions.
+ */
+int aws_xxhash_state_reset(void *state, enum aws_xxhash_type type, uint64_t seed);
+int aws_xxhash_state_update(void *state, enum aws_xxhash_type type, struct aws_byte_cursor data);
+int aws_xxhash_state_finalize(void *state, enum aws_xxhash_type type, struct aws_byte_buf *out);
+
+#if defined(AWS_CHECKSUMS_HAVE_SVE)
+/*
+ * XXH3 kernels built with SVE in source/arm/xxhash_sve.c. Declared with plain types because that file includes its
+ * own copy of the xxhash implementation. state is an XXH3_state_t, update returns nonzero on error.
+ * Exported so tests can check them on cpus whose SVE vectors are too narrow for dispatch to pick them.
+ */
+AWS_CHECKSUMS_API size_t aws_checksums_xxhash_sve_vector_bytes(void);
+AWS_CHECKSUMS_API uint64_t aws_checksums_xxh3_64_seed_sve(const void *input, size_t len, uint64_t seed);
+AWS_CHECKSUMS_API void aws_checksums_xxh3_128_seed_sve(
+    const void *input,
+    size_t len,
+    uint64_t seed,
+    uint64_t *low64,
+    uint64_t *high64);
+AWS_CHECKSUMS_API uint64_t aws_checksums_xxh3_64_secret_sve(
+    const void *input,
+    size_t len,
+    const void *secret,
+    size_t secret_len);
+AWS_CHECKSUMS_API void aws_checksums_xxh3_128_secret_sve(
+    const void *input,
+    size_t len,
+    const void *secret,
+    size_t secret_len,
+    uint64_t *low64,
+    uint64_t *high64);
+AWS_CHECKSUMS_API int aws_checksums_xxh3_update_sve(void *state, const void *input, size_t len);
+#endif
+
 AWS_EXTERN_C_END
 
 #endif /* AWS_CHECKSUMS_PRIVATE_XXHASH_PRIV_H */
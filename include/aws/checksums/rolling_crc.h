@@ -0,0 +1,63 @@
+#ifndef AWS_CHECKSUMS_ROLLING_CRC_H
+#define AWS_CHECKSUMS_ROLLING_CRC_H
+/**
+ * Copyright Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0.
+ */
+
+#include <aws/checksums/exports.h>
+#include <aws/common/common.h>
+
+AWS_PUSH_SANE_WARNING_LEVEL
+
+/*
+ * CRC32C over a sliding window of window_size bytes, e.g. for content-defined chunking. Moving the window by one byte
+ * costs O(1) regardless of its size: the outgoing byte's contribution is looked up in a table precomputed for the
+ * window size. Values are the same as aws_checksums_crc32c_ex(window, window_size, 0).
+ * Initialize with aws_rolling_crc32c_init(). The window starts out as window_size zero bytes.
+ */
+struct aws_rolling_crc32c {
+    size_t window_size;
+    /* crc of the window without the initial and final inversion, see rolling_crc.c */
+    uint32_t crc;
+    uint32_t zero_window_crc;
+    uint32_t out_table[256];
+};
+
+AWS_EXTERN_C_BEGIN
+
+/**
+ * Sets up rolling for windows of window_size bytes. Raises AWS_ERROR_INVALID_ARGUMENT if window_size is 0.
+ */
+AWS_CHECKSUMS_API int aws_rolling_crc32c_init(struct aws_rolling_crc32c *rolling, size_t window_size);
+
+/**
+ * Replaces the window with the window_size bytes at window. Returns their CRC32C.
+ */
+AWS_CHECKSUMS_API uint32_t aws_rolling_crc32c_reset(struct aws_rolling_crc32c *rolling, const uint8_t *window);
+
+/**
+ * Slides the window by one byte: in is appended and out, the byte window_size positions before in, drops out.
+ * Returns the CRC32C of the new window.
+ */
+AWS_CHECKSUMS_API uint32_t aws_rolling_crc32c_roll(struct aws_rolling_crc32c *rolling, uint8_t in, uint8_t out);
+
+/**
+ * Finds the first window_size bytes window of data whose CRC32C has all bits of mask clear, i.e. the next chunk
+ * boundary. Windows ending at offsets window_size through len are checked, in order. Independent stretches of data
+ * are rolled at the same time, which is several times faster than calling aws_rolling_crc32c_roll() per byte.
+ *
+ * Returns true and sets *out_end to the offset just past the matching window, and rolling to that window, when one
+ * matches. Otherwise returns false and leaves rolling on the last window of data, if len is at least window_size.
+ */
+AWS_CHECKSUMS_API bool aws_rolling_crc32c_scan(
+    struct aws_rolling_crc32c *rolling,
+    const uint8_t *data,
+    size_t len,
+    uint32_t mask,
+    size_t *out_end);
+
+AWS_EXTERN_C_END
+AWS_POP_SANE_WARNING_LEVEL
+
+#endif /* AWS_CHECKSUMS_ROLLING_CRC_H */
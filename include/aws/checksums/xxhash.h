@@ -5,14 +5,27 @@
  * SPDX-License-Identifier: Apache-2.0.
  */
 
+#include <aws/checksums/checksum.h>
 #include <aws/checksums/exports.h>
+#include <aws/checksums/parallel.h>
 #include <aws/common/byte_buf.h>
 
 AWS_PUSH_SANE_WARNING_LEVEL
 
-struct aws_xxhash_impl;
+enum aws_xxhash_type { XXHASH64 = 0, XXHASH3_64 = 1, XXHASH3_128 = 2, XXHASH3_TREE = 3 };
 
-enum aws_xxhash_type { XXHASH64 = 0, XXHASH3_64 = 1, XXHASH3_128 = 2 };
+/* Treat as private. Holds the state of any xxhash type but XXHASH3_TREE inline. */
+struct aws_xxhash_impl {
+    aws_checksum_state_storage_t state;
+};
+
+/* Treat as private. XXHASH3_TREE needs a second state, kept out of struct aws_xxhash_impl so other types don't pay. */
+struct aws_xxhash_tree_impl {
+    /* hashes the current leaf */
+    struct aws_xxhash_impl leaf;
+    /* hashes the digests of the leaves before it */
+    aws_checksum_state_storage_t root;
+};
 
 struct aws_xxhash {
     struct aws_allocator *allocator;
@@ -20,6 +33,51 @@ struct aws_xxhash {
     struct aws_xxhash_impl *impl;
 };
 
+/*
+ * Caller provided storage for aws_xxhash_init_inplace(), e.g. on the stack or inside a per-request struct.
+ */
+struct aws_xxhash_inplace {
+    struct aws_xxhash hash;
+    struct aws_xxhash_impl impl;
+};
+
+/*
+ * Caller provided storage for aws_xxhash3_tree_init_inplace().
+ */
+struct aws_xxhash_tree_inplace {
+    struct aws_xxhash hash;
+    struct aws_xxhash_tree_impl impl;
+};
+
+/* Size of the secret XXH3 derives from a seed. */
+#define AWS_XXHASH3_SECRET_SIZE 192
+
+/* Smallest custom secret XXH3 accepts. */
+#define AWS_XXHASH3_SECRET_SIZE_MIN 136
+
+/*
+ * XXHASH3_TREE is a 128 bit digest that, unlike plain XXH3, can be computed on many cores at once. It is defined as:
+ * - the input is split into leaves of AWS_XXHASH3_TREE_LEAF_SIZE bytes, the last one possibly shorter. The empty
+ *   input has no leaves.
+ * - every leaf is hashed with XXH3_128 and the seed, and its digest written big-endian (high64 then low64).
+ * - the digest is XXH3_128 with the seed over the concatenated leaf digests followed by the total input length as
+ *   a big-endian 64 bit integer, written out like the XXH3_128 digest.
+ * The leaf size is part of the definition and never changes, so digests are reproducible regardless of how many
+ * threads computed them or how the input was fed to aws_xxhash_update().
+ */
+#define AWS_XXHASH3_TREE_LEAF_SIZE (1024 * 1024)
+
+/*
+ * XXH3 with a fixed seed, for callers hashing many inputs with the same one. XXH3 derives a secret from the seed for
+ * every input longer than 240 bytes, and on every streaming reset. This holds that secret so it is derived once.
+ * Hashes are identical to the seeded functions above. Initialize with aws_xxhash3_seeded_hasher_init(). It is
+ * read-only afterwards and can be shared between threads.
+ */
+struct aws_xxhash3_seeded_hasher {
+    uint64_t seed;
+    uint8_t secret[AWS_XXHASH3_SECRET_SIZE];
+};
+
 AWS_EXTERN_C_BEGIN
 
 /**
@@ -44,6 +102,37 @@ AWS_CHECKSUMS_API struct aws_xxhash *aws_xxhash3_64_new(struct aws_allocator *al
  */
 AWS_CHECKSUMS_API struct aws_xxhash *aws_xxhash3_128_new(struct aws_allocator *allocator, uint64_t seed);
 
+/**
+ * Allocates and initializes a XXHASH3_TREE hash instance. Streaming hashes on one thread, see
+ * aws_xxhash3_tree_compute() to use more.
+ */
+AWS_CHECKSUMS_API struct aws_xxhash *aws_xxhash3_tree_new(struct aws_allocator *allocator, uint64_t seed);
+
+/**
+ * Initializes a hash of the given type inside storage, without allocating. Returns &storage->hash, or NULL and
+ * raises AWS_ERROR_INVALID_ARGUMENT for an unknown type or XXHASH3_TREE, which needs the larger storage of
+ * aws_xxhash3_tree_init_inplace().
+ * The hash must not outlive storage, and storage must not be moved or copied while in use.
+ * Nothing needs to be freed afterwards, aws_xxhash_destroy() on it is a no-op.
+ */
+AWS_CHECKSUMS_API struct aws_xxhash *aws_xxhash_init_inplace(
+    struct aws_xxhash_inplace *storage,
+    enum aws_xxhash_type type,
+    uint64_t seed);
+
+/**
+ * Same as aws_xxhash_init_inplace() for a XXHASH3_TREE hash.
+ */
+AWS_CHECKSUMS_API struct aws_xxhash *aws_xxhash3_tree_init_inplace(
+    struct aws_xxhash_tree_inplace *storage,
+    uint64_t seed);
+
+/**
+ * Discards the data hashed so far and starts over with seed, keeping the hash type.
+ * Lets one hash, allocated or in-place, be reused across many inputs.
+ */
+AWS_CHECKSUMS_API int aws_xxhash_reset(struct aws_xxhash *hash, uint64_t seed);
+
 /**
  * Update hash state from the data.
  * Can return error. Hash is unusable after error;
@@ -58,7 +147,7 @@ AWS_CHECKSUMS_API int aws_xxhash_update(struct aws_xxhash *hash, struct aws_byte
 AWS_CHECKSUMS_API int aws_xxhash_finalize(struct aws_xxhash *hash, struct aws_byte_buf *out);
 
 /**
- * Destroy allocated hash.
+ * Destroy allocated hash. No-op for NULL and for hashes from aws_xxhash_init_inplace().
  */
 AWS_CHECKSUMS_API void aws_xxhash_destroy(struct aws_xxhash *hash);
 
@@ -81,6 +170,106 @@ AWS_CHECKSUMS_API int aws_xxhash3_64_compute(uint64_t seed, struct aws_byte_curs
  */
 AWS_CHECKSUMS_API int aws_xxhash3_128_compute(uint64_t seed, struct aws_byte_cursor data, struct aws_byte_buf *out);
 
+/**
+ * Compute XXHASH3_TREE hash, hashing the leaves on multiple threads. options can be NULL for defaults, see
+ * aws_checksums_crc32_parallel(). Inputs under two chunks are hashed on the calling thread.
+ */
+AWS_CHECKSUMS_API int aws_xxhash3_tree_compute(
+    struct aws_allocator *allocator,
+    uint64_t seed,
+    struct aws_byte_cursor data,
+    const struct aws_checksums_parallel_options *options,
+    struct aws_byte_buf *out);
+
+/**
+ * Batch.
+ * Hashes n keys with the same seed and writes the raw hash values, in host byte order, to out[0..n-1]. Same values as
+ * the one-shot functions, meant for hashing many short keys e.g. for partitioning or bloom filters.
+ */
+
+/**
+ * Compute XXH64 hashes of keys.
+ */
+AWS_CHECKSUMS_API void aws_xxhash64_batch(const struct aws_byte_cursor *keys, uint64_t seed, uint64_t *out, size_t n);
+
+/**
+ * Compute XXH3_64 hashes of keys.
+ */
+AWS_CHECKSUMS_API void aws_xxhash3_64_batch(
+    const struct aws_byte_cursor *keys,
+    uint64_t seed,
+    uint64_t *out,
+    size_t n);
+
+/**
+ * Seeded XXH3 with a cached secret.
+ */
+
+/**
+ * Derives the secret for seed into hasher.
+ */
+AWS_CHECKSUMS_API void aws_xxhash3_seeded_hasher_init(struct aws_xxhash3_seeded_hasher *hasher, uint64_t seed);
+
+/**
+ * Compute XXH3_64 hash with the seed of hasher. Same result as aws_xxhash3_64_compute() with that seed.
+ */
+AWS_CHECKSUMS_API int aws_xxhash3_64_compute_seeded(
+    const struct aws_xxhash3_seeded_hasher *hasher,
+    struct aws_byte_cursor data,
+    struct aws_byte_buf *out);
+
+/**
+ * Compute XXH3_128 hash with the seed of hasher. Same result as aws_xxhash3_128_compute() with that seed.
+ */
+AWS_CHECKSUMS_API int aws_xxhash3_128_compute_seeded(
+    const struct aws_xxhash3_seeded_hasher *hasher,
+    struct aws_byte_cursor data,
+    struct aws_byte_buf *out);
+
+/**
+ * Like aws_xxhash_reset() with the seed of hasher, without deriving the secret again. hash must be XXH3_64 or
+ * XXH3_128, otherwise AWS_ERROR_INVALID_ARGUMENT is raised. hash refers to hasher's secret until the next reset, so
+ * hasher must stay alive and unchanged until then.
+ */
+AWS_CHECKSUMS_API int aws_xxhash_reset_seeded(struct aws_xxhash *hash, const struct aws_xxhash3_seeded_hasher *hasher);
+
+/**
+ * Keyed XXH3 with a custom secret, e.g. from aws_xxhash3_generate_secret(). The secret is used as is, no per-call
+ * derivation. Hashes differ from the seeded variants. A secret shorter than AWS_XXHASH3_SECRET_SIZE_MIN raises
+ * AWS_ERROR_INVALID_ARGUMENT.
+ */
+
+/**
+ * Appends a secret_size bytes XXH3 secret derived from key_material, which can be of any length and quality, to out.
+ * secret_size must be at least AWS_XXHASH3_SECRET_SIZE_MIN, AWS_XXHASH3_SECRET_SIZE is the usual choice.
+ */
+AWS_CHECKSUMS_API int aws_xxhash3_generate_secret(
+    struct aws_byte_cursor key_material,
+    size_t secret_size,
+    struct aws_byte_buf *out);
+
+/**
+ * Compute XXH3_64 hash with secret.
+ */
+AWS_CHECKSUMS_API int aws_xxhash3_64_compute_with_secret(
+    struct aws_byte_cursor secret,
+    struct aws_byte_cursor data,
+    struct aws_byte_buf *out);
+
+/**
+ * Compute XXH3_128 hash with secret.
+ */
+AWS_CHECKSUMS_API int aws_xxhash3_128_compute_with_secret(
+    struct aws_byte_cursor secret,
+    struct aws_byte_cursor data,
+    struct aws_byte_buf *out);
+
+/**
+ * Restarts hash, which must be XXH3_64 or XXH3_128, on secret. The bytes of secret are referenced, not copied, and
+ * must stay alive and unchanged until the next reset.
+ */
+AWS_CHECKSUMS_API int aws_xxhash_reset_with_secret(struct aws_xxhash *hash, struct aws_byte_cursor secret);
+
 AWS_EXTERN_C_END
 AWS_POP_SANE_WARNING_LEVEL
 
@@ -6,6 +6,7 @@
 /* No instrics defined for 32-bit MSVC */
 #if (defined(_M_ARM64) || defined(__aarch64__) || defined(__arm__))
 #    include <aws/checksums/private/crc32_priv.h>
+#    include <string.h>
 #    ifdef _M_ARM64
 #        include <arm64_neon.h>
 #        define PREFETCH(p) __prefetch(p)
@@ -94,4 +95,76 @@ uint32_t aws_checksums_crc32_armv8(const uint8_t *data, int length, uint32_t pre
     return ~crc;
 }
 
+void aws_checksums_crc32c_armv8_x4(const uint8_t *const inputs[4], int length, uint32_t crcs[4]) {
+    /* independent chains hide the latency of the crc instruction, see the x86 version of this kernel */
+    uint32_t crc0 = ~crcs[0];
+    uint32_t crc1 = ~crcs[1];
+    uint32_t crc2 = ~crcs[2];
+    uint32_t crc3 = ~crcs[3];
+
+    int offset = 0;
+    for (; offset + 8 <= length; offset += 8) {
+        uint64_t word0;
+        uint64_t word1;
+        uint64_t word2;
+        uint64_t word3;
+        memcpy(&word0, inputs[0] + offset, sizeof(word0));
+        memcpy(&word1, inputs[1] + offset, sizeof(word1));
+        memcpy(&word2, inputs[2] + offset, sizeof(word2));
+        memcpy(&word3, inputs[3] + offset, sizeof(word3));
+        crc0 = __crc32cd(crc0, word0);
+        crc1 = __crc32cd(crc1, word1);
+        crc2 = __crc32cd(crc2, word2);
+        crc3 = __crc32cd(crc3, word3);
+    }
+
+    for (; offset < length; ++offset) {
+        crc0 = __crc32cb(crc0, inputs[0][offset]);
+        crc1 = __crc32cb(crc1, inputs[1][offset]);
+        crc2 = __crc32cb(crc2, inputs[2][offset]);
+        crc3 = __crc32cb(crc3, inputs[3][offset]);
+    }
+
+    crcs[0] = ~crc0;
+    crcs[1] = ~crc1;
+    crcs[2] = ~crc2;
+    crcs[3] = ~crc3;
+}
+
+void aws_checksums_crc32_armv8_x4(const uint8_t *const inputs[4], int length, uint32_t crcs[4]) {
+    /* independent chains hide the latency of the crc instruction, see the x86 version of this kernel */
+    uint32_t crc0 = ~crcs[0];
+    uint32_t crc1 = ~crcs[1];
+    uint32_t crc2 = ~crcs[2];
+    uint32_t crc3 = ~crcs[3];
+
+    int offset = 0;
+    for (; offset + 8 <= length; offset += 8) {
+        uint64_t word0;
+        uint64_t word1;
+        uint64_t word2;
+        uint64_t word3;
+        memcpy(&word0, inputs[0] + offset, sizeof(word0));
+        memcpy(&word1, inputs[1] + offset, sizeof(word1));
+        memcpy(&word2, inputs[2] + offset, sizeof(word2));
+        memcpy(&word3, inputs[3] + offset, sizeof(word3));
+        crc0 = __crc32d(crc0, word0);
+        crc1 = __crc32d(crc1, word1);
+        crc2 = __crc32d(crc2, word2);
+        crc3 = __crc32d(crc3, word3);
+    }
+
+    for (; offset < length; ++offset) {
+        crc0 = __crc32b(crc0, inputs[0][offset]);
+        crc1 = __crc32b(crc1, inputs[1][offset]);
+        crc2 = __crc32b(crc2, inputs[2][offset]);
+        crc3 = __crc32b(crc3, inputs[3][offset]);
+    }
+
+    crcs[0] = ~crc0;
+    crcs[1] = ~crc1;
+    crcs[2] = ~crc2;
+    crcs[3] = ~crc3;
+}
+
 #endif
@@ -0,0 +1,55 @@
+/**
+ * Copyright Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0.
+ */
+
+#include <aws/checksums/private/xxhash_priv.h>
+
+#if defined(__ARM_FEATURE_SVE)
+
+/*
+ * The vendored impl checks __ARM_NEON before __ARM_FEATURE_SVE when it picks XXH_VECTOR, and every AArch64 target has
+ * NEON, so SVE has to be asked for explicitly.
+ */
+#    define XXH_VECTOR XXH_SVE
+#    define XXH_INLINE_ALL
+#    include "../external/xxhash.h"
+
+size_t aws_checksums_xxhash_sve_vector_bytes(void) {
+    return (size_t)svcntb();
+}
+
+uint64_t aws_checksums_xxh3_64_seed_sve(const void *input, size_t len, uint64_t seed) {
+    return XXH3_hashLong_64b_withSeed_internal(
+        input, len, seed, XXH3_accumulate, XXH3_scrambleAcc, XXH3_initCustomSecret);
+}
+
+void aws_checksums_xxh3_128_seed_sve(const void *input, size_t len, uint64_t seed, uint64_t *low64, uint64_t *high64) {
+    XXH128_hash_t hash = XXH3_hashLong_128b_withSeed_internal(
+        input, len, seed, XXH3_accumulate, XXH3_scrambleAcc, XXH3_initCustomSecret);
+    *low64 = hash.low64;
+    *high64 = hash.high64;
+}
+
+uint64_t aws_checksums_xxh3_64_secret_sve(const void *input, size_t len, const void *secret, size_t secret_len) {
+    return XXH3_hashLong_64b_internal(input, len, secret, secret_len, XXH3_accumulate, XXH3_scrambleAcc);
+}
+
+void aws_checksums_xxh3_128_secret_sve(
+    const void *input,
+    size_t len,
+    const void *secret,
+    size_t secret_len,
+    uint64_t *low64,
+    uint64_t *high64) {
+    XXH128_hash_t hash = XXH3_hashLong_128b_internal(
+        input, len, (const xxh_u8 *)secret, secret_len, XXH3_accumulate, XXH3_scrambleAcc);
+    *low64 = hash.low64;
+    *high64 = hash.high64;
+}
+
+int aws_checksums_xxh3_update_sve(void *state, const void *input, size_t len) {
+    return XXH3_update((XXH3_state_t *)state, (const xxh_u8 *)input, len, XXH3_accumulate, XXH3_scrambleAcc) != XXH_OK;
+}
+
+#endif /* defined(__ARM_FEATURE_SVE) */
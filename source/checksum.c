@@ -0,0 +1,140 @@
+/**
+ * Copyright Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0.
+ */
+
+#include <aws/checksums/checksum.h>
+#include <aws/checksums/crc.h>
+#include <aws/checksums/private/xxhash_priv.h>
+
+static const size_t s_digest_sizes[AWS_CHECKSUM_ALGORITHM_COUNT] = {
+    [AWS_CHECKSUM_CRC32] = 4,
+    [AWS_CHECKSUM_CRC32C] = 4,
+    [AWS_CHECKSUM_CRC64NVME] = 8,
+    [AWS_CHECKSUM_XXHASH64] = 8,
+    [AWS_CHECKSUM_XXHASH3_64] = 8,
+    [AWS_CHECKSUM_XXHASH3_128] = 16,
+};
+
+static enum aws_xxhash_type s_xxhash_type(enum aws_checksum_algorithm algorithm) {
+    switch (algorithm) {
+        case AWS_CHECKSUM_XXHASH3_64:
+            return XXHASH3_64;
+        case AWS_CHECKSUM_XXHASH3_128:
+            return XXHASH3_128;
+        default:
+            return XXHASH64;
+    }
+}
+
+size_t aws_checksum_digest_size(enum aws_checksum_algorithm algorithm) {
+    if ((size_t)algorithm >= AWS_CHECKSUM_ALGORITHM_COUNT) {
+        return 0;
+    }
+    return s_digest_sizes[algorithm];
+}
+
+int aws_checksum_init(struct aws_checksum *checksum, enum aws_checksum_algorithm algorithm, uint64_t seed) {
+    AWS_ERROR_PRECONDITION(checksum);
+
+    if ((size_t)algorithm >= AWS_CHECKSUM_ALGORITHM_COUNT) {
+        return aws_raise_error(AWS_ERROR_INVALID_ARGUMENT);
+    }
+
+    checksum->algorithm = algorithm;
+    checksum->seed = seed;
+    return aws_checksum_reset(checksum);
+}
+
+int aws_checksum_reset(struct aws_checksum *checksum) {
+    AWS_ERROR_PRECONDITION(checksum);
+
+    switch (checksum->algorithm) {
+        case AWS_CHECKSUM_CRC32:
+        case AWS_CHECKSUM_CRC32C:
+            checksum->state.crc32 = (uint32_t)checksum->seed;
+            return AWS_OP_SUCCESS;
+        case AWS_CHECKSUM_CRC64NVME:
+            checksum->state.crc64 = checksum->seed;
+            return AWS_OP_SUCCESS;
+        case AWS_CHECKSUM_XXHASH64:
+        case AWS_CHECKSUM_XXHASH3_64:
+        case AWS_CHECKSUM_XXHASH3_128:
+            return aws_xxhash_state_reset(&checksum->state.xxhash, s_xxhash_type(checksum->algorithm), checksum->seed);
+        default:
+            return aws_raise_error(AWS_ERROR_INVALID_STATE);
+    }
+}
+
+int aws_checksum_update(struct aws_checksum *checksum, struct aws_byte_cursor data) {
+    AWS_ERROR_PRECONDITION(checksum);
+
+    switch (checksum->algorithm) {
+        case AWS_CHECKSUM_CRC32:
+            checksum->state.crc32 = aws_checksums_crc32_ex(data.ptr, data.len, checksum->state.crc32);
+            return AWS_OP_SUCCESS;
+        case AWS_CHECKSUM_CRC32C:
+            checksum->state.crc32 = aws_checksums_crc32c_ex(data.ptr, data.len, checksum->state.crc32);
+            return AWS_OP_SUCCESS;
+        case AWS_CHECKSUM_CRC64NVME:
+            checksum->state.crc64 = aws_checksums_crc64nvme_ex(data.ptr, data.len, checksum->state.crc64);
+            return AWS_OP_SUCCESS;
+        case AWS_CHECKSUM_XXHASH64:
+        case AWS_CHECKSUM_XXHASH3_64:
+        case AWS_CHECKSUM_XXHASH3_128:
+            return aws_xxhash_state_update(&checksum->state.xxhash, s_xxhash_type(checksum->algorithm), data);
+        default:
+            return aws_raise_error(AWS_ERROR_INVALID_STATE);
+    }
+}
+
+int aws_checksum_finalize(struct aws_checksum *checksum, struct aws_byte_buf *out) {
+    AWS_ERROR_PRECONDITION(checksum);
+    AWS_ERROR_PRECONDITION(out);
+
+    switch (checksum->algorithm) {
+        case AWS_CHECKSUM_CRC32:
+        case AWS_CHECKSUM_CRC32C:
+            if (!aws_byte_buf_write_be32(out, checksum->state.crc32)) {
+                return aws_raise_error(AWS_ERROR_INVALID_BUFFER_SIZE);
+            }
+            return AWS_OP_SUCCESS;
+        case AWS_CHECKSUM_CRC64NVME:
+            if (!aws_byte_buf_write_be64(out, checksum->state.crc64)) {
+                return aws_raise_error(AWS_ERROR_INVALID_BUFFER_SIZE);
+            }
+            return AWS_OP_SUCCESS;
+        case AWS_CHECKSUM_XXHASH64:
+        case AWS_CHECKSUM_XXHASH3_64:
+        case AWS_CHECKSUM_XXHASH3_128:
+            return aws_xxhash_state_finalize(&checksum->state.xxhash, s_xxhash_type(checksum->algorithm), out);
+        default:
+            return aws_raise_error(AWS_ERROR_INVALID_STATE);
+    }
+}
+
+int aws_checksum_compute(
+    enum aws_checksum_algorithm algorithm,
+    uint64_t seed,
+    struct aws_byte_cursor data,
+    struct aws_byte_buf *out) {
+    AWS_ERROR_PRECONDITION(out);
+
+    /* the one-shot xxhash functions skip the streaming state entirely */
+    switch (algorithm) {
+        case AWS_CHECKSUM_XXHASH64:
+            return aws_xxhash64_compute(seed, data, out);
+        case AWS_CHECKSUM_XXHASH3_64:
+            return aws_xxhash3_64_compute(seed, data, out);
+        case AWS_CHECKSUM_XXHASH3_128:
+            return aws_xxhash3_128_compute(seed, data, out);
+        default:
+            break;
+    }
+
+    struct aws_checksum checksum;
+    if (aws_checksum_init(&checksum, algorithm, seed) || aws_checksum_update(&checksum, data)) {
+        return AWS_OP_ERR;
+    }
+    return aws_checksum_finalize(&checksum, out);
+}
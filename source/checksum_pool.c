@@ -0,0 +1,272 @@
+/**
+ * Copyright Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0.
+ */
+
+#include <aws/checksums/checksum_pool.h>
+
+#include <aws/common/mutex.h>
+#include <aws/common/thread.h>
+
+/* Contexts allocated at once when the shared list runs dry. */
+#define POOL_SLAB_ENTRIES 64
+
+/* A thread keeps at most this many free contexts per pool, past that half of them go back to the shared list. */
+#define THREAD_CACHE_MAX_ENTRIES 64
+
+/* Pools a thread can cache contexts for at the same time. Others fall back to the shared list. */
+#define THREAD_CACHE_SLOTS 4
+
+#define POOL_ENTRY_ALIGNMENT 64
+
+struct pool_entry {
+    struct aws_checksum checksum;
+    struct pool_entry *next;
+};
+
+/* Header of each slab, the 64 byte aligned entries follow it. */
+struct pool_slab {
+    struct pool_slab *next;
+};
+
+struct aws_checksum_pool {
+    struct aws_allocator *allocator;
+    enum aws_checksum_algorithm algorithm;
+    uint64_t seed;
+
+    /* never reused, so thread cache slots of a destroyed pool can't be mistaken for a new one */
+    uint64_t id;
+    struct aws_checksum_pool *next_live;
+
+    struct aws_mutex lock;
+    struct pool_entry *shared_free;
+    struct pool_slab *slabs;
+};
+
+struct thread_cache_slot {
+    uint64_t pool_id; /* 0 when unused */
+    struct pool_entry *free_list;
+    size_t count;
+};
+
+static AWS_THREAD_LOCAL struct thread_cache_slot s_thread_cache[THREAD_CACHE_SLOTS];
+
+/*
+ * Live pools, so a thread can tell which of its slots belong to destroyed pools and can be reused.
+ * Only touched when pools come and go and when a thread first caches contexts for a pool.
+ */
+static struct aws_mutex s_live_pools_lock = AWS_MUTEX_INIT;
+static struct aws_checksum_pool *s_live_pools = NULL;
+static uint64_t s_next_pool_id = 1;
+
+static bool s_is_live_pool_id(uint64_t pool_id) {
+    for (struct aws_checksum_pool *pool = s_live_pools; pool != NULL; pool = pool->next_live) {
+        if (pool->id == pool_id) {
+            return true;
+        }
+    }
+    return false;
+}
+
+/* Returns this thread's slot for pool, claiming one if needed, or NULL if all of them are taken by live pools. */
+static struct thread_cache_slot *s_thread_slot(struct aws_checksum_pool *pool) {
+    struct thread_cache_slot *unused = NULL;
+    for (size_t i = 0; i < THREAD_CACHE_SLOTS; ++i) {
+        if (s_thread_cache[i].pool_id == pool->id) {
+            return &s_thread_cache[i];
+        }
+        if (unused == NULL && s_thread_cache[i].pool_id == 0) {
+            unused = &s_thread_cache[i];
+        }
+    }
+
+    if (unused == NULL) {
+        aws_mutex_lock(&s_live_pools_lock);
+        for (size_t i = 0; i < THREAD_CACHE_SLOTS && unused == NULL; ++i) {
+            if (!s_is_live_pool_id(s_thread_cache[i].pool_id)) {
+                unused = &s_thread_cache[i];
+            }
+        }
+        aws_mutex_unlock(&s_live_pools_lock);
+        if (unused == NULL) {
+            return NULL;
+        }
+    }
+
+    /* entries left in a stale slot belonged to slabs that are already freed */
+    unused->pool_id = pool->id;
+    unused->free_list = NULL;
+    unused->count = 0;
+    return unused;
+}
+
+/* Adds a slab of initialized contexts to the shared list. Called with pool->lock held. */
+static void s_grow_locked(struct aws_checksum_pool *pool) {
+    uint8_t *block = aws_mem_acquire(
+        pool->allocator,
+        sizeof(struct pool_slab) + POOL_ENTRY_ALIGNMENT - 1 + POOL_SLAB_ENTRIES * sizeof(struct pool_entry));
+
+    struct pool_slab *slab = (struct pool_slab *)block;
+    slab->next = pool->slabs;
+    pool->slabs = slab;
+
+    uintptr_t entries_address = (uintptr_t)(block + sizeof(struct pool_slab));
+    entries_address = (entries_address + POOL_ENTRY_ALIGNMENT - 1) & ~(uintptr_t)(POOL_ENTRY_ALIGNMENT - 1);
+    struct pool_entry *entries = (struct pool_entry *)entries_address;
+
+    for (size_t i = 0; i < POOL_SLAB_ENTRIES; ++i) {
+        /* the algorithm was validated in aws_checksum_pool_new(), so this can't fail */
+        aws_checksum_init(&entries[i].checksum, pool->algorithm, pool->seed);
+        entries[i].next = pool->shared_free;
+        pool->shared_free = &entries[i];
+    }
+}
+
+/* Moves up to half a thread cache worth of contexts from the shared list to slot. */
+static void s_refill(struct aws_checksum_pool *pool, struct thread_cache_slot *slot) {
+    aws_mutex_lock(&pool->lock);
+    if (pool->shared_free == NULL) {
+        s_grow_locked(pool);
+    }
+    while (pool->shared_free != NULL && slot->count < THREAD_CACHE_MAX_ENTRIES / 2) {
+        struct pool_entry *entry = pool->shared_free;
+        pool->shared_free = entry->next;
+        entry->next = slot->free_list;
+        slot->free_list = entry;
+        ++slot->count;
+    }
+    aws_mutex_unlock(&pool->lock);
+}
+
+/* Moves half of slot's contexts back to the shared list, where threads that mostly acquire can pick them up. */
+static void s_drain(struct aws_checksum_pool *pool, struct thread_cache_slot *slot) {
+    struct pool_entry *first = slot->free_list;
+    struct pool_entry *last = first;
+    for (size_t i = 1; i < slot->count / 2; ++i) {
+        last = last->next;
+    }
+    slot->free_list = last->next;
+    slot->count -= slot->count / 2;
+
+    aws_mutex_lock(&pool->lock);
+    last->next = pool->shared_free;
+    pool->shared_free = first;
+    aws_mutex_unlock(&pool->lock);
+}
+
+struct aws_checksum_pool *aws_checksum_pool_new(
+    struct aws_allocator *allocator,
+    enum aws_checksum_algorithm algorithm,
+    uint64_t seed) {
+
+    if ((size_t)algorithm >= AWS_CHECKSUM_ALGORITHM_COUNT) {
+        aws_raise_error(AWS_ERROR_INVALID_ARGUMENT);
+        return NULL;
+    }
+
+    struct aws_checksum_pool *pool = aws_mem_calloc(allocator, 1, sizeof(struct aws_checksum_pool));
+    pool->allocator = allocator;
+    pool->algorithm = algorithm;
+    pool->seed = seed;
+    aws_mutex_init(&pool->lock);
+
+    aws_mutex_lock(&s_live_pools_lock);
+    pool->id = s_next_pool_id++;
+    pool->next_live = s_live_pools;
+    s_live_pools = pool;
+    aws_mutex_unlock(&s_live_pools_lock);
+
+    return pool;
+}
+
+void aws_checksum_pool_destroy(struct aws_checksum_pool *pool) {
+    if (pool == NULL) {
+        return;
+    }
+
+    aws_mutex_lock(&s_live_pools_lock);
+    struct aws_checksum_pool **link = &s_live_pools;
+    while (*link != pool) {
+        link = &(*link)->next_live;
+    }
+    *link = pool->next_live;
+    aws_mutex_unlock(&s_live_pools_lock);
+
+    /* other threads find out their slots are stale the next time they need one */
+    for (size_t i = 0; i < THREAD_CACHE_SLOTS; ++i) {
+        if (s_thread_cache[i].pool_id == pool->id) {
+            AWS_ZERO_STRUCT(s_thread_cache[i]);
+        }
+    }
+
+    while (pool->slabs != NULL) {
+        struct pool_slab *slab = pool->slabs;
+        pool->slabs = slab->next;
+        aws_mem_release(pool->allocator, slab);
+    }
+    aws_mutex_clean_up(&pool->lock);
+    aws_mem_release(pool->allocator, pool);
+}
+
+struct aws_checksum *aws_checksum_pool_acquire(struct aws_checksum_pool *pool) {
+    AWS_PRECONDITION(pool);
+
+    struct pool_entry *entry = NULL;
+    struct thread_cache_slot *slot = s_thread_slot(pool);
+    if (slot != NULL) {
+        if (slot->free_list == NULL) {
+            s_refill(pool, slot);
+        }
+        entry = slot->free_list;
+        slot->free_list = entry->next;
+        --slot->count;
+    } else {
+        aws_mutex_lock(&pool->lock);
+        if (pool->shared_free == NULL) {
+            s_grow_locked(pool);
+        }
+        entry = pool->shared_free;
+        pool->shared_free = entry->next;
+        aws_mutex_unlock(&pool->lock);
+    }
+
+    return &entry->checksum;
+}
+
+void aws_checksum_pool_release(struct aws_checksum_pool *pool, struct aws_checksum *checksum) {
+    AWS_PRECONDITION(pool);
+
+    if (checksum == NULL) {
+        return;
+    }
+
+    /* reset here, while the state is still hot, so the next acquire hands out a ready context */
+    aws_checksum_reset(checksum);
+    struct pool_entry *entry = AWS_CONTAINER_OF(checksum, struct pool_entry, checksum);
+
+    struct thread_cache_slot *slot = s_thread_slot(pool);
+    if (slot != NULL) {
+        entry->next = slot->free_list;
+        slot->free_list = entry;
+        if (++slot->count > THREAD_CACHE_MAX_ENTRIES) {
+            s_drain(pool, slot);
+        }
+    } else {
+        aws_mutex_lock(&pool->lock);
+        entry->next = pool->shared_free;
+        pool->shared_free = entry;
+        aws_mutex_unlock(&pool->lock);
+    }
+}
+
+int aws_checksum_pool_finalize(
+    struct aws_checksum_pool *pool,
+    struct aws_checksum *checksum,
+    struct aws_byte_buf *out) {
+    AWS_ERROR_PRECONDITION(pool);
+    AWS_ERROR_PRECONDITION(checksum);
+
+    int result = aws_checksum_finalize(checksum, out);
+    aws_checksum_pool_release(pool, checksum);
+    return result;
+}
@@ -4,30 +4,154 @@
  */
 
 #include <aws/checksums/checksums.h>
+#include <aws/checksums/private/crc_kernels_priv.h>
 #include <aws/checksums/private/crc_util.h>
 #include <aws/checksums/private/xxhash_priv.h>
 
-bool s_detection_performed = false;
-bool s_detected_sse42 = false;
-bool s_detected_avx512 = false;
-bool s_detected_clmul = false;
-bool s_detected_vpclmulqdq = false;
+#include <aws/common/environment.h>
+#include <aws/common/file.h>
+#include <aws/common/string.h>
+
+aws_checksums_dispatch_table_t aws_checksums_dispatch;
+
+/* Resolves cpu features and default kernels. Idempotent, so it's safe to run both eagerly and from library init. */
+static void s_resolve_dispatch(void) {
+    aws_checksums_init_detection_cache();
+    aws_checksums_crc32_init();
+    aws_checksums_crc64_init();
+}
+
+#if defined(AWS_CHECKSUMS_EAGER_INIT)
+/*
+ * Resolve the dispatch table before main() runs, so checksum calls never initialize it concurrently and don't need
+ * to check whether it is initialized. The table lives in this file, so any use of the library links the constructor
+ * in, even from a static lib.
+ */
+#    if defined(_MSC_VER)
+static void __cdecl s_eager_init(void) {
+    s_resolve_dispatch();
+}
+#        pragma section(".CRT$XCU", read)
+__declspec(allocate(".CRT$XCU")) void(__cdecl *aws_checksums_eager_init_entry)(void) = s_eager_init;
+#    else
+__attribute__((constructor)) static void s_eager_init(void) {
+    s_resolve_dispatch();
+}
+#    endif
+#endif
 
 static bool s_checksums_library_initialized = false;
 
-void aws_checksums_library_init(struct aws_allocator *allocator) {
+#if !defined(AWS_CHECKSUMS_STATIC_DISPATCH)
+AWS_STATIC_STRING_FROM_LITERAL(s_calibration_env_var, "AWS_CHECKSUMS_CALIBRATION");
+AWS_STATIC_STRING_FROM_LITERAL(s_kernel_pin_env_var, "AWS_CHECKSUMS_CRC_KERNEL_PIN");
+
+static int s_load_calibration_file(struct aws_allocator *allocator, const char *path) {
+    struct aws_byte_buf contents;
+    if (aws_byte_buf_init_from_file(&contents, allocator, path)) {
+        return AWS_OP_ERR;
+    }
+
+    struct aws_byte_cursor serialized = aws_byte_cursor_from_buf(&contents);
+    serialized = aws_byte_cursor_trim_pred(&serialized, aws_char_is_space);
+    int result = aws_checksums_crc_calibration_load(serialized);
+
+    aws_byte_buf_clean_up(&contents);
+    return result;
+}
+
+static void s_save_calibration_file(struct aws_allocator *allocator, const char *path) {
+    struct aws_byte_buf serialized;
+    aws_byte_buf_init(&serialized, allocator, 128);
+
+    if (aws_checksums_crc_calibration_save(&serialized) == AWS_OP_SUCCESS) {
+        /* best effort. calibration already took effect for this process even if it can't be persisted */
+        FILE *file = aws_fopen(path, "w");
+        if (file != NULL) {
+            fwrite(serialized.buffer, 1, serialized.len, file);
+            fputc('\n', file);
+            fclose(file);
+        }
+    }
+
+    aws_byte_buf_clean_up(&serialized);
+}
+#endif
+
+static void s_apply_calibration(struct aws_allocator *allocator, const struct aws_checksums_library_options *options) {
+#if defined(AWS_CHECKSUMS_STATIC_DISPATCH)
+    /* kernels are fixed at compile time, neither the environment nor the calibration file can change them */
+    (void)allocator;
+    (void)options;
+#else
+    bool calibrate = options != NULL && options->calibrate;
+    const char *file_path = options != NULL ? options->calibration_file_path : NULL;
+
+    struct aws_string *env_value = NULL;
+    if (aws_get_environment_value(allocator, s_calibration_env_var, &env_value) == AWS_OP_SUCCESS &&
+        env_value != NULL) {
+        if (aws_string_eq_c_str(env_value, "calibrate")) {
+            calibrate = true;
+        } else if (
+            env_value->len > 0 &&
+            aws_checksums_crc_calibration_load(aws_byte_cursor_from_string(env_value)) == AWS_OP_SUCCESS) {
+            aws_string_destroy(env_value);
+            return;
+        }
+        aws_string_destroy(env_value);
+    }
+
+    if (!calibrate) {
+        return;
+    }
+
+    if (file_path != NULL && s_load_calibration_file(allocator, file_path) == AWS_OP_SUCCESS) {
+        return;
+    }
+
+    aws_checksums_crc_calibrate(allocator);
+
+    if (file_path != NULL) {
+        s_save_calibration_file(allocator, file_path);
+    }
+#endif
+}
+
+static void s_apply_kernel_pins(struct aws_allocator *allocator) {
+#if defined(AWS_CHECKSUMS_STATIC_DISPATCH)
+    /* kernels are fixed at compile time */
+    (void)allocator;
+#else
+    struct aws_string *env_value = NULL;
+    if (aws_get_environment_value(allocator, s_kernel_pin_env_var, &env_value) == AWS_OP_SUCCESS &&
+        env_value != NULL) {
+        aws_checksums_crc_pin_kernels_from_string(aws_byte_cursor_from_string(env_value));
+        aws_string_destroy(env_value);
+    }
+#endif
+}
+
+void aws_checksums_library_init_with_options(
+    struct aws_allocator *allocator,
+    const struct aws_checksums_library_options *options) {
     if (!s_checksums_library_initialized) {
         s_checksums_library_initialized = true;
 
         aws_common_library_init(allocator);
 
-        aws_checksums_init_detection_cache();
-        aws_checksums_crc32_init();
-        aws_checksums_crc64_init();
+        s_resolve_dispatch();
         aws_checksums_xxhash_init(allocator);
+
+        s_apply_calibration(allocator, options);
+        /* pins are applied last so they override calibrated choices */
+        s_apply_kernel_pins(allocator);
     }
 }
 
+void aws_checksums_library_init(struct aws_allocator *allocator) {
+    aws_checksums_library_init_with_options(allocator, NULL);
+}
+
 void aws_checksums_library_clean_up(void) {
     if (s_checksums_library_initialized) {
         s_checksums_library_initialized = false;
@@ -4,11 +4,17 @@
  */
 #include <aws/checksums/crc.h>
 #include <aws/checksums/private/crc32_priv.h>
+#include <aws/checksums/private/crc_kernels_priv.h>
 #include <aws/checksums/private/crc_util.h>
 
 #include <aws/common/cpuid.h>
+#include <aws/common/math.h>
 
 large_buffer_apply_impl(crc32, uint32_t)
+iov_apply_impl(crc32, uint32_t)
+copy_apply_impl(crc32, uint32_t)
+patch_apply_impl(crc32, uint32_t)
+combine_many_impl(crc32, uint32_t)
 
     AWS_ALIGNED_TYPEDEF(aws_checksums_crc32_constants_t, checksums_constants, 16);
 
@@ -562,58 +568,290 @@ checksums_constants aws_checksums_crc32c_constants = {
                        {0x00000000e964b13d, 0x0000001000000000},
                        {0x000000007b2231f3, 0x0000000400000000}}}};
 
-static uint32_t (*s_crc32c_fn_ptr)(const uint8_t *input, int length, uint32_t previous_crc32c) = NULL;
-static uint32_t (*s_crc32_fn_ptr)(const uint8_t *input, int length, uint32_t previous_crc32) = NULL;
+/*
+ * AWS_CHECKSUMS_STATIC_DISPATCH: when the build targets a known cpu (e.g. -march=sapphirerapids or
+ * -mcpu=neoverse-v2), the kernel runtime detection would select is already known. Resolve it from the target
+ * features the build passes as AWS_CHECKSUMS_STATIC_HAS_* so the public entry points call it directly instead of
+ * going through a function pointer. CMake derives those from the global compiler flags; ISA macros such as
+ * __AVX512F__ can't be used since some sources get extra per-file SIMD flags.
+ */
+#if defined(AWS_CHECKSUMS_STATIC_DISPATCH)
+#    if defined(AWS_USE_CPU_EXTENSIONS) && defined(AWS_ARCH_INTEL_X64) && defined(AWS_CHECKSUMS_STATIC_HAS_SSE42)
+#        define AWS_CHECKSUMS_CRC32_STATIC_FN aws_checksums_crc32_sw
+#        if defined(AWS_HAVE_AVX512_INTRINSICS) && defined(AWS_CHECKSUMS_STATIC_HAS_AVX512) &&                       \
+            defined(AWS_CHECKSUMS_STATIC_HAS_VPCLMULQDQ)
+#            define AWS_CHECKSUMS_CRC32C_STATIC_FN aws_checksums_crc32c_intel_avx512_with_sse_fallback
+#        elif !defined(_MSC_VER) && defined(AWS_CHECKSUMS_STATIC_HAS_CLMUL)
+#            define AWS_CHECKSUMS_CRC32C_STATIC_FN aws_checksums_crc32c_clmul_sse42
+#        else
+#            define AWS_CHECKSUMS_CRC32C_STATIC_FN aws_checksums_crc32c_intel_sse42
+#        endif
+#    elif defined(AWS_USE_CPU_EXTENSIONS) && defined(AWS_ARCH_ARM64) && defined(AWS_CHECKSUMS_STATIC_HAS_ARM_CRC)
+#        define AWS_CHECKSUMS_CRC32_STATIC_FN aws_checksums_crc32_armv8
+#        define AWS_CHECKSUMS_CRC32C_STATIC_FN aws_checksums_crc32c_armv8
+#    else
+#        define AWS_CHECKSUMS_CRC32_STATIC_FN aws_checksums_crc32_sw
+#        define AWS_CHECKSUMS_CRC32C_STATIC_FN aws_checksums_crc32c_sw
+#    endif
+#endif
 
-static uint32_t (*s_crc32_combine_fn_ptr)(uint32_t crc1, uint32_t crc2, uint64_t len) = NULL;
-static uint32_t (*s_crc32c_combine_fn_ptr)(uint32_t crc1, uint32_t crc2, uint64_t len) = NULL;
+typedef uint32_t(crc32_kernel_fn)(const uint8_t *input, int length, uint32_t previous_crc32);
 
-void aws_checksums_crc32_init(void) {
-    if (s_crc32_fn_ptr == NULL) {
+static bool s_always_supported(void) {
+    return true;
+}
+
+#if defined(AWS_USE_CPU_EXTENSIONS) && defined(AWS_ARCH_INTEL_X64)
+static bool s_has_sse42(void) {
+    return aws_cpu_has_feature(AWS_CPU_FEATURE_SSE_4_2);
+}
+
+#    if !defined(_MSC_VER)
+static bool s_has_sse42_clmul(void) {
+    return aws_cpu_has_feature(AWS_CPU_FEATURE_SSE_4_2) && aws_cpu_has_feature(AWS_CPU_FEATURE_CLMUL);
+}
+#    endif
+
+#    if defined(AWS_HAVE_AVX512_INTRINSICS)
+static bool s_has_avx512_vpclmulqdq(void) {
+    return aws_cpu_has_feature(AWS_CPU_FEATURE_SSE_4_2) && aws_cpu_has_feature(AWS_CPU_FEATURE_CLMUL) &&
+           aws_cpu_has_feature(AWS_CPU_FEATURE_AVX512) && aws_cpu_has_feature(AWS_CPU_FEATURE_VPCLMULQDQ);
+}
+#    endif
+#elif defined(AWS_USE_CPU_EXTENSIONS) && defined(AWS_ARCH_ARM64)
+static bool s_has_arm_crc(void) {
+    return aws_cpu_has_feature(AWS_CPU_FEATURE_ARM_CRC);
+}
+#endif
+
+static const struct aws_checksums_crc_kernel s_crc32_kernels[] = {
+    {.name = "sw", .required_features = "", .is_supported = s_always_supported, .crc32_fn = aws_checksums_crc32_sw},
 #if defined(AWS_USE_CPU_EXTENSIONS) && defined(AWS_ARCH_ARM64)
-        if (aws_cpu_has_feature(AWS_CPU_FEATURE_ARM_CRC)) {
-            s_crc32_fn_ptr = aws_checksums_crc32_armv8;
-        } else {
-            s_crc32_fn_ptr = aws_checksums_crc32_sw;
-        }
-#else
-        s_crc32_fn_ptr = aws_checksums_crc32_sw;
+    {.name = "armv8",
+     .required_features = "crc",
+     .is_supported = s_has_arm_crc,
+     .crc32_fn = aws_checksums_crc32_armv8,
+     .crc32_x4_fn = aws_checksums_crc32_armv8_x4},
 #endif
-    }
+};
 
-    if (s_crc32c_fn_ptr == NULL) {
+static const struct aws_checksums_crc_kernel s_crc32c_kernels[] = {
+    {.name = "sw", .required_features = "", .is_supported = s_always_supported, .crc32_fn = aws_checksums_crc32c_sw},
 #if defined(AWS_USE_CPU_EXTENSIONS) && defined(AWS_ARCH_INTEL_X64)
-        if (aws_cpu_has_feature(AWS_CPU_FEATURE_SSE_4_2)) {
-            s_crc32c_fn_ptr = aws_checksums_crc32c_intel_avx512_with_sse_fallback;
-        } else {
-            s_crc32c_fn_ptr = aws_checksums_crc32c_sw;
+    {.name = "sse42",
+     .required_features = "sse4.2",
+     .is_supported = s_has_sse42,
+     .crc32_fn = aws_checksums_crc32c_intel_sse42,
+     .crc32_x4_fn = aws_checksums_crc32c_intel_sse42_x4},
+#    if !defined(_MSC_VER)
+    {.name = "clmul_sse42",
+     .required_features = "sse4.2,clmul",
+     .is_supported = s_has_sse42_clmul,
+     .crc32_fn = aws_checksums_crc32c_clmul_sse42},
+#    endif
+#    if defined(AWS_HAVE_AVX512_INTRINSICS)
+    {.name = "avx512",
+     .required_features = "sse4.2,clmul,avx512,vpclmulqdq",
+     .is_supported = s_has_avx512_vpclmulqdq,
+     .crc32_fn = aws_checksums_crc32c_intel_avx512_with_sse_fallback},
+#    endif
+#elif defined(AWS_USE_CPU_EXTENSIONS) && defined(AWS_ARCH_ARM64)
+    {.name = "armv8",
+     .required_features = "crc",
+     .is_supported = s_has_arm_crc,
+     .crc32_fn = aws_checksums_crc32c_armv8,
+     .crc32_x4_fn = aws_checksums_crc32c_armv8_x4},
+#endif
+};
+
+static const struct aws_checksums_crc_kernel *s_find_kernel(
+    const struct aws_checksums_crc_kernel *kernels,
+    size_t count,
+    crc32_kernel_fn *fn) {
+    for (size_t i = 0; i < count; ++i) {
+        if (kernels[i].crc32_fn == fn) {
+            return &kernels[i];
+        }
+    }
+    AWS_FATAL_ASSERT(false && "default crc32 kernel is not in the kernel list");
+    return NULL;
+}
+
+static void s_set_defaults(
+    enum aws_checksums_crc_algorithm algorithm,
+    const struct aws_checksums_crc_kernel *kernels,
+    size_t count,
+    crc32_kernel_fn *tiny,
+    crc32_kernel_fn *small,
+    crc32_kernel_fn *wide) {
+
+    const struct aws_checksums_crc_kernel **dispatch_kernels = aws_checksums_dispatch.crc32_kernels[algorithm];
+    dispatch_kernels[AWS_CHECKSUMS_SIZE_CLASS_TINY] = s_find_kernel(kernels, count, tiny);
+    dispatch_kernels[AWS_CHECKSUMS_SIZE_CLASS_SMALL] = s_find_kernel(kernels, count, small);
+    dispatch_kernels[AWS_CHECKSUMS_SIZE_CLASS_MEDIUM] = s_find_kernel(kernels, count, wide);
+    dispatch_kernels[AWS_CHECKSUMS_SIZE_CLASS_LARGE] = s_find_kernel(kernels, count, wide);
+
+    crc32_kernel_fn **fns = aws_checksums_dispatch.crc32_fns[algorithm];
+    fns[AWS_CHECKSUMS_SIZE_CLASS_LARGE] = wide;
+    fns[AWS_CHECKSUMS_SIZE_CLASS_MEDIUM] = wide;
+    fns[AWS_CHECKSUMS_SIZE_CLASS_SMALL] = small;
+    /* tiny is assigned last since it is the slot used to check whether the table is initialized. */
+    fns[AWS_CHECKSUMS_SIZE_CLASS_TINY] = tiny;
+}
+
+static void s_install_crc32_defaults(void) {
+    crc32_kernel_fn *kernel = aws_checksums_crc32_sw;
+#if defined(AWS_CHECKSUMS_STATIC_DISPATCH)
+    kernel = AWS_CHECKSUMS_CRC32_STATIC_FN;
+#elif defined(AWS_USE_CPU_EXTENSIONS) && defined(AWS_ARCH_ARM64)
+    if (aws_cpu_has_feature(AWS_CPU_FEATURE_ARM_CRC)) {
+        kernel = aws_checksums_crc32_armv8;
+    }
+#endif
+    s_set_defaults(
+        AWS_CHECKSUMS_CRC_ALGORITHM_CRC32, s_crc32_kernels, AWS_ARRAY_SIZE(s_crc32_kernels), kernel, kernel, kernel);
+}
+
+static void s_install_crc32c_defaults(void) {
+    crc32_kernel_fn *tiny = aws_checksums_crc32c_sw;
+    crc32_kernel_fn *small = aws_checksums_crc32c_sw;
+    crc32_kernel_fn *wide = aws_checksums_crc32c_sw;
+#if defined(AWS_CHECKSUMS_STATIC_DISPATCH)
+    tiny = AWS_CHECKSUMS_CRC32C_STATIC_FN;
+    small = AWS_CHECKSUMS_CRC32C_STATIC_FN;
+    wide = AWS_CHECKSUMS_CRC32C_STATIC_FN;
+#elif defined(AWS_USE_CPU_EXTENSIONS) && defined(AWS_ARCH_INTEL_X64)
+    /*
+     * aws-c-common does not expose the cpu model, so defaults are keyed off the feature tier instead, which is
+     * what separates the relevant microarchitectures anyway. Every cpu with both avx512 and vpclmulqdq (Ice Lake
+     * and newer, Zen 4 and newer) runs zmm clmul without a meaningful frequency penalty, and on those the avx512
+     * kernel is ~1.6x faster than the 3-way crc32q kernel at 512 bytes (it hands anything under 256 bytes to
+     * that kernel itself). Below 64 bytes the plain crc32q loop wins over both since it skips their
+     * feature checks and block setup.
+     */
+    if (aws_cpu_has_feature(AWS_CPU_FEATURE_SSE_4_2)) {
+        tiny = aws_checksums_crc32c_intel_sse42;
+        small = aws_checksums_crc32c_intel_sse42;
+#    if !defined(_MSC_VER)
+        if (aws_cpu_has_feature(AWS_CPU_FEATURE_CLMUL)) {
+            small = aws_checksums_crc32c_clmul_sse42;
         }
+#    endif
+#    if defined(AWS_HAVE_AVX512_INTRINSICS)
+        if (aws_cpu_has_feature(AWS_CPU_FEATURE_AVX512) && aws_cpu_has_feature(AWS_CPU_FEATURE_VPCLMULQDQ) &&
+            aws_cpu_has_feature(AWS_CPU_FEATURE_CLMUL)) {
+            small = aws_checksums_crc32c_intel_avx512_with_sse_fallback;
+        }
+#    endif
+        wide = small;
+    }
 #elif defined(AWS_USE_CPU_EXTENSIONS) && defined(AWS_ARCH_ARM64)
-        if (aws_cpu_has_feature(AWS_CPU_FEATURE_ARM_CRC)) {
-            s_crc32c_fn_ptr = aws_checksums_crc32c_armv8;
-        } else {
-            s_crc32c_fn_ptr = aws_checksums_crc32c_sw;
+    if (aws_cpu_has_feature(AWS_CPU_FEATURE_ARM_CRC)) {
+        tiny = aws_checksums_crc32c_armv8;
+        small = aws_checksums_crc32c_armv8;
+        wide = aws_checksums_crc32c_armv8;
+    }
+#endif
+    s_set_defaults(
+        AWS_CHECKSUMS_CRC_ALGORITHM_CRC32C, s_crc32c_kernels, AWS_ARRAY_SIZE(s_crc32c_kernels), tiny, small, wide);
+}
+
+void aws_checksums_crc32_init(void) {
+    if (aws_checksums_dispatch.crc32_fns[AWS_CHECKSUMS_CRC_ALGORITHM_CRC32][AWS_CHECKSUMS_SIZE_CLASS_TINY] == NULL) {
+        s_install_crc32_defaults();
+    }
+
+    if (aws_checksums_dispatch.crc32_fns[AWS_CHECKSUMS_CRC_ALGORITHM_CRC32C][AWS_CHECKSUMS_SIZE_CLASS_TINY] == NULL) {
+        s_install_crc32c_defaults();
+    }
+
+    /* hw versions on intel with pclmulqdq, arm still uses sw. */
+    if (aws_checksums_dispatch.crc32_combine_fns[AWS_CHECKSUMS_CRC_ALGORITHM_CRC32] == NULL) {
+        aws_checksums_dispatch.crc32_combine_fns[AWS_CHECKSUMS_CRC_ALGORITHM_CRC32] = aws_checksums_crc32_combine_sw;
+#if defined(AWS_USE_CPU_EXTENSIONS) && defined(AWS_ARCH_INTEL_X64) && defined(AWS_HAVE_CLMUL) && !defined(_MSC_VER)
+        if (s_has_sse42_clmul()) {
+            aws_checksums_dispatch.crc32_combine_fns[AWS_CHECKSUMS_CRC_ALGORITHM_CRC32] =
+                aws_checksums_crc32_combine_clmul;
         }
-#else
-        s_crc32c_fn_ptr = aws_checksums_crc32c_sw;
 #endif
     }
 
-    /* SW for now. still need to add hw versions. */
-    if (s_crc32_combine_fn_ptr == NULL) {
-        s_crc32_combine_fn_ptr = aws_checksums_crc32_combine_sw;
+    if (aws_checksums_dispatch.crc32_combine_fns[AWS_CHECKSUMS_CRC_ALGORITHM_CRC32C] == NULL) {
+        aws_checksums_dispatch.crc32_combine_fns[AWS_CHECKSUMS_CRC_ALGORITHM_CRC32C] = aws_checksums_crc32c_combine_sw;
+#if defined(AWS_USE_CPU_EXTENSIONS) && defined(AWS_ARCH_INTEL_X64) && defined(AWS_HAVE_CLMUL) && !defined(_MSC_VER)
+        if (s_has_sse42_clmul()) {
+            aws_checksums_dispatch.crc32_combine_fns[AWS_CHECKSUMS_CRC_ALGORITHM_CRC32C] =
+                aws_checksums_crc32c_combine_clmul;
+        }
+#endif
     }
+}
 
-    if (s_crc32c_combine_fn_ptr == NULL) {
-        s_crc32c_combine_fn_ptr = aws_checksums_crc32c_combine_sw;
+void aws_checksums_crc32_install_default_kernels(enum aws_checksums_crc_algorithm algorithm) {
+    AWS_FATAL_ASSERT(
+        algorithm == AWS_CHECKSUMS_CRC_ALGORITHM_CRC32 || algorithm == AWS_CHECKSUMS_CRC_ALGORITHM_CRC32C);
+
+    if (algorithm == AWS_CHECKSUMS_CRC_ALGORITHM_CRC32) {
+        s_install_crc32_defaults();
+    } else {
+        s_install_crc32c_defaults();
     }
 }
 
+const struct aws_checksums_crc_kernel *aws_checksums_crc32_kernels(
+    enum aws_checksums_crc_algorithm algorithm,
+    size_t *count) {
+    AWS_FATAL_ASSERT(
+        algorithm == AWS_CHECKSUMS_CRC_ALGORITHM_CRC32 || algorithm == AWS_CHECKSUMS_CRC_ALGORITHM_CRC32C);
+
+    if (algorithm == AWS_CHECKSUMS_CRC_ALGORITHM_CRC32) {
+        *count = AWS_ARRAY_SIZE(s_crc32_kernels);
+        return s_crc32_kernels;
+    }
+
+    *count = AWS_ARRAY_SIZE(s_crc32c_kernels);
+    return s_crc32c_kernels;
+}
+
+const struct aws_checksums_crc_kernel *aws_checksums_crc32_active_kernel(
+    enum aws_checksums_crc_algorithm algorithm,
+    size_t size_class) {
+    AWS_FATAL_ASSERT(
+        algorithm == AWS_CHECKSUMS_CRC_ALGORITHM_CRC32 || algorithm == AWS_CHECKSUMS_CRC_ALGORITHM_CRC32C);
+    AWS_FATAL_ASSERT(size_class < AWS_CHECKSUMS_SIZE_CLASS_COUNT);
+    aws_checksums_crc32_init();
+    return aws_checksums_dispatch.crc32_kernels[algorithm][size_class];
+}
+
+void aws_checksums_crc32_install_kernel(
+    enum aws_checksums_crc_algorithm algorithm,
+    size_t size_class,
+    const struct aws_checksums_crc_kernel *kernel) {
+    AWS_FATAL_ASSERT(
+        algorithm == AWS_CHECKSUMS_CRC_ALGORITHM_CRC32 || algorithm == AWS_CHECKSUMS_CRC_ALGORITHM_CRC32C);
+    AWS_FATAL_ASSERT(size_class < AWS_CHECKSUMS_SIZE_CLASS_COUNT);
+    AWS_FATAL_ASSERT(kernel->crc32_fn != NULL && kernel->is_supported());
+
+    /* make sure lazy init does not later overwrite the choice with the defaults */
+    aws_checksums_crc32_init();
+
+    aws_checksums_dispatch.crc32_kernels[algorithm][size_class] = kernel;
+    aws_checksums_dispatch.crc32_fns[algorithm][size_class] = kernel->crc32_fn;
+}
+
 uint32_t aws_checksums_crc32(const uint8_t *input, int length, uint32_t previous_crc32) {
-    if (AWS_UNLIKELY(s_crc32_fn_ptr == NULL)) {
+#if defined(AWS_CHECKSUMS_STATIC_DISPATCH)
+    return AWS_CHECKSUMS_CRC32_STATIC_FN(input, length, previous_crc32);
+#else
+    crc32_kernel_fn *const *fns = aws_checksums_dispatch.crc32_fns[AWS_CHECKSUMS_CRC_ALGORITHM_CRC32];
+    crc32_kernel_fn *kernel = fns[aws_checksums_size_class(length)];
+    if (AWS_CHECKSUMS_NEEDS_LAZY_INIT(kernel)) {
         aws_checksums_crc32_init();
+        kernel = fns[aws_checksums_size_class(length)];
     }
-    return s_crc32_fn_ptr(input, length, previous_crc32);
+
+    return kernel(input, length, previous_crc32);
+#endif
 }
 
 uint32_t aws_checksums_crc32_ex(const uint8_t *input, size_t length, uint32_t previous_crc32) {
@@ -621,29 +859,186 @@ uint32_t aws_checksums_crc32_ex(const uint8_t *input, size_t length, uint32_t pr
 }
 
 uint32_t aws_checksums_crc32c(const uint8_t *input, int length, uint32_t previous_crc32c) {
-    if (AWS_UNLIKELY(s_crc32c_fn_ptr == NULL)) {
+#if defined(AWS_CHECKSUMS_STATIC_DISPATCH)
+    return AWS_CHECKSUMS_CRC32C_STATIC_FN(input, length, previous_crc32c);
+#else
+    crc32_kernel_fn *const *fns = aws_checksums_dispatch.crc32_fns[AWS_CHECKSUMS_CRC_ALGORITHM_CRC32C];
+    crc32_kernel_fn *kernel = fns[aws_checksums_size_class(length)];
+    if (AWS_CHECKSUMS_NEEDS_LAZY_INIT(kernel)) {
         aws_checksums_crc32_init();
+        kernel = fns[aws_checksums_size_class(length)];
     }
 
-    return s_crc32c_fn_ptr(input, length, previous_crc32c);
+    return kernel(input, length, previous_crc32c);
+#endif
 }
 
 uint32_t aws_checksums_crc32c_ex(const uint8_t *input, size_t length, uint32_t previous_crc32) {
     return aws_large_buffer_apply_crc32(aws_checksums_crc32c, input, length, previous_crc32);
 }
 
+uint32_t aws_checksums_crc32_iov(const struct aws_byte_cursor *segments, size_t count, uint32_t previous_crc32) {
+    return aws_iov_apply_crc32(aws_checksums_crc32_ex, segments, count, previous_crc32);
+}
+
+uint32_t aws_checksums_crc32c_iov(const struct aws_byte_cursor *segments, size_t count, uint32_t previous_crc32c) {
+    return aws_iov_apply_crc32(aws_checksums_crc32c_ex, segments, count, previous_crc32c);
+}
+
+uint32_t aws_checksums_crc32_copy(uint8_t *dst, const uint8_t *src, size_t length, uint32_t previous_crc32) {
+    return aws_copy_apply_crc32(aws_checksums_crc32_ex, aws_checksums_copy, dst, src, length, previous_crc32);
+}
+
+uint32_t aws_checksums_crc32_copy_nt(uint8_t *dst, const uint8_t *src, size_t length, uint32_t previous_crc32) {
+    return aws_copy_apply_crc32(aws_checksums_crc32_ex, aws_checksums_copy_nt, dst, src, length, previous_crc32);
+}
+
+uint32_t aws_checksums_crc32c_copy(uint8_t *dst, const uint8_t *src, size_t length, uint32_t previous_crc32c) {
+    return aws_copy_apply_crc32(aws_checksums_crc32c_ex, aws_checksums_copy, dst, src, length, previous_crc32c);
+}
+
+uint32_t aws_checksums_crc32c_copy_nt(uint8_t *dst, const uint8_t *src, size_t length, uint32_t previous_crc32c) {
+    return aws_copy_apply_crc32(aws_checksums_crc32c_ex, aws_checksums_copy_nt, dst, src, length, previous_crc32c);
+}
+
 uint32_t aws_checksums_crc32_combine(uint32_t crc1, uint32_t crc2, uint64_t len2) {
-    if (AWS_UNLIKELY(s_crc32_combine_fn_ptr == NULL)) {
+    if (AWS_CHECKSUMS_NEEDS_LAZY_INIT(aws_checksums_dispatch.crc32_combine_fns[AWS_CHECKSUMS_CRC_ALGORITHM_CRC32])) {
         aws_checksums_crc32_init();
     }
 
-    return s_crc32_combine_fn_ptr(crc1, crc2, len2);
+    return aws_checksums_dispatch.crc32_combine_fns[AWS_CHECKSUMS_CRC_ALGORITHM_CRC32](crc1, crc2, len2);
 }
 
 uint32_t aws_checksums_crc32c_combine(uint32_t crc1, uint32_t crc2, uint64_t len2) {
-    if (AWS_UNLIKELY(s_crc32c_combine_fn_ptr == NULL)) {
+    if (AWS_CHECKSUMS_NEEDS_LAZY_INIT(aws_checksums_dispatch.crc32_combine_fns[AWS_CHECKSUMS_CRC_ALGORITHM_CRC32C])) {
         aws_checksums_crc32_init();
     }
 
-    return s_crc32c_combine_fn_ptr(crc1, crc2, len2);
+    return aws_checksums_dispatch.crc32_combine_fns[AWS_CHECKSUMS_CRC_ALGORITHM_CRC32C](crc1, crc2, len2);
+}
+
+/*
+ * Appending zeros multiplies the crc register, i.e. the crc without its final inversion, by x^(8 * num_zero_bytes).
+ * combine() with crc2 = 0 is exactly that multiplication, so the inversions are undone around it.
+ */
+uint32_t aws_checksums_crc32_zero_extend(uint32_t crc, uint64_t num_zero_bytes) {
+    return ~aws_checksums_crc32_combine(~crc, 0, num_zero_bytes);
+}
+
+uint32_t aws_checksums_crc32c_zero_extend(uint32_t crc, uint64_t num_zero_bytes) {
+    return ~aws_checksums_crc32c_combine(~crc, 0, num_zero_bytes);
+}
+
+/*
+ * combine() computes crc_ab = shift(crc_a, len_b) ^ crc_b, so the prefix is a shift of crc_ab ^ crc_b undone, and the
+ * suffix is crc_ab with the shifted prefix xor-ed back out.
+ */
+uint32_t aws_checksums_crc32_uncombine_suffix(uint32_t crc_ab, uint32_t crc_b, uint64_t len_b) {
+    return aws_checksums_crc32_unshift_sw(crc_ab ^ crc_b, len_b);
+}
+
+uint32_t aws_checksums_crc32_uncombine_prefix(uint32_t crc_ab, uint32_t crc_a, uint64_t len_b) {
+    return aws_checksums_crc32_combine(crc_a, 0, len_b) ^ crc_ab;
+}
+
+uint32_t aws_checksums_crc32c_uncombine_suffix(uint32_t crc_ab, uint32_t crc_b, uint64_t len_b) {
+    return aws_checksums_crc32c_unshift_sw(crc_ab ^ crc_b, len_b);
+}
+
+uint32_t aws_checksums_crc32c_uncombine_prefix(uint32_t crc_ab, uint32_t crc_a, uint64_t len_b) {
+    return aws_checksums_crc32c_combine(crc_a, 0, len_b) ^ crc_ab;
+}
+
+uint32_t aws_checksums_crc32_patch(
+    uint32_t old_crc,
+    uint64_t total_len,
+    uint64_t offset,
+    const uint8_t *old_bytes,
+    const uint8_t *new_bytes,
+    size_t len) {
+    return aws_patch_apply_crc32(
+        aws_checksums_crc32_ex, aws_checksums_crc32_combine, old_crc, total_len, offset, old_bytes, new_bytes, len);
+}
+
+uint32_t aws_checksums_crc32c_patch(
+    uint32_t old_crc,
+    uint64_t total_len,
+    uint64_t offset,
+    const uint8_t *old_bytes,
+    const uint8_t *new_bytes,
+    size_t len) {
+    return aws_patch_apply_crc32(
+        aws_checksums_crc32c_ex, aws_checksums_crc32c_combine, old_crc, total_len, offset, old_bytes, new_bytes, len);
+}
+
+uint32_t aws_checksums_crc32_combine_many(const struct aws_crc_segment *segs, size_t n) {
+    return aws_combine_many_crc32(aws_checksums_crc32_combine, 0xEDB88320, segs, n);
+}
+
+uint32_t aws_checksums_crc32c_combine_many(const struct aws_crc_segment *segs, size_t n) {
+    return aws_combine_many_crc32(aws_checksums_crc32c_combine, 0x82F63B78, segs, n);
+}
+
+/*
+ * Buffers shorter than this are interleaved four at a time when the active tiny kernel has a multi-buffer variant.
+ * Measured on an avx512 + vpclmulqdq host, batches of 64 buffers: interleaving is 1.5-2x faster than one call per
+ * buffer from 64 to 255 bytes. From 256 bytes on the avx512 kernel folds the buffer itself and the two are even.
+ */
+#define CRC32_BATCH_INTERLEAVE_LIMIT 256
+
+static void s_crc32_batch(
+    enum aws_checksums_crc_algorithm algorithm,
+    uint32_t (*crc_fn)(const uint8_t *input, size_t length, uint32_t previous_crc),
+    const struct aws_byte_cursor *inputs,
+    uint32_t *out_crcs,
+    size_t count) {
+    AWS_PRECONDITION(inputs != NULL || count == 0);
+    AWS_PRECONDITION(out_crcs != NULL || count == 0);
+
+    aws_checksums_crc32_x4_fn *x4_fn =
+        aws_checksums_crc32_active_kernel(algorithm, AWS_CHECKSUMS_SIZE_CLASS_TINY)->crc32_x4_fn;
+
+    size_t lanes[4];
+    size_t lane_count = 0;
+    for (size_t i = 0; i < count; ++i) {
+        if (x4_fn == NULL || inputs[i].len >= CRC32_BATCH_INTERLEAVE_LIMIT) {
+            out_crcs[i] = crc_fn(inputs[i].ptr, inputs[i].len, 0);
+            continue;
+        }
+
+        lanes[lane_count++] = i;
+        if (lane_count < 4) {
+            continue;
+        }
+        lane_count = 0;
+
+        /* interleave over the common prefix, then finish each buffer's tail on its own */
+        size_t common = aws_min_size(
+            aws_min_size(inputs[lanes[0]].len, inputs[lanes[1]].len),
+            aws_min_size(inputs[lanes[2]].len, inputs[lanes[3]].len));
+        const uint8_t *lane_inputs[4] = {
+            inputs[lanes[0]].ptr, inputs[lanes[1]].ptr, inputs[lanes[2]].ptr, inputs[lanes[3]].ptr};
+        uint32_t crcs[4] = {0, 0, 0, 0};
+        x4_fn(lane_inputs, (int)common, crcs);
+
+        for (size_t lane = 0; lane < 4; ++lane) {
+            const struct aws_byte_cursor *input = &inputs[lanes[lane]];
+            out_crcs[lanes[lane]] =
+                input->len == common ? crcs[lane] : crc_fn(input->ptr + common, input->len - common, crcs[lane]);
+        }
+    }
+
+    /* fewer than 4 left over */
+    for (size_t lane = 0; lane < lane_count; ++lane) {
+        const struct aws_byte_cursor *input = &inputs[lanes[lane]];
+        out_crcs[lanes[lane]] = crc_fn(input->ptr, input->len, 0);
+    }
+}
+
+void aws_checksums_crc32_batch(const struct aws_byte_cursor *inputs, uint32_t *out_crcs, size_t count) {
+    s_crc32_batch(AWS_CHECKSUMS_CRC_ALGORITHM_CRC32, aws_checksums_crc32_ex, inputs, out_crcs, count);
+}
+
+void aws_checksums_crc32c_batch(const struct aws_byte_cursor *inputs, uint32_t *out_crcs, size_t count) {
+    s_crc32_batch(AWS_CHECKSUMS_CRC_ALGORITHM_CRC32C, aws_checksums_crc32c_ex, inputs, out_crcs, count);
 }
@@ -5,10 +5,15 @@
 
 #include <aws/checksums/crc.h>
 #include <aws/checksums/private/crc64_priv.h>
+#include <aws/checksums/private/crc_kernels_priv.h>
 #include <aws/checksums/private/crc_util.h>
 #include <aws/common/cpuid.h>
 
 large_buffer_apply_impl(crc64, uint64_t)
+iov_apply_impl(crc64, uint64_t)
+copy_apply_impl(crc64, uint64_t)
+patch_apply_impl(crc64, uint64_t)
+combine_many_impl(crc64, uint64_t)
 
     AWS_ALIGNED_TYPEDEF(uint8_t, checksums_maxks_shifts_type[6][16], 16);
 
@@ -382,69 +387,263 @@ checksums_constants aws_checksums_crc64nvme_constants = {
 };
 /* clang-format on */
 
-static uint64_t (*s_crc64nvme_fn_ptr)(const uint8_t *input, int length, uint64_t prev_crc64) = NULL;
-static uint64_t (*s_crc64nvme_combine_fn_ptr)(uint64_t crc1, uint64_t crc2, uint64_t len2) = NULL;
+/* See the AWS_CHECKSUMS_STATIC_DISPATCH note in crc32.c. */
+#if defined(AWS_CHECKSUMS_STATIC_DISPATCH)
+#    if defined(AWS_USE_CPU_EXTENSIONS) && defined(AWS_ARCH_INTEL_X64) && defined(AWS_HAVE_AVX512_INTRINSICS) &&     \
+        defined(AWS_CHECKSUMS_STATIC_HAS_AVX512) && defined(AWS_CHECKSUMS_STATIC_HAS_VPCLMULQDQ)
+#        define AWS_CHECKSUMS_CRC64NVME_STATIC_FN aws_checksums_crc64nvme_intel_avx512
+#        if defined(AWS_HAVE_CLMUL)
+#            define AWS_CHECKSUMS_CRC64NVME_COMBINE_STATIC_FN aws_checksums_crc64nvme_combine_clmul
+#        else
+#            define AWS_CHECKSUMS_CRC64NVME_COMBINE_STATIC_FN aws_checksums_crc64nvme_combine_sw
+#        endif
+#    elif defined(AWS_USE_CPU_EXTENSIONS) && defined(AWS_ARCH_INTEL_X64) && defined(AWS_HAVE_CLMUL) &&                \
+        defined(AWS_HAVE_AVX2_INTRINSICS) && defined(AWS_CHECKSUMS_STATIC_HAS_CLMUL) &&                               \
+        defined(AWS_CHECKSUMS_STATIC_HAS_AVX2)
+#        define AWS_CHECKSUMS_CRC64NVME_STATIC_FN aws_checksums_crc64nvme_intel_clmul
+#        define AWS_CHECKSUMS_CRC64NVME_COMBINE_STATIC_FN aws_checksums_crc64nvme_combine_clmul
+#    elif defined(AWS_USE_CPU_EXTENSIONS) && defined(AWS_ARCH_ARM64) && defined(AWS_HAVE_ARMv8_1) &&                  \
+        defined(AWS_CHECKSUMS_STATIC_HAS_ARM_CRYPTO)
+#        define AWS_CHECKSUMS_CRC64NVME_STATIC_FN aws_checksums_crc64nvme_arm_pmull
+#        define AWS_CHECKSUMS_CRC64NVME_COMBINE_STATIC_FN aws_checksums_crc64nvme_combine_arm_pmull
+#    else
+#        define AWS_CHECKSUMS_CRC64NVME_STATIC_FN aws_checksums_crc64nvme_sw
+#        define AWS_CHECKSUMS_CRC64NVME_COMBINE_STATIC_FN aws_checksums_crc64nvme_combine_sw
+#    endif
+#endif
+
+typedef uint64_t(crc64_kernel_fn)(const uint8_t *input, int length, uint64_t prev_crc64);
+
+static bool s_always_supported(void) {
+    return true;
+}
 
-void aws_checksums_crc64_init(void) {
-    if (s_crc64nvme_fn_ptr == NULL) {
 #if defined(AWS_USE_CPU_EXTENSIONS) && defined(AWS_ARCH_INTEL_X64) && !(defined(_MSC_VER) && _MSC_VER < 1920)
+#    if defined(AWS_HAVE_CLMUL) && defined(AWS_HAVE_AVX2_INTRINSICS)
+static bool s_has_clmul_avx2(void) {
+    return aws_cpu_has_feature(AWS_CPU_FEATURE_CLMUL) && aws_cpu_has_feature(AWS_CPU_FEATURE_AVX2);
+}
+#    endif
+
 #    if defined(AWS_HAVE_AVX512_INTRINSICS)
-        if (aws_cpu_has_feature(AWS_CPU_FEATURE_AVX512) && aws_cpu_has_feature(AWS_CPU_FEATURE_VPCLMULQDQ)) {
-            s_crc64nvme_fn_ptr = aws_checksums_crc64nvme_intel_avx512;
-        } else
+static bool s_has_avx512_vpclmulqdq(void) {
+    return aws_cpu_has_feature(AWS_CPU_FEATURE_AVX512) && aws_cpu_has_feature(AWS_CPU_FEATURE_VPCLMULQDQ);
+}
 #    endif
+#elif defined(AWS_USE_CPU_EXTENSIONS) && defined(AWS_ARCH_ARM64) && defined(AWS_HAVE_ARMv8_1)
+static bool s_has_arm_pmull(void) {
+    return aws_cpu_has_feature(AWS_CPU_FEATURE_ARM_CRYPTO) && aws_cpu_has_feature(AWS_CPU_FEATURE_ARM_PMULL);
+}
+#endif
+
+static const struct aws_checksums_crc_kernel s_crc64nvme_kernels[] = {
+    {.name = "sw", .required_features = "", .is_supported = s_always_supported, .crc64_fn = aws_checksums_crc64nvme_sw},
+#if defined(AWS_USE_CPU_EXTENSIONS) && defined(AWS_ARCH_INTEL_X64) && !(defined(_MSC_VER) && _MSC_VER < 1920)
 #    if defined(AWS_HAVE_CLMUL) && defined(AWS_HAVE_AVX2_INTRINSICS)
-            if (aws_cpu_has_feature(AWS_CPU_FEATURE_CLMUL) && aws_cpu_has_feature(AWS_CPU_FEATURE_AVX2)) {
-            s_crc64nvme_fn_ptr = aws_checksums_crc64nvme_intel_clmul;
-        } else {
-            s_crc64nvme_fn_ptr = aws_checksums_crc64nvme_sw;
+    {.name = "clmul",
+     .required_features = "clmul,avx2",
+     .is_supported = s_has_clmul_avx2,
+     .crc64_fn = aws_checksums_crc64nvme_intel_clmul},
+#    endif
+#    if defined(AWS_HAVE_AVX512_INTRINSICS)
+    {.name = "avx512",
+     .required_features = "avx512,vpclmulqdq",
+     .is_supported = s_has_avx512_vpclmulqdq,
+     .crc64_fn = aws_checksums_crc64nvme_intel_avx512},
+#    endif
+#elif defined(AWS_USE_CPU_EXTENSIONS) && defined(AWS_ARCH_ARM64) && defined(AWS_HAVE_ARMv8_1)
+    {.name = "pmull",
+     .required_features = "crypto,pmull",
+     .is_supported = s_has_arm_pmull,
+     .crc64_fn = aws_checksums_crc64nvme_arm_pmull},
+#endif
+};
+
+static const struct aws_checksums_crc_kernel *s_find_kernel(crc64_kernel_fn *fn) {
+    for (size_t i = 0; i < AWS_ARRAY_SIZE(s_crc64nvme_kernels); ++i) {
+        if (s_crc64nvme_kernels[i].crc64_fn == fn) {
+            return &s_crc64nvme_kernels[i];
         }
+    }
+    AWS_FATAL_ASSERT(false && "default crc64 kernel is not in the kernel list");
+    return NULL;
+}
+
+void aws_checksums_crc64_install_default_kernels(void) {
+    crc64_kernel_fn *narrow = aws_checksums_crc64nvme_sw;
+    crc64_kernel_fn *wide = aws_checksums_crc64nvme_sw;
+#if defined(AWS_CHECKSUMS_STATIC_DISPATCH)
+    narrow = AWS_CHECKSUMS_CRC64NVME_STATIC_FN;
+    wide = AWS_CHECKSUMS_CRC64NVME_STATIC_FN;
+#elif defined(AWS_USE_CPU_EXTENSIONS) && defined(AWS_ARCH_INTEL_X64) && !(defined(_MSC_VER) && _MSC_VER < 1920)
+#    if defined(AWS_HAVE_CLMUL) && defined(AWS_HAVE_AVX2_INTRINSICS)
+    if (s_has_clmul_avx2()) {
+        narrow = aws_checksums_crc64nvme_intel_clmul;
+        wide = aws_checksums_crc64nvme_intel_clmul;
+    }
 #    endif
-#    if !(defined(AWS_HAVE_AVX512_INTRINSICS) || (defined(AWS_HAVE_CLMUL) && defined(AWS_HAVE_AVX2_INTRINSICS)))
-        s_crc64nvme_fn_ptr = aws_checksums_crc64nvme_sw;
+#    if defined(AWS_HAVE_AVX512_INTRINSICS)
+    /* the avx512 kernel hands anything under 512 bytes to the clmul kernel, so keep tiny inputs off of it. */
+    if (s_has_avx512_vpclmulqdq()) {
+        wide = aws_checksums_crc64nvme_intel_avx512;
+    }
 #    endif
 
 #elif defined(AWS_USE_CPU_EXTENSIONS) && defined(AWS_ARCH_ARM64) && defined(AWS_HAVE_ARMv8_1)
-        if (aws_cpu_has_feature(AWS_CPU_FEATURE_ARM_CRYPTO) && aws_cpu_has_feature(AWS_CPU_FEATURE_ARM_PMULL)) {
-            s_crc64nvme_fn_ptr = aws_checksums_crc64nvme_arm_pmull;
-        } else {
-            s_crc64nvme_fn_ptr = aws_checksums_crc64nvme_sw;
-        }
-#else // this branch being taken means it's not arm64 and not intel with avx extensions
-        s_crc64nvme_fn_ptr = aws_checksums_crc64nvme_sw;
+    if (s_has_arm_pmull()) {
+        narrow = aws_checksums_crc64nvme_arm_pmull;
+        wide = aws_checksums_crc64nvme_arm_pmull;
+    }
 #endif
+    const struct aws_checksums_crc_kernel **kernels = aws_checksums_dispatch.crc64nvme_kernels;
+    kernels[AWS_CHECKSUMS_SIZE_CLASS_TINY] = s_find_kernel(narrow);
+    kernels[AWS_CHECKSUMS_SIZE_CLASS_SMALL] = s_find_kernel(wide);
+    kernels[AWS_CHECKSUMS_SIZE_CLASS_MEDIUM] = s_find_kernel(wide);
+    kernels[AWS_CHECKSUMS_SIZE_CLASS_LARGE] = s_find_kernel(wide);
+
+    crc64_kernel_fn **fns = aws_checksums_dispatch.crc64nvme_fns;
+    fns[AWS_CHECKSUMS_SIZE_CLASS_LARGE] = wide;
+    fns[AWS_CHECKSUMS_SIZE_CLASS_MEDIUM] = wide;
+    fns[AWS_CHECKSUMS_SIZE_CLASS_SMALL] = wide;
+    /* tiny is assigned last since it is the slot used to check whether the table is initialized. */
+    fns[AWS_CHECKSUMS_SIZE_CLASS_TINY] = narrow;
+}
+
+void aws_checksums_crc64_init(void) {
+    if (aws_checksums_dispatch.crc64nvme_fns[AWS_CHECKSUMS_SIZE_CLASS_TINY] == NULL) {
+        aws_checksums_crc64_install_default_kernels();
     }
 
-    if (s_crc64nvme_combine_fn_ptr == NULL) {
-        // arm only fancy version for now. still need to implement x64
+    if (aws_checksums_dispatch.crc64nvme_combine_fn == NULL) {
 #if defined(AWS_USE_CPU_EXTENSIONS) && defined(AWS_ARCH_ARM64) && defined(AWS_HAVE_ARMv8_1)
         if (aws_cpu_has_feature(AWS_CPU_FEATURE_ARM_PMULL)) {
-            s_crc64nvme_combine_fn_ptr = aws_checksums_crc64nvme_combine_arm_pmull;
+            aws_checksums_dispatch.crc64nvme_combine_fn = aws_checksums_crc64nvme_combine_arm_pmull;
+        } else {
+            aws_checksums_dispatch.crc64nvme_combine_fn = aws_checksums_crc64nvme_combine_sw;
+        }
+#elif defined(AWS_USE_CPU_EXTENSIONS) && defined(AWS_ARCH_INTEL_X64) && defined(AWS_HAVE_CLMUL) &&                     \
+    defined(AWS_HAVE_AVX2_INTRINSICS) && !(defined(_MSC_VER) && _MSC_VER < 1920)
+        /* the kernel file is built with avx2 enabled, so require it like the clmul crc kernel does */
+        if (s_has_clmul_avx2()) {
+            aws_checksums_dispatch.crc64nvme_combine_fn = aws_checksums_crc64nvme_combine_clmul;
         } else {
-            s_crc64nvme_combine_fn_ptr = aws_checksums_crc64nvme_combine_sw;
+            aws_checksums_dispatch.crc64nvme_combine_fn = aws_checksums_crc64nvme_combine_sw;
         }
 #else // this branch being taken means it's not arm64 and not intel with avx extensions
-        s_crc64nvme_combine_fn_ptr = aws_checksums_crc64nvme_combine_sw;
+        aws_checksums_dispatch.crc64nvme_combine_fn = aws_checksums_crc64nvme_combine_sw;
 #endif
     }
 }
 
+const struct aws_checksums_crc_kernel *aws_checksums_crc64_kernels(size_t *count) {
+    *count = AWS_ARRAY_SIZE(s_crc64nvme_kernels);
+    return s_crc64nvme_kernels;
+}
+
+const struct aws_checksums_crc_kernel *aws_checksums_crc64_active_kernel(size_t size_class) {
+    AWS_FATAL_ASSERT(size_class < AWS_CHECKSUMS_SIZE_CLASS_COUNT);
+    aws_checksums_crc64_init();
+    return aws_checksums_dispatch.crc64nvme_kernels[size_class];
+}
+
+void aws_checksums_crc64_install_kernel(size_t size_class, const struct aws_checksums_crc_kernel *kernel) {
+    AWS_FATAL_ASSERT(size_class < AWS_CHECKSUMS_SIZE_CLASS_COUNT);
+    AWS_FATAL_ASSERT(kernel->crc64_fn != NULL && kernel->is_supported());
+
+    /* make sure lazy init does not later overwrite the choice with the defaults */
+    aws_checksums_crc64_init();
+
+    aws_checksums_dispatch.crc64nvme_kernels[size_class] = kernel;
+    aws_checksums_dispatch.crc64nvme_fns[size_class] = kernel->crc64_fn;
+}
+
 uint64_t aws_checksums_crc64nvme(const uint8_t *input, int length, uint64_t prev_crc64) {
-    if (AWS_UNLIKELY(s_crc64nvme_fn_ptr == NULL || s_crc64nvme_combine_fn_ptr == NULL)) {
+#if defined(AWS_CHECKSUMS_STATIC_DISPATCH)
+    return AWS_CHECKSUMS_CRC64NVME_STATIC_FN(input, length, prev_crc64);
+#else
+    crc64_kernel_fn *kernel = aws_checksums_dispatch.crc64nvme_fns[aws_checksums_size_class(length)];
+    if (AWS_CHECKSUMS_NEEDS_LAZY_INIT(kernel)) {
         aws_checksums_crc64_init();
+        kernel = aws_checksums_dispatch.crc64nvme_fns[aws_checksums_size_class(length)];
     }
 
-    return s_crc64nvme_fn_ptr(input, length, prev_crc64);
+    return kernel(input, length, prev_crc64);
+#endif
 }
 
 uint64_t aws_checksums_crc64nvme_ex(const uint8_t *input, size_t length, uint64_t previous_crc64) {
     return aws_large_buffer_apply_crc64(aws_checksums_crc64nvme, input, length, previous_crc64);
 }
 
+uint64_t aws_checksums_crc64nvme_iov(const struct aws_byte_cursor *segments, size_t count, uint64_t previous_crc64) {
+    return aws_iov_apply_crc64(aws_checksums_crc64nvme_ex, segments, count, previous_crc64);
+}
+
+uint64_t aws_checksums_crc64nvme_copy(uint8_t *dst, const uint8_t *src, size_t length, uint64_t previous_crc64) {
+    return aws_copy_apply_crc64(aws_checksums_crc64nvme_ex, aws_checksums_copy, dst, src, length, previous_crc64);
+}
+
+uint64_t aws_checksums_crc64nvme_copy_nt(uint8_t *dst, const uint8_t *src, size_t length, uint64_t previous_crc64) {
+    return aws_copy_apply_crc64(aws_checksums_crc64nvme_ex, aws_checksums_copy_nt, dst, src, length, previous_crc64);
+}
+
 uint64_t aws_checksums_crc64nvme_combine(uint64_t crc1, uint64_t crc2, uint64_t len2) {
-    if (AWS_UNLIKELY(s_crc64nvme_fn_ptr == NULL || s_crc64nvme_combine_fn_ptr == NULL)) {
+#if defined(AWS_CHECKSUMS_STATIC_DISPATCH)
+    return AWS_CHECKSUMS_CRC64NVME_COMBINE_STATIC_FN(crc1, crc2, len2);
+#else
+    if (AWS_CHECKSUMS_NEEDS_LAZY_INIT(aws_checksums_dispatch.crc64nvme_combine_fn)) {
         aws_checksums_crc64_init();
     }
 
-    return s_crc64nvme_combine_fn_ptr(crc1, crc2, len2);
+    return aws_checksums_dispatch.crc64nvme_combine_fn(crc1, crc2, len2);
+#endif
+}
+
+/* See aws_checksums_crc32_zero_extend(). */
+uint64_t aws_checksums_crc64nvme_zero_extend(uint64_t crc, uint64_t num_zero_bytes) {
+    return ~aws_checksums_crc64nvme_combine(~crc, 0, num_zero_bytes);
+}
+
+/* See aws_checksums_crc32_uncombine_suffix(). */
+uint64_t aws_checksums_crc64nvme_uncombine_suffix(uint64_t crc_ab, uint64_t crc_b, uint64_t len_b) {
+    return aws_checksums_crc64nvme_unshift_sw(crc_ab ^ crc_b, len_b);
+}
+
+uint64_t aws_checksums_crc64nvme_uncombine_prefix(uint64_t crc_ab, uint64_t crc_a, uint64_t len_b) {
+    return aws_checksums_crc64nvme_combine(crc_a, 0, len_b) ^ crc_ab;
+}
+
+uint64_t aws_checksums_crc64nvme_patch(
+    uint64_t old_crc,
+    uint64_t total_len,
+    uint64_t offset,
+    const uint8_t *old_bytes,
+    const uint8_t *new_bytes,
+    size_t len) {
+    return aws_patch_apply_crc64(
+        aws_checksums_crc64nvme_ex,
+        aws_checksums_crc64nvme_combine,
+        old_crc,
+        total_len,
+        offset,
+        old_bytes,
+        new_bytes,
+        len);
+}
+
+uint64_t aws_checksums_crc64nvme_combine_many(const struct aws_crc_segment *segs, size_t n) {
+    return aws_combine_many_crc64(aws_checksums_crc64nvme_combine, 0x9A6C9329AC4BC9B5, segs, n);
+}
+
+void aws_checksums_crc64nvme_batch(const struct aws_byte_cursor *inputs, uint64_t *out_crcs, size_t count) {
+    AWS_PRECONDITION(inputs != NULL || count == 0);
+    AWS_PRECONDITION(out_crcs != NULL || count == 0);
+
+    /*
+     * There is no scalar crc64 instruction to interleave, and the clmul kernels already fold several independent
+     * lanes of a single buffer, so buffers are simply processed one after another.
+     */
+    for (size_t i = 0; i < count; ++i) {
+        out_crcs[i] = aws_checksums_crc64nvme_ex(inputs[i].ptr, inputs[i].len, 0);
+    }
 }
@@ -1142,6 +1142,19 @@ uint64_t aws_checksums_crc64nvme_sw(const uint8_t *input, int length, uint64_t p
     return ~crc;
 }
 
+/* a * b modulo the bit-reflected poly, bit 63 holds the x^0 coefficient. */
+static uint64_t s_crc64nvme_multiply_mod_p(uint64_t poly, uint64_t a, uint64_t b) {
+    uint64_t product = 0;
+    for (int i = 0; i < 64; i++) {
+        if (a & ((uint64_t)1 << 63)) {
+            product ^= b;
+        }
+        a <<= 1;
+        b = (b >> 1) ^ ((b & 1) ? poly : 0);
+    }
+    return product;
+}
+
 #if defined(__SIZEOF_INT128__)
 uint64_t aws_checksums_crc64nvme_combine_sw(uint64_t crc1, uint64_t crc2, uint64_t len2) {
 
@@ -1165,13 +1178,6 @@ uint64_t aws_checksums_crc64nvme_combine_sw(uint64_t crc1, uint64_t crc2, uint64
 }
 #else
 
-static uint64_t s_crc64nvme_shift_one_zero(uint64_t poly, uint64_t crc) {
-    for (int i = 0; i < 8; i++) {
-        crc = (crc >> 1) ^ ((crc & 1) ? poly : 0);
-    }
-    return crc;
-}
-
 uint64_t aws_checksums_crc64nvme_combine_sw(uint64_t crc1, uint64_t crc2, uint64_t len2) {
 
     static const uint64_t crc64_poly = 0x9A6C9329AC4BC9B5;
@@ -1180,10 +1186,47 @@ uint64_t aws_checksums_crc64nvme_combine_sw(uint64_t crc1, uint64_t crc2, uint64
         return crc1;
     }
 
-    for (size_t i = 0; i < len2; i++) {
-        crc1 = s_crc64nvme_shift_one_zero(crc64_poly, crc1);
+    /* crc1 * x^(8 * len2) by square and multiply, see s_crc32_shift() in crc_sw.c */
+    uint64_t power = (uint64_t)1 << (63 - 8);
+    while (len2) {
+        if (len2 & 1) {
+            crc1 = s_crc64nvme_multiply_mod_p(crc64_poly, power, crc1);
+        }
+        power = s_crc64nvme_multiply_mod_p(crc64_poly, power, power);
+        len2 >>= 1;
     }
     return crc1 ^ crc2;
 }
 
 #endif
+
+/* x^(-8 * 2^k) modulo the bit-reflected poly for k = 0..63, see s_crc32_unshift_factors in crc_sw.c. */
+static const uint64_t s_crc64nvme_unshift_factors[64] = {
+    0x87c87e03060c1868, 0xc1b98ebd81f28879, 0x9ef7ddb45244a06c, 0xfb044f855b25ffb9,
+    0x3abdf378ace3b178, 0x546a8c0a9ee87365, 0x1c197c24ca623fd2, 0xe72b29c5faead7ac,
+    0x2f8e536c41adb96f, 0xb462cd9a549a7382, 0x0611ef8ec2ce670e, 0xdcbddb354783291b,
+    0x75976367bfb0e2aa, 0x945d084fd34672f0, 0x9d4156415de46f55, 0xb60ff72ab421c4fa,
+    0x282f09b747bbaba2, 0xe8718967337a5096, 0x9ea77ea476f68ae8, 0xcf8689994d3768e9,
+    0xdd4907194508985a, 0x48d16fbfbdd5d0fb, 0xae4a4db503de61f8, 0xc77b7bba5994f892,
+    0x163274dab5edfb6a, 0xa7cd51af7fe62c27, 0x5318ef8b16a2a683, 0xebd0488b419978a4,
+    0x6c56bcd96087c1d2, 0xf9222ceaeaaa975f, 0x449d2e4ad6e40fc4, 0xd291f9ab60bbd88b,
+    0x9efa52352c887b90, 0xe7c4803209a737ae, 0x98604171272d209b, 0xc955e744362ef6b5,
+    0x7daccd3e0f81b959, 0xf9c16fe21971ad0c, 0xd55388509aa18a38, 0xcc3726f40dc2c28d,
+    0xdec581ce6ca460d4, 0x51676fd932ff3fb7, 0x1947308cf2e1b136, 0x956ec0d773bd7acc,
+    0x1b00902832348a17, 0x9a688fe1c0a86393, 0x097b103bd4686a69, 0xc27af7c27f77166f,
+    0x066888c944a92ecb, 0x9b09aab6258aa812, 0xa55414f7fb50c31e, 0x254008983332655e,
+    0xf98c40f3ae3bf407, 0x34e04482081079c0, 0xd596cb3a46d69fa2, 0x59b83f8e8c5820a8,
+    0xc6ab34bcd3ffff7b, 0x8964dd4bf5c00792, 0xa40b238fe6d117a3, 0xf7429a1d92e2a228,
+    0x2910ba4b04c03faf, 0x34d926535897936b, 0x69b24ca6b12f26d6, 0x921014c99c2b0833,
+};
+
+uint64_t aws_checksums_crc64nvme_unshift_sw(uint64_t crc, uint64_t len) {
+    static const uint64_t crc64_poly = 0x9A6C9329AC4BC9B5;
+
+    for (int k = 0; len; k++, len >>= 1) {
+        if (len & 1) {
+            crc = s_crc64nvme_multiply_mod_p(crc64_poly, s_crc64nvme_unshift_factors[k], crc);
+        }
+    }
+    return crc;
+}
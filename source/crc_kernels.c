@@ -0,0 +1,356 @@
+/**
+ * Copyright Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0.
+ */
+
+#include <aws/checksums/private/crc_kernels_priv.h>
+#include <aws/checksums/private/crc_util.h>
+
+#include <aws/common/clock.h>
+#include <aws/common/math.h>
+
+static const char *s_algorithm_names[AWS_CHECKSUMS_CRC_ALGORITHM_COUNT] = {
+    [AWS_CHECKSUMS_CRC_ALGORITHM_CRC32] = "crc32",
+    [AWS_CHECKSUMS_CRC_ALGORITHM_CRC32C] = "crc32c",
+    [AWS_CHECKSUMS_CRC_ALGORITHM_CRC64NVME] = "crc64nvme",
+};
+
+const struct aws_checksums_crc_kernel *aws_checksums_crc_kernels(
+    enum aws_checksums_crc_algorithm algorithm,
+    size_t *count) {
+    AWS_FATAL_ASSERT(algorithm < AWS_CHECKSUMS_CRC_ALGORITHM_COUNT);
+
+    if (algorithm == AWS_CHECKSUMS_CRC_ALGORITHM_CRC64NVME) {
+        return aws_checksums_crc64_kernels(count);
+    }
+    return aws_checksums_crc32_kernels(algorithm, count);
+}
+
+const struct aws_checksums_crc_kernel *aws_checksums_crc_active_kernel(
+    enum aws_checksums_crc_algorithm algorithm,
+    size_t size_class) {
+    AWS_FATAL_ASSERT(algorithm < AWS_CHECKSUMS_CRC_ALGORITHM_COUNT);
+
+    if (algorithm == AWS_CHECKSUMS_CRC_ALGORITHM_CRC64NVME) {
+        return aws_checksums_crc64_active_kernel(size_class);
+    }
+    return aws_checksums_crc32_active_kernel(algorithm, size_class);
+}
+
+void aws_checksums_crc_install_kernel(
+    enum aws_checksums_crc_algorithm algorithm,
+    size_t size_class,
+    const struct aws_checksums_crc_kernel *kernel) {
+    AWS_FATAL_ASSERT(algorithm < AWS_CHECKSUMS_CRC_ALGORITHM_COUNT);
+
+    if (algorithm == AWS_CHECKSUMS_CRC_ALGORITHM_CRC64NVME) {
+        aws_checksums_crc64_install_kernel(size_class, kernel);
+    } else {
+        aws_checksums_crc32_install_kernel(algorithm, size_class, kernel);
+    }
+}
+
+const char *aws_checksums_crc_algorithm_name(enum aws_checksums_crc_algorithm algorithm) {
+    AWS_FATAL_PRECONDITION(algorithm < AWS_CHECKSUMS_CRC_ALGORITHM_COUNT);
+    return s_algorithm_names[algorithm];
+}
+
+size_t aws_checksums_crc_kernel_count(enum aws_checksums_crc_algorithm algorithm) {
+    AWS_FATAL_PRECONDITION(algorithm < AWS_CHECKSUMS_CRC_ALGORITHM_COUNT);
+
+    size_t count = 0;
+    aws_checksums_crc_kernels(algorithm, &count);
+    return count;
+}
+
+int aws_checksums_crc_kernel_get_info(
+    enum aws_checksums_crc_algorithm algorithm,
+    size_t index,
+    struct aws_checksums_crc_kernel_info *out_info) {
+    AWS_FATAL_PRECONDITION(algorithm < AWS_CHECKSUMS_CRC_ALGORITHM_COUNT);
+    AWS_PRECONDITION(out_info);
+
+    size_t count = 0;
+    const struct aws_checksums_crc_kernel *kernels = aws_checksums_crc_kernels(algorithm, &count);
+    if (index >= count) {
+        return aws_raise_error(AWS_ERROR_INVALID_INDEX);
+    }
+
+    out_info->name = kernels[index].name;
+    out_info->required_features = kernels[index].required_features;
+    out_info->supported = kernels[index].is_supported();
+    out_info->crc32_fn = kernels[index].crc32_fn;
+    out_info->crc64_fn = kernels[index].crc64_fn;
+    return AWS_OP_SUCCESS;
+}
+
+const char *aws_checksums_crc_active_kernel_name(enum aws_checksums_crc_algorithm algorithm, size_t input_length) {
+    AWS_FATAL_PRECONDITION(algorithm < AWS_CHECKSUMS_CRC_ALGORITHM_COUNT);
+
+    /* inputs over INT_MAX are processed in INT_MAX sized calls (see crc.h _ex functions) */
+    int length = input_length > INT_MAX ? INT_MAX : (int)input_length;
+    return aws_checksums_crc_active_kernel(algorithm, aws_checksums_size_class(length))->name;
+}
+
+static const struct aws_checksums_crc_kernel *s_find_supported_kernel(
+    enum aws_checksums_crc_algorithm algorithm,
+    struct aws_byte_cursor name) {
+    size_t count = 0;
+    const struct aws_checksums_crc_kernel *kernels = aws_checksums_crc_kernels(algorithm, &count);
+    for (size_t i = 0; i < count; ++i) {
+        if (aws_byte_cursor_eq_c_str(&name, kernels[i].name)) {
+            return kernels[i].is_supported() ? &kernels[i] : NULL;
+        }
+    }
+    return NULL;
+}
+
+int aws_checksums_crc_pin_kernel(enum aws_checksums_crc_algorithm algorithm, const char *kernel_name) {
+    AWS_FATAL_PRECONDITION(algorithm < AWS_CHECKSUMS_CRC_ALGORITHM_COUNT);
+    AWS_PRECONDITION(kernel_name);
+
+#if defined(AWS_CHECKSUMS_STATIC_DISPATCH)
+    (void)kernel_name;
+    return aws_raise_error(AWS_ERROR_UNSUPPORTED_OPERATION);
+#else
+    const struct aws_checksums_crc_kernel *kernel =
+        s_find_supported_kernel(algorithm, aws_byte_cursor_from_c_str(kernel_name));
+    if (kernel == NULL) {
+        return aws_raise_error(AWS_ERROR_INVALID_ARGUMENT);
+    }
+
+    for (size_t size_class = 0; size_class < AWS_CHECKSUMS_SIZE_CLASS_COUNT; ++size_class) {
+        aws_checksums_crc_install_kernel(algorithm, size_class, kernel);
+    }
+    return AWS_OP_SUCCESS;
+#endif
+}
+
+void aws_checksums_crc_unpin_kernel(enum aws_checksums_crc_algorithm algorithm) {
+    AWS_FATAL_PRECONDITION(algorithm < AWS_CHECKSUMS_CRC_ALGORITHM_COUNT);
+
+    if (algorithm == AWS_CHECKSUMS_CRC_ALGORITHM_CRC64NVME) {
+        aws_checksums_crc64_install_default_kernels();
+    } else {
+        aws_checksums_crc32_install_default_kernels(algorithm);
+    }
+}
+
+static size_t s_find_algorithm(struct aws_byte_cursor name) {
+    size_t algorithm = 0;
+    while (algorithm < AWS_CHECKSUMS_CRC_ALGORITHM_COUNT &&
+           !aws_byte_cursor_eq_c_str(&name, s_algorithm_names[algorithm])) {
+        ++algorithm;
+    }
+    return algorithm;
+}
+
+void aws_checksums_crc_pin_kernels_from_string(struct aws_byte_cursor pins) {
+    struct aws_byte_cursor pair;
+    AWS_ZERO_STRUCT(pair);
+    while (aws_byte_cursor_next_split(&pins, ';', &pair)) {
+        struct aws_byte_cursor trimmed = aws_byte_cursor_trim_pred(&pair, aws_char_is_space);
+
+        struct aws_byte_cursor algorithm_name;
+        AWS_ZERO_STRUCT(algorithm_name);
+        if (!aws_byte_cursor_next_split(&trimmed, '=', &algorithm_name) || trimmed.len <= algorithm_name.len) {
+            continue;
+        }
+
+        size_t algorithm = s_find_algorithm(algorithm_name);
+        if (algorithm == AWS_CHECKSUMS_CRC_ALGORITHM_COUNT) {
+            continue;
+        }
+
+        struct aws_byte_cursor kernel_name = trimmed;
+        aws_byte_cursor_advance(&kernel_name, algorithm_name.len + 1);
+        const struct aws_checksums_crc_kernel *kernel = s_find_supported_kernel(algorithm, kernel_name);
+        if (kernel == NULL) {
+            continue;
+        }
+
+        for (size_t size_class = 0; size_class < AWS_CHECKSUMS_SIZE_CLASS_COUNT; ++size_class) {
+            aws_checksums_crc_install_kernel(algorithm, size_class, kernel);
+        }
+    }
+}
+
+#if !defined(AWS_CHECKSUMS_STATIC_DISPATCH)
+/* Length each size class is benchmarked at. Roughly the middle of the class on a log scale. */
+static const int s_calibration_lengths[AWS_CHECKSUMS_SIZE_CLASS_COUNT] = {
+    [AWS_CHECKSUMS_SIZE_CLASS_TINY] = 32,
+    [AWS_CHECKSUMS_SIZE_CLASS_SMALL] = 512,
+    [AWS_CHECKSUMS_SIZE_CLASS_MEDIUM] = 16 * 1024,
+    [AWS_CHECKSUMS_SIZE_CLASS_LARGE] = 256 * 1024,
+};
+
+/* Each trial runs the kernel over at least this many bytes, best of CALIBRATION_TRIALS is kept. */
+#define CALIBRATION_TRIAL_BYTES (64 * 1024)
+#define CALIBRATION_TRIALS 4
+/* A challenger has to beat the default kernel by this many percent to replace it. */
+#define CALIBRATION_MIN_GAIN_PERCENT 5
+
+/* results are stored here so the compiler can not drop the benchmarked calls */
+static volatile uint64_t s_calibration_sink;
+
+static uint64_t s_time_kernel(const struct aws_checksums_crc_kernel *kernel, const uint8_t *buffer, int length) {
+    int reps = CALIBRATION_TRIAL_BYTES / length;
+    if (reps < 1) {
+        reps = 1;
+    }
+
+    uint64_t crc = 0;
+    uint64_t best = UINT64_MAX;
+    for (int trial = 0; trial < CALIBRATION_TRIALS; ++trial) {
+        uint64_t start = 0;
+        uint64_t end = 0;
+        aws_high_res_clock_get_ticks(&start);
+        if (kernel->crc32_fn != NULL) {
+            for (int i = 0; i < reps; ++i) {
+                crc = kernel->crc32_fn(buffer, length, (uint32_t)crc);
+            }
+        } else {
+            for (int i = 0; i < reps; ++i) {
+                crc = kernel->crc64_fn(buffer, length, crc);
+            }
+        }
+        aws_high_res_clock_get_ticks(&end);
+        best = aws_min_u64(best, end - start);
+    }
+
+    s_calibration_sink = crc;
+    return best;
+}
+#endif
+
+int aws_checksums_crc_calibrate(struct aws_allocator *allocator) {
+#if defined(AWS_CHECKSUMS_STATIC_DISPATCH)
+    /* the entry points never read the kernels calibration would install */
+    (void)allocator;
+    return aws_raise_error(AWS_ERROR_UNSUPPORTED_OPERATION);
+#else
+    const int buffer_len = s_calibration_lengths[AWS_CHECKSUMS_SIZE_CLASS_LARGE];
+    uint8_t *buffer = aws_mem_acquire(allocator, (size_t)buffer_len);
+    for (int i = 0; i < buffer_len; ++i) {
+        buffer[i] = (uint8_t)(i * 131 + 7);
+    }
+
+    for (size_t algorithm = 0; algorithm < AWS_CHECKSUMS_CRC_ALGORITHM_COUNT; ++algorithm) {
+        size_t count = 0;
+        const struct aws_checksums_crc_kernel *kernels = aws_checksums_crc_kernels(algorithm, &count);
+
+        for (size_t size_class = 0; size_class < AWS_CHECKSUMS_SIZE_CLASS_COUNT; ++size_class) {
+            const int length = s_calibration_lengths[size_class];
+            const struct aws_checksums_crc_kernel *best = aws_checksums_crc_active_kernel(algorithm, size_class);
+            uint64_t best_time = s_time_kernel(best, buffer, length);
+
+            for (size_t i = 0; i < count; ++i) {
+                const struct aws_checksums_crc_kernel *challenger = &kernels[i];
+                if (challenger == best || !challenger->is_supported()) {
+                    continue;
+                }
+
+                uint64_t time = s_time_kernel(challenger, buffer, length);
+                if (time * 100 < best_time * (100 - CALIBRATION_MIN_GAIN_PERCENT)) {
+                    best = challenger;
+                    best_time = time;
+                }
+            }
+
+            aws_checksums_crc_install_kernel(algorithm, size_class, best);
+        }
+    }
+
+    aws_mem_release(allocator, buffer);
+    return AWS_OP_SUCCESS;
+#endif
+}
+
+int aws_checksums_crc_calibration_save(struct aws_byte_buf *out) {
+    for (size_t algorithm = 0; algorithm < AWS_CHECKSUMS_CRC_ALGORITHM_COUNT; ++algorithm) {
+        if (algorithm > 0 && aws_byte_buf_append_byte_dynamic(out, ';')) {
+            return AWS_OP_ERR;
+        }
+
+        struct aws_byte_cursor name = aws_byte_cursor_from_c_str(s_algorithm_names[algorithm]);
+        if (aws_byte_buf_append_dynamic(out, &name) || aws_byte_buf_append_byte_dynamic(out, '=')) {
+            return AWS_OP_ERR;
+        }
+
+        for (size_t size_class = 0; size_class < AWS_CHECKSUMS_SIZE_CLASS_COUNT; ++size_class) {
+            if (size_class > 0 && aws_byte_buf_append_byte_dynamic(out, ',')) {
+                return AWS_OP_ERR;
+            }
+
+            struct aws_byte_cursor kernel =
+                aws_byte_cursor_from_c_str(aws_checksums_crc_active_kernel(algorithm, size_class)->name);
+            if (aws_byte_buf_append_dynamic(out, &kernel)) {
+                return AWS_OP_ERR;
+            }
+        }
+    }
+
+    return AWS_OP_SUCCESS;
+}
+
+int aws_checksums_crc_calibration_load(struct aws_byte_cursor serialized) {
+#if defined(AWS_CHECKSUMS_STATIC_DISPATCH)
+    (void)serialized;
+    return aws_raise_error(AWS_ERROR_UNSUPPORTED_OPERATION);
+#else
+    const struct aws_checksums_crc_kernel *choices[AWS_CHECKSUMS_CRC_ALGORITHM_COUNT][AWS_CHECKSUMS_SIZE_CLASS_COUNT];
+    AWS_ZERO_ARRAY(choices);
+
+    /* parse and validate everything first, so a bad input does not leave a partially applied result behind */
+    struct aws_byte_cursor entry;
+    AWS_ZERO_STRUCT(entry);
+    while (aws_byte_cursor_next_split(&serialized, ';', &entry)) {
+        struct aws_byte_cursor algorithm_name;
+        AWS_ZERO_STRUCT(algorithm_name);
+        if (!aws_byte_cursor_next_split(&entry, '=', &algorithm_name)) {
+            return aws_raise_error(AWS_ERROR_INVALID_ARGUMENT);
+        }
+
+        size_t algorithm = s_find_algorithm(algorithm_name);
+        if (algorithm == AWS_CHECKSUMS_CRC_ALGORITHM_COUNT || entry.len <= algorithm_name.len) {
+            return aws_raise_error(AWS_ERROR_INVALID_ARGUMENT);
+        }
+
+        struct aws_byte_cursor kernel_names = entry;
+        aws_byte_cursor_advance(&kernel_names, algorithm_name.len + 1);
+
+        struct aws_byte_cursor kernel_name;
+        AWS_ZERO_STRUCT(kernel_name);
+        size_t size_class = 0;
+        while (aws_byte_cursor_next_split(&kernel_names, ',', &kernel_name)) {
+            if (size_class == AWS_CHECKSUMS_SIZE_CLASS_COUNT) {
+                return aws_raise_error(AWS_ERROR_INVALID_ARGUMENT);
+            }
+
+            choices[algorithm][size_class] = s_find_supported_kernel(algorithm, kernel_name);
+            if (choices[algorithm][size_class] == NULL) {
+                return aws_raise_error(AWS_ERROR_INVALID_ARGUMENT);
+            }
+            ++size_class;
+        }
+
+        if (size_class != AWS_CHECKSUMS_SIZE_CLASS_COUNT) {
+            return aws_raise_error(AWS_ERROR_INVALID_ARGUMENT);
+        }
+    }
+
+    for (size_t algorithm = 0; algorithm < AWS_CHECKSUMS_CRC_ALGORITHM_COUNT; ++algorithm) {
+        if (choices[algorithm][0] == NULL) {
+            return aws_raise_error(AWS_ERROR_INVALID_ARGUMENT);
+        }
+    }
+
+    for (size_t algorithm = 0; algorithm < AWS_CHECKSUMS_CRC_ALGORITHM_COUNT; ++algorithm) {
+        for (size_t size_class = 0; size_class < AWS_CHECKSUMS_SIZE_CLASS_COUNT; ++size_class) {
+            aws_checksums_crc_install_kernel(algorithm, size_class, choices[algorithm][size_class]);
+        }
+    }
+
+    return AWS_OP_SUCCESS;
+#endif
+}
@@ -1291,6 +1291,19 @@ uint32_t aws_checksums_crc32c_sw(const uint8_t *input, int length, uint32_t prev
     return s_crc32c_no_slice(input, length, previousCrc32c);
 }
 
+/* a * b modulo the bit-reflected poly, bit 31 holds the x^0 coefficient. */
+static uint32_t s_crc32_multiply_mod_p(uint32_t poly, uint32_t a, uint32_t b) {
+    uint32_t product = 0;
+    for (int i = 0; i < 32; i++) {
+        if (a & ((uint32_t)1 << 31)) {
+            product ^= b;
+        }
+        a <<= 1;
+        b = (b >> 1) ^ ((b & 1) ? poly : 0);
+    }
+    return product;
+}
+
 #if defined(__SIZEOF_INT128__)
 static inline uint32_t s_combine_crc32_sw(
     const aws_checksums_crc32_constants_t cc[1],
@@ -1324,9 +1337,15 @@ uint32_t aws_checksums_crc32c_combine_sw(uint32_t crc1, uint32_t crc2, uint64_t
 }
 #else
 
-static uint32_t s_crc32_shift_one_zero(uint32_t poly, uint32_t crc) {
-    for (int i = 0; i < 8; i++) {
-        crc = (crc >> 1) ^ ((crc & 1) ? poly : 0);
+/* crc * x^(8 * len2) by square and multiply, so combining takes O(log(len2)) without 128 bit multiplies. */
+static uint32_t s_crc32_shift(uint32_t poly, uint32_t crc, uint64_t len2) {
+    uint32_t power = (uint32_t)1 << (31 - 8); /* x^8, one zero byte */
+    while (len2) {
+        if (len2 & 1) {
+            crc = s_crc32_multiply_mod_p(poly, power, crc);
+        }
+        power = s_crc32_multiply_mod_p(poly, power, power);
+        len2 >>= 1;
     }
     return crc;
 }
@@ -1338,10 +1357,7 @@ uint32_t aws_checksums_crc32_combine_sw(uint32_t crc1, uint32_t crc2, uint64_t l
 
     static const uint32_t crc32_poly = 0xEDB88320UL;
 
-    for (size_t i = 0; i < len2; i++) {
-        crc1 = s_crc32_shift_one_zero(crc32_poly, crc1);
-    }
-    return crc1 ^ crc2;
+    return s_crc32_shift(crc32_poly, crc1, len2) ^ crc2;
 }
 
 uint32_t aws_checksums_crc32c_combine_sw(uint32_t crc1, uint32_t crc2, uint64_t len2) {
@@ -1351,10 +1367,50 @@ uint32_t aws_checksums_crc32c_combine_sw(uint32_t crc1, uint32_t crc2, uint64_t
 
     static const uint32_t crc32_poly = 0x82F63B78;
 
-    for (size_t i = 0; i < len2; i++) {
-        crc1 = s_crc32_shift_one_zero(crc32_poly, crc1);
-    }
-    return crc1 ^ crc2;
+    return s_crc32_shift(crc32_poly, crc1, len2) ^ crc2;
 }
 
 #endif
+
+/*
+ * x^(-8 * 2^k) modulo the bit-reflected polynomials, for k = 0..63. x is invertible because both polynomials have a
+ * constant term, so multiplying by these undoes the x^(8 * len) shift combine() applies to crc1.
+ */
+static const uint32_t s_crc32_unshift_factors[64] = {
+    0x6567CB95, 0xD7125358, 0x5B358FD3, 0x2E9BB40B, 0x12A59A49, 0x8DF9403D, 0x5139DE12, 0xBA340226,
+    0x29C45641, 0x12FBC105, 0xECD30C55, 0x3755EBD8, 0x24EE460C, 0x23783FCF, 0x479933FC, 0xA39442A5,
+    0x9EA0056D, 0xF42608F6, 0x20CACF04, 0x2A0CF83D, 0xEFFD8645, 0x2A39A67D, 0x640EBD82, 0x9DFD8792,
+    0x277402AB, 0xAD31BC4F, 0x31536354, 0x5EA35FCA, 0x52B55E39, 0xDB710641, 0x6D930AC3, 0x6D3D2D4D,
+    0x6567CB95, 0xD7125358, 0x5B358FD3, 0x2E9BB40B, 0x12A59A49, 0x8DF9403D, 0x5139DE12, 0xBA340226,
+    0x29C45641, 0x12FBC105, 0xECD30C55, 0x3755EBD8, 0x24EE460C, 0x23783FCF, 0x479933FC, 0xA39442A5,
+    0x9EA0056D, 0xF42608F6, 0x20CACF04, 0x2A0CF83D, 0xEFFD8645, 0x2A39A67D, 0x640EBD82, 0x9DFD8792,
+    0x277402AB, 0xAD31BC4F, 0x31536354, 0x5EA35FCA, 0x52B55E39, 0xDB710641, 0x6D930AC3, 0x6D3D2D4D,
+};
+
+static const uint32_t s_crc32c_unshift_factors[64] = {
+    0xFDE39562, 0xBEF0965E, 0xD610D67E, 0xE67CCE65, 0xA268B79E, 0x134FB088, 0x32998D96, 0xCEDAC2CC,
+    0x70118575, 0x0E004A40, 0xA7864C8B, 0xBC7BE916, 0x10BA2894, 0x6077197B, 0x98448E4E, 0x8BAF845D,
+    0xE93E07FC, 0xF58027D7, 0x5E2B422D, 0x9DB2851C, 0x9270ED25, 0x5984E7B3, 0x7AF026F1, 0xE0F4116B,
+    0xACE8A6B0, 0x9E09F006, 0x6A60EA71, 0x4FD04875, 0x05EC76F1, 0x0BD8EDE2, 0x2F63B788, 0xFDE39562,
+    0xBEF0965E, 0xD610D67E, 0xE67CCE65, 0xA268B79E, 0x134FB088, 0x32998D96, 0xCEDAC2CC, 0x70118575,
+    0x0E004A40, 0xA7864C8B, 0xBC7BE916, 0x10BA2894, 0x6077197B, 0x98448E4E, 0x8BAF845D, 0xE93E07FC,
+    0xF58027D7, 0x5E2B422D, 0x9DB2851C, 0x9270ED25, 0x5984E7B3, 0x7AF026F1, 0xE0F4116B, 0xACE8A6B0,
+    0x9E09F006, 0x6A60EA71, 0x4FD04875, 0x05EC76F1, 0x0BD8EDE2, 0x2F63B788, 0xFDE39562, 0xBEF0965E,
+};
+
+static uint32_t s_crc32_unshift(uint32_t poly, const uint32_t factors[64], uint32_t crc, uint64_t len) {
+    for (int k = 0; len; k++, len >>= 1) {
+        if (len & 1) {
+            crc = s_crc32_multiply_mod_p(poly, factors[k], crc);
+        }
+    }
+    return crc;
+}
+
+uint32_t aws_checksums_crc32_unshift_sw(uint32_t crc, uint64_t len) {
+    return s_crc32_unshift(CRC32_POLYNOMIAL, s_crc32_unshift_factors, crc, len);
+}
+
+uint32_t aws_checksums_crc32c_unshift_sw(uint32_t crc, uint64_t len) {
+    return s_crc32_unshift(CRC32C_POLYNOMIAL, s_crc32c_unshift_factors, crc, len);
+}
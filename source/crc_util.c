@@ -5,6 +5,53 @@
 #include <aws/checksums/private/crc_util.h>
 #include <stddef.h>
 
+#if defined(AWS_USE_CPU_EXTENSIONS) && defined(AWS_ARCH_INTEL_X64)
+/* sse2 is part of the x86-64 baseline, so this needs no feature check or special compiler flags */
+#    include <emmintrin.h>
+
+void aws_checksums_copy_nt(uint8_t *dst, const uint8_t *src, size_t len) {
+    /* streaming stores need 16 byte aligned destinations */
+    size_t head = (size_t)(-(uintptr_t)dst & 15);
+    if (head >= len) {
+        memcpy(dst, src, len);
+        return;
+    }
+    memcpy(dst, src, head);
+    dst += head;
+    src += head;
+    len -= head;
+
+    while (len >= 64) {
+        __m128i x0 = _mm_loadu_si128((const __m128i *)(const void *)(src + 0));
+        __m128i x1 = _mm_loadu_si128((const __m128i *)(const void *)(src + 16));
+        __m128i x2 = _mm_loadu_si128((const __m128i *)(const void *)(src + 32));
+        __m128i x3 = _mm_loadu_si128((const __m128i *)(const void *)(src + 48));
+        _mm_stream_si128((__m128i *)(void *)(dst + 0), x0);
+        _mm_stream_si128((__m128i *)(void *)(dst + 16), x1);
+        _mm_stream_si128((__m128i *)(void *)(dst + 32), x2);
+        _mm_stream_si128((__m128i *)(void *)(dst + 48), x3);
+        dst += 64;
+        src += 64;
+        len -= 64;
+    }
+
+    while (len >= 16) {
+        _mm_stream_si128((__m128i *)(void *)dst, _mm_loadu_si128((const __m128i *)(const void *)src));
+        dst += 16;
+        src += 16;
+        len -= 16;
+    }
+
+    memcpy(dst, src, len);
+    /* streaming stores are weakly ordered, make them visible before anything the caller writes next */
+    _mm_sfence();
+}
+#else
+void aws_checksums_copy_nt(uint8_t *dst, const uint8_t *src, size_t len) {
+    memcpy(dst, src, len);
+}
+#endif
+
 #if defined(__SIZEOF_INT128__)
 static inline int s_msb_128(const __uint128_t x) {
     // __builtin_clzll returns the number of leading zeros (from MSB end) - undefined for x==0 !!!
@@ -0,0 +1,219 @@
+/**
+ * Copyright Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0.
+ */
+
+#include <aws/checksums/crc.h>
+#include <aws/checksums/file_checksum.h>
+#include <aws/checksums/private/file_map_priv.h>
+
+#include <aws/common/file.h>
+#include <aws/common/math.h>
+
+/*
+ * Single threaded windows are checksummed in steps of this size, asking for the next step to be read while the
+ * current one is checksummed so the cpu doesn't wait for page faults.
+ */
+#define READAHEAD_STEP (4 * 1024 * 1024)
+
+typedef uint64_t(file_checksum_fn)(const uint8_t *input, size_t length, uint64_t previous);
+typedef int(file_parallel_checksum_fn)(
+    struct aws_allocator *allocator,
+    const uint8_t *input,
+    size_t length,
+    uint64_t previous,
+    const struct aws_checksums_parallel_options *options,
+    uint64_t *out_checksum);
+
+static uint64_t s_checksum_window(
+    file_checksum_fn *checksum_fn,
+    const uint8_t *data,
+    size_t length,
+    uint64_t previous) {
+
+    aws_checksums_file_prefetch(data, aws_min_size(length, READAHEAD_STEP));
+
+    uint64_t checksum = previous;
+    while (length > 0) {
+        size_t step = aws_min_size(length, READAHEAD_STEP);
+        if (length > step) {
+            aws_checksums_file_prefetch(data + step, aws_min_size(length - step, READAHEAD_STEP));
+        }
+        checksum = checksum_fn(data, step, checksum);
+        data += step;
+        length -= step;
+    }
+    return checksum;
+}
+
+static int s_checksum_file(
+    struct aws_allocator *allocator,
+    const char *path,
+    uint64_t offset,
+    uint64_t length,
+    const struct aws_checksums_file_options *options,
+    file_checksum_fn *checksum_fn,
+    file_parallel_checksum_fn *parallel_fn,
+    uint64_t *out_checksum) {
+
+    if (path == NULL || out_checksum == NULL) {
+        return aws_raise_error(AWS_ERROR_INVALID_ARGUMENT);
+    }
+
+    FILE *file = aws_fopen(path, "rb");
+    if (file == NULL) {
+        return AWS_OP_ERR;
+    }
+
+    int result = AWS_OP_ERR;
+    int64_t file_length = 0;
+    if (aws_file_get_length(file, &file_length)) {
+        goto done;
+    }
+
+    if (offset > (uint64_t)file_length) {
+        aws_raise_error(AWS_ERROR_INVALID_ARGUMENT);
+        goto done;
+    }
+    uint64_t available = (uint64_t)file_length - offset;
+    if (length == AWS_CHECKSUMS_FILE_TO_END) {
+        length = available;
+    } else if (length > available) {
+        aws_raise_error(AWS_ERROR_INVALID_ARGUMENT);
+        goto done;
+    }
+
+    size_t window_size = options != NULL && options->window_size != 0 ? options->window_size
+                                                                      : AWS_CHECKSUMS_FILE_DEFAULT_WINDOW_SIZE;
+    const struct aws_checksums_parallel_options *parallel = options != NULL ? options->parallel : NULL;
+
+    uint64_t checksum = 0;
+    while (length > 0) {
+        size_t window_length = (size_t)aws_min_u64(length, window_size);
+
+        struct aws_checksums_file_mapping mapping;
+        if (aws_checksums_file_map(file, offset, window_length, &mapping)) {
+            goto done;
+        }
+
+        int window_result = AWS_OP_SUCCESS;
+        if (parallel != NULL) {
+            window_result = parallel_fn(allocator, mapping.data, window_length, checksum, parallel, &checksum);
+        } else {
+            checksum = s_checksum_window(checksum_fn, mapping.data, window_length, checksum);
+        }
+        aws_checksums_file_unmap(&mapping);
+        if (window_result) {
+            goto done;
+        }
+
+        offset += window_length;
+        length -= window_length;
+    }
+
+    *out_checksum = checksum;
+    result = AWS_OP_SUCCESS;
+
+done:
+    fclose(file);
+    return result;
+}
+
+static uint64_t s_crc32(const uint8_t *input, size_t length, uint64_t previous) {
+    return aws_checksums_crc32_ex(input, length, (uint32_t)previous);
+}
+
+static int s_crc32_parallel(
+    struct aws_allocator *allocator,
+    const uint8_t *input,
+    size_t length,
+    uint64_t previous,
+    const struct aws_checksums_parallel_options *options,
+    uint64_t *out_checksum) {
+
+    uint32_t crc = 0;
+    if (aws_checksums_crc32_parallel(allocator, input, length, (uint32_t)previous, options, &crc)) {
+        return AWS_OP_ERR;
+    }
+    *out_checksum = crc;
+    return AWS_OP_SUCCESS;
+}
+
+static uint64_t s_crc32c(const uint8_t *input, size_t length, uint64_t previous) {
+    return aws_checksums_crc32c_ex(input, length, (uint32_t)previous);
+}
+
+static int s_crc32c_parallel(
+    struct aws_allocator *allocator,
+    const uint8_t *input,
+    size_t length,
+    uint64_t previous,
+    const struct aws_checksums_parallel_options *options,
+    uint64_t *out_checksum) {
+
+    uint32_t crc = 0;
+    if (aws_checksums_crc32c_parallel(allocator, input, length, (uint32_t)previous, options, &crc)) {
+        return AWS_OP_ERR;
+    }
+    *out_checksum = crc;
+    return AWS_OP_SUCCESS;
+}
+
+int aws_checksums_file_crc32(
+    struct aws_allocator *allocator,
+    const char *path,
+    uint64_t offset,
+    uint64_t length,
+    const struct aws_checksums_file_options *options,
+    uint32_t *out_crc32) {
+
+    if (out_crc32 == NULL) {
+        return aws_raise_error(AWS_ERROR_INVALID_ARGUMENT);
+    }
+
+    uint64_t crc = 0;
+    if (s_checksum_file(allocator, path, offset, length, options, s_crc32, s_crc32_parallel, &crc)) {
+        return AWS_OP_ERR;
+    }
+    *out_crc32 = (uint32_t)crc;
+    return AWS_OP_SUCCESS;
+}
+
+int aws_checksums_file_crc32c(
+    struct aws_allocator *allocator,
+    const char *path,
+    uint64_t offset,
+    uint64_t length,
+    const struct aws_checksums_file_options *options,
+    uint32_t *out_crc32c) {
+
+    if (out_crc32c == NULL) {
+        return aws_raise_error(AWS_ERROR_INVALID_ARGUMENT);
+    }
+
+    uint64_t crc = 0;
+    if (s_checksum_file(allocator, path, offset, length, options, s_crc32c, s_crc32c_parallel, &crc)) {
+        return AWS_OP_ERR;
+    }
+    *out_crc32c = (uint32_t)crc;
+    return AWS_OP_SUCCESS;
+}
+
+int aws_checksums_file_crc64nvme(
+    struct aws_allocator *allocator,
+    const char *path,
+    uint64_t offset,
+    uint64_t length,
+    const struct aws_checksums_file_options *options,
+    uint64_t *out_crc64) {
+
+    return s_checksum_file(
+        allocator,
+        path,
+        offset,
+        length,
+        options,
+        aws_checksums_crc64nvme_ex,
+        aws_checksums_crc64nvme_parallel,
+        out_crc64);
+}
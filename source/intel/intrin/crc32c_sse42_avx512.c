@@ -12,6 +12,7 @@
 #include <emmintrin.h>
 #include <immintrin.h>
 #include <smmintrin.h>
+#include <string.h>
 
 #if defined(AWS_HAVE_AVX512_INTRINSICS) && defined(AWS_ARCH_INTEL_X64)
 
@@ -154,17 +155,101 @@ static uint32_t s_checksums_crc32c_avx512_impl(const uint8_t *input, int length,
 }
 #endif /* #if defined(AWS_HAVE_AVX512_INTRINSICS) && (INTPTR_MAX == INT64_MAX) */
 
+/*
+ * Computes the crc32c of the input using only the sse4.2 crc32 instruction. The crc is neither inverted on entry nor on
+ * exit, that is left to the entry points.
+ */
+static inline uint32_t s_crc32c_sse42_impl(const uint8_t *input, int length, uint32_t crc) {
+    /* For small input, forget about alignment checks - simply compute the CRC32c one byte at a time */
+    if (length < (int)sizeof(slice_ptr_int_type)) {
+        while (length-- > 0) {
+            crc = (uint32_t)_mm_crc32_u8(crc, *input++);
+        }
+        return crc;
+    }
+
+    /* Get the 8-byte memory alignment of our input buffer by looking at the least significant 3 bits */
+    int input_alignment = (uintptr_t)(input) & 0x7;
+
+    /* Compute the number of unaligned bytes before the first aligned 8-byte chunk (will be in the range 0-7) */
+    int leading = (8 - input_alignment) & 0x7;
+
+    /* reduce the length by the leading unaligned bytes we are about to process */
+    length -= leading;
+
+    /* spin through the leading unaligned input bytes (if any) one-by-one */
+    while (leading-- > 0) {
+        crc = (uint32_t)_mm_crc32_u8(crc, *input++);
+    }
+
+    /* Spin through remaining (aligned) 8-byte chunks using the CRC32Q quad word instruction */
+    while (length >= (int)sizeof(slice_ptr_int_type)) {
+        crc = (uint32_t)crc_intrin_fn(crc, *(slice_ptr_int_type *)(input));
+        input += sizeof(slice_ptr_int_type);
+        length -= (int)sizeof(slice_ptr_int_type);
+    }
+
+    /* Finish up with any trailing bytes using the CRC32B single byte instruction one-by-one */
+    while (length-- > 0) {
+        crc = (uint32_t)_mm_crc32_u8(crc, *input);
+        input++;
+    }
+
+    return crc;
+}
+
+uint32_t aws_checksums_crc32c_intel_sse42(const uint8_t *input, int length, uint32_t previous_crc) {
+    return ~s_crc32c_sse42_impl(input, length, ~previous_crc);
+}
+
+void aws_checksums_crc32c_intel_sse42_x4(const uint8_t *const inputs[4], int length, uint32_t crcs[4]) {
+    /*
+     * crc32 has a latency of 3 cycles but a throughput of one (or more) per cycle, so a single buffer leaves the
+     * unit mostly idle. Four independent chains keep it busy. Inputs are read unaligned, which costs nothing on
+     * cpus with sse4.2, since with four lanes there is no common alignment to reach.
+     */
+    slice_ptr_int_type crc0 = (uint32_t)~crcs[0];
+    slice_ptr_int_type crc1 = (uint32_t)~crcs[1];
+    slice_ptr_int_type crc2 = (uint32_t)~crcs[2];
+    slice_ptr_int_type crc3 = (uint32_t)~crcs[3];
+
+    int offset = 0;
+    for (; offset + (int)sizeof(slice_ptr_int_type) <= length; offset += (int)sizeof(slice_ptr_int_type)) {
+        slice_ptr_int_type word0;
+        slice_ptr_int_type word1;
+        slice_ptr_int_type word2;
+        slice_ptr_int_type word3;
+        memcpy(&word0, inputs[0] + offset, sizeof(word0));
+        memcpy(&word1, inputs[1] + offset, sizeof(word1));
+        memcpy(&word2, inputs[2] + offset, sizeof(word2));
+        memcpy(&word3, inputs[3] + offset, sizeof(word3));
+        crc0 = crc_intrin_fn((uint32_t)crc0, word0);
+        crc1 = crc_intrin_fn((uint32_t)crc1, word1);
+        crc2 = crc_intrin_fn((uint32_t)crc2, word2);
+        crc3 = crc_intrin_fn((uint32_t)crc3, word3);
+    }
+
+    for (; offset < length; ++offset) {
+        crc0 = _mm_crc32_u8((uint32_t)crc0, inputs[0][offset]);
+        crc1 = _mm_crc32_u8((uint32_t)crc1, inputs[1][offset]);
+        crc2 = _mm_crc32_u8((uint32_t)crc2, inputs[2][offset]);
+        crc3 = _mm_crc32_u8((uint32_t)crc3, inputs[3][offset]);
+    }
+
+    crcs[0] = ~(uint32_t)crc0;
+    crcs[1] = ~(uint32_t)crc1;
+    crcs[2] = ~(uint32_t)crc2;
+    crcs[3] = ~(uint32_t)crc3;
+}
+
 uint32_t aws_checksums_crc32c_intel_avx512_with_sse_fallback(const uint8_t *input, int length, uint32_t previous_crc) {
     /* this is the entry point. We should only do the bit flip once. It should not be done for the subfunctions and
      * branches.*/
     uint32_t crc = ~previous_crc;
 
-    /* For small input, forget about alignment checks - simply compute the CRC32c one byte at a time */
+    /* For small input, forget about alignment checks and wide kernels */
     if (length < (int)sizeof(slice_ptr_int_type)) {
-        while (length-- > 0) {
-            crc = (uint32_t)_mm_crc32_u8(crc, *input++);
-        }
-        return ~crc;
+        return ~s_crc32c_sse42_impl(input, length, crc);
     }
 
     /* Get the 8-byte memory alignment of our input buffer by looking at the least significant 3 bits */
@@ -210,18 +295,54 @@ uint32_t aws_checksums_crc32c_intel_avx512_with_sse_fallback(const uint8_t *inpu
     }
 #endif
 
-    /* Spin through remaining (aligned) 8-byte chunks using the CRC32Q quad word instruction */
-    while (length >= (int)sizeof(slice_ptr_int_type)) {
-        crc = (uint32_t)crc_intrin_fn(crc, *(slice_ptr_int_type *)(input));
-        input += sizeof(slice_ptr_int_type);
-        length -= (int)sizeof(slice_ptr_int_type);
+    return ~s_crc32c_sse42_impl(input, length, crc);
+}
+
+#if defined(AWS_HAVE_CLMUL) && defined(AWS_ARCH_INTEL_X64)
+
+/*
+ * Same nibble at a time shift as the int128 software combine in crc_sw.c, with each multiply done by pclmulqdq. The
+ * product of two 32 bit reflected values, read as a 64 bit reflected value, is their product times x. The shift
+ * factors account for that extra x. Its 32 high degree terms are reduced with the reflected Barrett reduction from
+ * "Fast CRC Computation for Generic Polynomials Using PCLMULQDQ Instruction" (see s_checksums_crc32c_avx512_impl).
+ */
+static inline uint32_t s_crc32_combine_clmul(
+    const aws_checksums_crc32_constants_t *cc,
+    uint32_t crc1,
+    uint32_t crc2,
+    uint64_t len2) {
+    if (AWS_UNLIKELY(len2 == 0)) {
+        return crc1;
     }
 
-    /* Finish up with any trailing bytes using the CRC32B single byte instruction one-by-one */
-    while (length-- > 0) {
-        crc = (uint32_t)_mm_crc32_u8(crc, *input);
-        input++;
+    /* mu in the low half, the polynomial in the high half */
+    const __m128i mu_poly = _mm_loadu_si128((const __m128i *)(const void *)cc->mu_poly);
+    const __m128i low_32_bits = _mm_set_epi32(0, 0, 0, -1);
+    __m128i crc = _mm_cvtsi32_si128((int)crc1);
+
+    int idx = 0;
+    while (len2) {
+        uint8_t nibble = len2 & 0xf;
+        if (nibble) {
+            __m128i factor = _mm_cvtsi32_si128((int)(uint32_t)(cc->shift_factors[idx][nibble][1] >> 32));
+            __m128i product = _mm_clmulepi64_si128(crc, factor, 0x00);
+            __m128i t1 = _mm_clmulepi64_si128(_mm_and_si128(product, low_32_bits), mu_poly, 0x00);
+            __m128i t2 = _mm_clmulepi64_si128(_mm_and_si128(t1, low_32_bits), mu_poly, 0x10);
+            crc = _mm_srli_epi64(_mm_xor_si128(product, t2), 32);
+        }
+        idx++;
+        len2 >>= 4;
     }
 
-    return ~crc;
+    return (uint32_t)_mm_cvtsi128_si32(crc) ^ crc2;
 }
+
+uint32_t aws_checksums_crc32_combine_clmul(uint32_t crc1, uint32_t crc2, uint64_t len2) {
+    return s_crc32_combine_clmul(&aws_checksums_crc32_constants, crc1, crc2, len2);
+}
+
+uint32_t aws_checksums_crc32c_combine_clmul(uint32_t crc1, uint32_t crc2, uint64_t len2) {
+    return s_crc32_combine_clmul(&aws_checksums_crc32c_constants, crc1, crc2, len2);
+}
+
+#endif /* defined(AWS_HAVE_CLMUL) && defined(AWS_ARCH_INTEL_X64) */
@@ -144,4 +144,34 @@ uint64_t aws_checksums_crc64nvme_intel_clmul(const uint8_t *input, int length, u
     return ~(uint64_t)_mm_extract_epi64(reduced, 1);
 }
 
+uint64_t aws_checksums_crc64nvme_combine_clmul(uint64_t crc1, uint64_t crc2, uint64_t len2) {
+    if (AWS_UNLIKELY(len2 == 0)) {
+        return crc1;
+    }
+
+    // Load the bit-reflected CRC into the upper half of an xmm register
+    __m128i shifted_crc = _mm_set_epi64x((int64_t)crc1, 0);
+
+    // Shift the CRC by the given length, one 4 bit nibble of the length at a time
+    int nibble_idx = 0;
+    while (len2 > 0) {
+        uint8_t nibble_len = len2 & 0xf;
+        if (nibble_len) {
+            // Multiply both halves with the pair of pre-computed constants for this nibble and fold them together
+            shifted_crc = cmull_xmm_pair(
+                shifted_crc, load_xmm(aws_checksums_crc64nvme_constants.shift_factors[nibble_idx][nibble_len]));
+        }
+        nibble_idx++;
+        len2 >>= 4;
+    }
+
+    // Barrett modular reduction, as at the end of aws_checksums_crc64nvme_intel_clmul()
+    const __m128i mu_poly = load_xmm(aws_checksums_crc64nvme_constants.mu_poly);
+    __m128i mul_by_mu = _mm_clmulepi64_si128(mu_poly, shifted_crc, 0x00);
+    __m128i mul_by_poly = _mm_clmulepi64_si128(mu_poly, mul_by_mu, 0x01);
+    __m128i reduced = _mm_xor_si128(_mm_xor_si128(shifted_crc, _mm_bslli_si128(mul_by_mu, 8)), mul_by_poly);
+
+    return (uint64_t)_mm_extract_epi64(reduced, 1) ^ crc2;
+}
+
 #endif /* defined(AWS_ARCH_INTEL_X64) && defined(AWS_HAVE_CLMUL) && !(defined(_MSC_VER) && _MSC_VER < 1920) */
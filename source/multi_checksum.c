@@ -0,0 +1,152 @@
+/**
+ * Copyright Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0.
+ */
+
+#include <aws/checksums/crc.h>
+#include <aws/checksums/multi_checksum.h>
+#include <aws/checksums/private/crc_util.h>
+#include <aws/checksums/xxhash.h>
+
+#include <aws/common/math.h>
+
+#define ALL_ALGORITHMS                                                                                                 \
+    (AWS_MULTI_CHECKSUM_CRC32 | AWS_MULTI_CHECKSUM_CRC32C | AWS_MULTI_CHECKSUM_CRC64NVME |                            \
+     AWS_MULTI_CHECKSUM_XXHASH64 | AWS_MULTI_CHECKSUM_XXHASH3_64 | AWS_MULTI_CHECKSUM_XXHASH3_128)
+
+/* Same block size as the fused copy, see AWS_CHECKSUMS_COPY_BLOCK_SIZE. */
+#define MULTI_CHECKSUM_BLOCK_SIZE AWS_CHECKSUMS_COPY_BLOCK_SIZE
+
+enum { XXHASH_SLOT_64, XXHASH_SLOT_3_64, XXHASH_SLOT_3_128, XXHASH_SLOT_COUNT };
+
+struct aws_multi_checksum {
+    struct aws_allocator *allocator;
+    uint32_t algorithms;
+    uint32_t crc32;
+    uint32_t crc32c;
+    uint64_t crc64nvme;
+    struct aws_xxhash *xxhashes[XXHASH_SLOT_COUNT];
+};
+
+static const uint32_t s_xxhash_algorithms[XXHASH_SLOT_COUNT] = {
+    [XXHASH_SLOT_64] = AWS_MULTI_CHECKSUM_XXHASH64,
+    [XXHASH_SLOT_3_64] = AWS_MULTI_CHECKSUM_XXHASH3_64,
+    [XXHASH_SLOT_3_128] = AWS_MULTI_CHECKSUM_XXHASH3_128,
+};
+
+void aws_multi_checksum_destroy(struct aws_multi_checksum *checksum) {
+    if (checksum == NULL) {
+        return;
+    }
+
+    for (size_t i = 0; i < XXHASH_SLOT_COUNT; ++i) {
+        aws_xxhash_destroy(checksum->xxhashes[i]);
+    }
+    aws_mem_release(checksum->allocator, checksum);
+}
+
+struct aws_multi_checksum *aws_multi_checksum_new(
+    struct aws_allocator *allocator,
+    uint32_t algorithms,
+    uint64_t xxhash_seed) {
+
+    if (algorithms == 0 || (algorithms & ~(uint32_t)ALL_ALGORITHMS) != 0) {
+        aws_raise_error(AWS_ERROR_INVALID_ARGUMENT);
+        return NULL;
+    }
+
+    struct aws_multi_checksum *checksum = aws_mem_calloc(allocator, 1, sizeof(struct aws_multi_checksum));
+    checksum->allocator = allocator;
+    checksum->algorithms = algorithms;
+
+    if (algorithms & AWS_MULTI_CHECKSUM_XXHASH64) {
+        checksum->xxhashes[XXHASH_SLOT_64] = aws_xxhash64_new(allocator, xxhash_seed);
+    }
+    if (algorithms & AWS_MULTI_CHECKSUM_XXHASH3_64) {
+        checksum->xxhashes[XXHASH_SLOT_3_64] = aws_xxhash3_64_new(allocator, xxhash_seed);
+    }
+    if (algorithms & AWS_MULTI_CHECKSUM_XXHASH3_128) {
+        checksum->xxhashes[XXHASH_SLOT_3_128] = aws_xxhash3_128_new(allocator, xxhash_seed);
+    }
+
+    for (size_t i = 0; i < XXHASH_SLOT_COUNT; ++i) {
+        if ((algorithms & s_xxhash_algorithms[i]) && checksum->xxhashes[i] == NULL) {
+            aws_multi_checksum_destroy(checksum);
+            return NULL;
+        }
+    }
+
+    return checksum;
+}
+
+int aws_multi_checksum_update(struct aws_multi_checksum *checksum, struct aws_byte_cursor data) {
+    AWS_ERROR_PRECONDITION(checksum);
+
+    const uint32_t algorithms = checksum->algorithms;
+    while (data.len > 0) {
+        size_t block_len = aws_min_size(data.len, MULTI_CHECKSUM_BLOCK_SIZE);
+        struct aws_byte_cursor block = aws_byte_cursor_advance(&data, block_len);
+
+        /* the first algorithm pulls the block into L1, the others read it from there */
+        if (algorithms & AWS_MULTI_CHECKSUM_CRC32) {
+            checksum->crc32 = aws_checksums_crc32_ex(block.ptr, block.len, checksum->crc32);
+        }
+        if (algorithms & AWS_MULTI_CHECKSUM_CRC32C) {
+            checksum->crc32c = aws_checksums_crc32c_ex(block.ptr, block.len, checksum->crc32c);
+        }
+        if (algorithms & AWS_MULTI_CHECKSUM_CRC64NVME) {
+            checksum->crc64nvme = aws_checksums_crc64nvme_ex(block.ptr, block.len, checksum->crc64nvme);
+        }
+        for (size_t i = 0; i < XXHASH_SLOT_COUNT; ++i) {
+            if (checksum->xxhashes[i] != NULL && aws_xxhash_update(checksum->xxhashes[i], block)) {
+                return AWS_OP_ERR;
+            }
+        }
+    }
+
+    return AWS_OP_SUCCESS;
+}
+
+static int s_write_be32(struct aws_byte_buf *out, uint32_t value) {
+    if (!aws_byte_buf_write_be32(out, value)) {
+        return aws_raise_error(AWS_ERROR_INVALID_BUFFER_SIZE);
+    }
+    return AWS_OP_SUCCESS;
+}
+
+static int s_write_be64(struct aws_byte_buf *out, uint64_t value) {
+    if (!aws_byte_buf_write_be64(out, value)) {
+        return aws_raise_error(AWS_ERROR_INVALID_BUFFER_SIZE);
+    }
+    return AWS_OP_SUCCESS;
+}
+
+int aws_multi_checksum_finalize(
+    struct aws_multi_checksum *checksum,
+    enum aws_multi_checksum_algorithm algorithm,
+    struct aws_byte_buf *out) {
+    AWS_ERROR_PRECONDITION(checksum);
+    AWS_ERROR_PRECONDITION(out);
+
+    if ((checksum->algorithms & (uint32_t)algorithm) == 0) {
+        return aws_raise_error(AWS_ERROR_INVALID_ARGUMENT);
+    }
+
+    switch (algorithm) {
+        case AWS_MULTI_CHECKSUM_CRC32:
+            return s_write_be32(out, checksum->crc32);
+        case AWS_MULTI_CHECKSUM_CRC32C:
+            return s_write_be32(out, checksum->crc32c);
+        case AWS_MULTI_CHECKSUM_CRC64NVME:
+            return s_write_be64(out, checksum->crc64nvme);
+        case AWS_MULTI_CHECKSUM_XXHASH64:
+            return aws_xxhash_finalize(checksum->xxhashes[XXHASH_SLOT_64], out);
+        case AWS_MULTI_CHECKSUM_XXHASH3_64:
+            return aws_xxhash_finalize(checksum->xxhashes[XXHASH_SLOT_3_64], out);
+        case AWS_MULTI_CHECKSUM_XXHASH3_128:
+            return aws_xxhash_finalize(checksum->xxhashes[XXHASH_SLOT_3_128], out);
+    }
+
+    /* more than one bit set */
+    return aws_raise_error(AWS_ERROR_INVALID_ARGUMENT);
+}
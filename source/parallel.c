@@ -0,0 +1,381 @@
+/**
+ * Copyright Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0.
+ */
+
+#include <aws/checksums/crc.h>
+#include <aws/checksums/private/crc_util.h>
+#include <aws/checksums/private/parallel_priv.h>
+
+#include <aws/common/atomics.h>
+#include <aws/common/condition_variable.h>
+#include <aws/common/math.h>
+#include <aws/common/mutex.h>
+#include <aws/common/ref_count.h>
+#include <aws/common/system_info.h>
+#include <aws/common/thread.h>
+
+/* A contiguous range of task indices, consumed front to back by whichever threads are working on it. */
+struct parallel_queue {
+    struct aws_atomic_var next;
+    size_t end;
+};
+
+struct parallel_worker {
+    struct parallel_job *job;
+    size_t home_queue;
+    struct aws_thread thread;
+};
+
+/*
+ * Heap allocated and reference counted: with an executor, a worker may only get to run after the call that submitted
+ * it returned (i.e. the calling thread is the executor's only thread). It then finds every queue drained and just
+ * drops its reference.
+ */
+struct parallel_job {
+    struct aws_allocator *allocator;
+    struct aws_ref_count ref_count;
+
+    void (*task_fn)(size_t task_index, void *user_data);
+    void *user_data;
+    struct parallel_queue *queues;
+    size_t queue_count;
+    struct parallel_worker *workers;
+    size_t worker_count;
+
+    /* only used with an executor, where there is no thread handle to join */
+    struct aws_mutex lock;
+    struct aws_condition_variable signal;
+    size_t task_count;
+    size_t tasks_done;
+};
+
+static void s_job_destroy(void *arg) {
+    struct parallel_job *job = arg;
+    aws_condition_variable_clean_up(&job->signal);
+    aws_mutex_clean_up(&job->lock);
+    aws_mem_release(job->allocator, job->workers);
+    aws_mem_release(job->allocator, job->queues);
+    aws_mem_release(job->allocator, job);
+}
+
+/* Drains the home queue first, then helps with the others so no thread idles while work is left. */
+static size_t s_run_tasks(struct parallel_job *job, size_t home_queue) {
+    size_t tasks_run = 0;
+    for (size_t i = 0; i < job->queue_count; ++i) {
+        struct parallel_queue *queue = &job->queues[(home_queue + i) % job->queue_count];
+        size_t task_index = 0;
+        while ((task_index = aws_atomic_fetch_add(&queue->next, 1)) < queue->end) {
+            job->task_fn(task_index, job->user_data);
+            ++tasks_run;
+        }
+    }
+    return tasks_run;
+}
+
+static void s_thread_worker(void *arg) {
+    struct parallel_worker *worker = arg;
+    s_run_tasks(worker->job, worker->home_queue);
+}
+
+/* Adds the tasks a thread ran to the total, waking the calling thread once all of them are done. */
+static void s_tasks_finished(struct parallel_job *job, size_t tasks_run) {
+    aws_mutex_lock(&job->lock);
+    job->tasks_done += tasks_run;
+    if (job->tasks_done == job->task_count) {
+        aws_condition_variable_notify_one(&job->signal);
+    }
+    aws_mutex_unlock(&job->lock);
+}
+
+static void s_executor_worker(void *arg) {
+    struct parallel_worker *worker = arg;
+    struct parallel_job *job = worker->job;
+    s_tasks_finished(job, s_run_tasks(job, worker->home_queue));
+    aws_ref_count_release(&job->ref_count);
+}
+
+static bool s_all_tasks_done(void *arg) {
+    struct parallel_job *job = arg;
+    return job->tasks_done == job->task_count;
+}
+
+size_t aws_checksums_parallel_max_threads(const struct aws_checksums_parallel_options *options) {
+    if (options != NULL && options->max_threads != 0) {
+        return options->max_threads;
+    }
+    size_t processor_count = aws_system_info_processor_count();
+    return processor_count > 0 ? processor_count : 1;
+}
+
+/* Waits for every task to finish, not for every worker to run, so workers stuck behind the caller can't block it. */
+static void s_run_on_executor(struct parallel_job *job, struct aws_checksums_executor *executor) {
+    for (size_t i = 0; i < job->worker_count; ++i) {
+        aws_ref_count_acquire(&job->ref_count);
+        if (executor->submit(executor, s_executor_worker, &job->workers[i])) {
+            /* never runs, whatever it would have done is picked up by the others */
+            aws_ref_count_release(&job->ref_count);
+        }
+    }
+
+    s_tasks_finished(job, s_run_tasks(job, 0));
+
+    aws_mutex_lock(&job->lock);
+    aws_condition_variable_wait_pred(&job->signal, &job->lock, s_all_tasks_done, job);
+    aws_mutex_unlock(&job->lock);
+}
+
+/*
+ * Returns the cpu a worker should be pinned to, or -1 to leave placement to the OS. The n-th worker homed on a group
+ * goes to the n-th cpu of that group.
+ */
+static int32_t s_pick_cpu(struct aws_allocator *allocator, uint16_t group, size_t nth_in_group) {
+    size_t cpu_count = aws_get_cpu_count_for_group(group);
+    if (cpu_count == 0) {
+        return -1;
+    }
+
+    struct aws_cpu_info *cpus = aws_mem_calloc(allocator, cpu_count, sizeof(struct aws_cpu_info));
+    aws_get_cpu_ids_for_group(group, cpus, cpu_count);
+    int32_t cpu_id = cpus[nth_in_group % cpu_count].cpu_id;
+    aws_mem_release(allocator, cpus);
+
+    return cpu_id;
+}
+
+static void s_run_on_threads(struct aws_allocator *allocator, struct parallel_job *job, bool numa_aware) {
+    struct parallel_worker *workers = job->workers;
+    size_t worker_count = job->worker_count;
+
+    struct aws_thread_options thread_options = *aws_default_thread_options();
+    for (size_t i = 0; i < worker_count; ++i) {
+        if (numa_aware) {
+            thread_options.cpu_id = s_pick_cpu(allocator, (uint16_t)workers[i].home_queue, (i + 1) / job->queue_count);
+        }
+
+        aws_thread_init(&workers[i].thread, allocator);
+        if (aws_thread_launch(&workers[i].thread, s_thread_worker, &workers[i], &thread_options)) {
+            /* whatever this worker would have done is picked up by the others */
+            aws_thread_clean_up(&workers[i].thread);
+            workers[i].job = NULL;
+        }
+    }
+
+    s_run_tasks(job, 0);
+
+    for (size_t i = 0; i < worker_count; ++i) {
+        if (workers[i].job != NULL) {
+            aws_thread_join(&workers[i].thread);
+            aws_thread_clean_up(&workers[i].thread);
+        }
+    }
+}
+
+void aws_checksums_parallel_for(
+    struct aws_allocator *allocator,
+    const struct aws_checksums_parallel_options *options,
+    size_t task_count,
+    void (*task_fn)(size_t task_index, void *user_data),
+    void *user_data) {
+
+    size_t thread_count = aws_min_size(aws_checksums_parallel_max_threads(options), task_count);
+    if (thread_count <= 1) {
+        for (size_t i = 0; i < task_count; ++i) {
+            task_fn(i, user_data);
+        }
+        return;
+    }
+
+    struct aws_checksums_executor *executor = options != NULL ? options->executor : NULL;
+    bool numa_aware = executor == NULL && options != NULL && options->numa_aware;
+
+    /* with NUMA awareness every cpu group gets its own contiguous slice of the tasks */
+    size_t queue_count = 1;
+    if (numa_aware) {
+        queue_count = aws_min_size(aws_min_size(aws_get_cpu_group_count(), thread_count), task_count);
+        queue_count = aws_max_size(queue_count, 1);
+    }
+
+    struct parallel_job *job = aws_mem_calloc(allocator, 1, sizeof(struct parallel_job));
+    job->allocator = allocator;
+    aws_ref_count_init(&job->ref_count, job, s_job_destroy);
+    job->task_fn = task_fn;
+    job->user_data = user_data;
+    job->queue_count = queue_count;
+    job->queues = aws_mem_calloc(allocator, queue_count, sizeof(struct parallel_queue));
+    for (size_t i = 0; i < queue_count; ++i) {
+        aws_atomic_init_int(&job->queues[i].next, task_count * i / queue_count);
+        job->queues[i].end = task_count * (i + 1) / queue_count;
+    }
+    aws_mutex_init(&job->lock);
+    aws_condition_variable_init(&job->signal);
+    job->task_count = task_count;
+
+    /* the calling thread is worker 0 and works on queue 0 */
+    job->worker_count = thread_count - 1;
+    job->workers = aws_mem_calloc(allocator, job->worker_count, sizeof(struct parallel_worker));
+    for (size_t i = 0; i < job->worker_count; ++i) {
+        job->workers[i].job = job;
+        job->workers[i].home_queue = (i + 1) % queue_count;
+    }
+
+    if (executor != NULL) {
+        s_run_on_executor(job, executor);
+    } else {
+        s_run_on_threads(allocator, job, numa_aware);
+    }
+
+    aws_ref_count_release(&job->ref_count);
+}
+
+/* Keeps the serial combine pass and the per call allocation small even when chunk_size is tiny. */
+#define MAX_CHUNKS_PER_THREAD 64
+
+typedef uint64_t(parallel_checksum_fn)(const uint8_t *input, size_t length, uint64_t previous);
+typedef uint64_t(parallel_combine_fn)(uint64_t crc1, uint64_t crc2, uint64_t len2);
+
+struct parallel_checksum_job {
+    const uint8_t *input;
+    size_t length;
+    size_t chunk_size;
+    uint64_t previous;
+    parallel_checksum_fn *checksum_fn;
+    uint64_t *chunk_checksums;
+};
+
+static void s_checksum_chunk(size_t chunk_index, void *user_data) {
+    struct parallel_checksum_job *job = user_data;
+    size_t offset = chunk_index * job->chunk_size;
+    size_t length = aws_min_size(job->chunk_size, job->length - offset);
+
+    /* every chunk but the first starts from 0, combine() then stitches them together */
+    uint64_t previous = chunk_index == 0 ? job->previous : 0;
+    job->chunk_checksums[chunk_index] = job->checksum_fn(job->input + offset, length, previous);
+}
+
+static int s_checksum_parallel(
+    struct aws_allocator *allocator,
+    const uint8_t *input,
+    size_t length,
+    uint64_t previous,
+    const struct aws_checksums_parallel_options *options,
+    parallel_checksum_fn *checksum_fn,
+    parallel_combine_fn *combine_fn,
+    uint64_t *out_checksum) {
+
+    if (out_checksum == NULL || (input == NULL && length > 0)) {
+        return aws_raise_error(AWS_ERROR_INVALID_ARGUMENT);
+    }
+
+    size_t thread_count = aws_checksums_parallel_max_threads(options);
+    size_t chunk_size = options != NULL && options->chunk_size != 0 ? options->chunk_size
+                                                                    : AWS_CHECKSUMS_PARALLEL_DEFAULT_CHUNK_SIZE;
+    if (thread_count <= 1 || length / 2 < chunk_size) {
+        *out_checksum = checksum_fn(input, length, previous);
+        return AWS_OP_SUCCESS;
+    }
+
+    size_t max_chunks = aws_mul_size_saturating(thread_count, MAX_CHUNKS_PER_THREAD);
+    chunk_size = aws_max_size(chunk_size, length / max_chunks + 1);
+    size_t chunk_count = (length + chunk_size - 1) / chunk_size;
+
+    struct parallel_checksum_job job = {
+        .input = input,
+        .length = length,
+        .chunk_size = chunk_size,
+        .previous = previous,
+        .checksum_fn = checksum_fn,
+        .chunk_checksums = aws_mem_calloc(allocator, chunk_count, sizeof(uint64_t)),
+    };
+
+    aws_checksums_parallel_for(allocator, options, chunk_count, s_checksum_chunk, &job);
+
+    uint64_t checksum = job.chunk_checksums[0];
+    for (size_t i = 1; i < chunk_count; ++i) {
+        size_t chunk_length = aws_min_size(chunk_size, length - i * chunk_size);
+        checksum = combine_fn(checksum, job.chunk_checksums[i], chunk_length);
+    }
+
+    aws_mem_release(allocator, job.chunk_checksums);
+    *out_checksum = checksum;
+    return AWS_OP_SUCCESS;
+}
+
+static uint64_t s_crc32(const uint8_t *input, size_t length, uint64_t previous) {
+    return aws_checksums_crc32_ex(input, length, (uint32_t)previous);
+}
+
+static uint64_t s_crc32_combine(uint64_t crc1, uint64_t crc2, uint64_t len2) {
+    return aws_checksums_crc32_combine((uint32_t)crc1, (uint32_t)crc2, len2);
+}
+
+static uint64_t s_crc32c(const uint8_t *input, size_t length, uint64_t previous) {
+    return aws_checksums_crc32c_ex(input, length, (uint32_t)previous);
+}
+
+static uint64_t s_crc32c_combine(uint64_t crc1, uint64_t crc2, uint64_t len2) {
+    return aws_checksums_crc32c_combine((uint32_t)crc1, (uint32_t)crc2, len2);
+}
+
+static uint64_t s_crc64nvme(const uint8_t *input, size_t length, uint64_t previous) {
+    return aws_checksums_crc64nvme_ex(input, length, previous);
+}
+
+int aws_checksums_crc32_parallel(
+    struct aws_allocator *allocator,
+    const uint8_t *input,
+    size_t length,
+    uint32_t previous_crc32,
+    const struct aws_checksums_parallel_options *options,
+    uint32_t *out_crc32) {
+
+    if (out_crc32 == NULL) {
+        return aws_raise_error(AWS_ERROR_INVALID_ARGUMENT);
+    }
+
+    /* resolve the dispatch table before any worker thread can race on its lazy init */
+    aws_checksums_crc32_init();
+
+    uint64_t crc = 0;
+    if (s_checksum_parallel(allocator, input, length, previous_crc32, options, s_crc32, s_crc32_combine, &crc)) {
+        return AWS_OP_ERR;
+    }
+    *out_crc32 = (uint32_t)crc;
+    return AWS_OP_SUCCESS;
+}
+
+int aws_checksums_crc32c_parallel(
+    struct aws_allocator *allocator,
+    const uint8_t *input,
+    size_t length,
+    uint32_t previous_crc32c,
+    const struct aws_checksums_parallel_options *options,
+    uint32_t *out_crc32c) {
+
+    if (out_crc32c == NULL) {
+        return aws_raise_error(AWS_ERROR_INVALID_ARGUMENT);
+    }
+
+    aws_checksums_crc32_init();
+
+    uint64_t crc = 0;
+    if (s_checksum_parallel(allocator, input, length, previous_crc32c, options, s_crc32c, s_crc32c_combine, &crc)) {
+        return AWS_OP_ERR;
+    }
+    *out_crc32c = (uint32_t)crc;
+    return AWS_OP_SUCCESS;
+}
+
+int aws_checksums_crc64nvme_parallel(
+    struct aws_allocator *allocator,
+    const uint8_t *input,
+    size_t length,
+    uint64_t previous_crc64,
+    const struct aws_checksums_parallel_options *options,
+    uint64_t *out_crc64) {
+
+    aws_checksums_crc64_init();
+
+    return s_checksum_parallel(
+        allocator, input, length, previous_crc64, options, s_crc64nvme, aws_checksums_crc64nvme_combine, out_crc64);
+}
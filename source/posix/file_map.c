@@ -0,0 +1,51 @@
+/**
+ * Copyright Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0.
+ */
+
+#include <aws/checksums/private/file_map_priv.h>
+
+#include <aws/common/file.h>
+
+#include <errno.h>
+#include <sys/mman.h>
+#include <sys/types.h>
+#include <unistd.h>
+
+static size_t s_page_size(void) {
+    long page_size = sysconf(_SC_PAGESIZE);
+    return page_size > 0 ? (size_t)page_size : 4096;
+}
+
+int aws_checksums_file_map(FILE *file, uint64_t offset, size_t length, struct aws_checksums_file_mapping *out_mapping) {
+    AWS_PRECONDITION(length > 0);
+
+    uint64_t aligned_offset = offset - offset % s_page_size();
+    size_t lead = (size_t)(offset - aligned_offset);
+    if ((uint64_t)(off_t)aligned_offset != aligned_offset || length > SIZE_MAX - lead) {
+        return aws_raise_error(AWS_ERROR_OVERFLOW_DETECTED);
+    }
+
+    void *base = mmap(NULL, lead + length, PROT_READ, MAP_SHARED, fileno(file), (off_t)aligned_offset);
+    if (base == MAP_FAILED) {
+        return aws_translate_and_raise_io_error(errno);
+    }
+    /* doubles the kernel's readahead and drops pages behind the cursor sooner */
+    madvise(base, lead + length, MADV_SEQUENTIAL);
+
+    out_mapping->base = base;
+    out_mapping->base_length = lead + length;
+    out_mapping->data = (const uint8_t *)base + lead;
+    return AWS_OP_SUCCESS;
+}
+
+void aws_checksums_file_unmap(struct aws_checksums_file_mapping *mapping) {
+    munmap(mapping->base, mapping->base_length);
+    AWS_ZERO_STRUCT(*mapping);
+}
+
+void aws_checksums_file_prefetch(const uint8_t *data, size_t length) {
+    /* madvise wants a page aligned start */
+    size_t lead = (uintptr_t)data % s_page_size();
+    madvise((void *)(data - lead), length + lead, MADV_WILLNEED);
+}
@@ -0,0 +1,188 @@
+/**
+ * Copyright Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0.
+ */
+
+#include <aws/checksums/rolling_crc.h>
+
+#include <aws/checksums/crc.h>
+#include <aws/checksums/private/crc32_priv.h>
+
+/*
+ * The window is tracked as a "raw" crc, with no initial or final inversion. Raw crcs are linear, and leading zero
+ * bytes don't change them, so rolling in a byte and xor-ing out the raw crc of the outgoing byte followed by
+ * window_size zero bytes leaves the raw crc of the new window. The CRC32C of a window is its raw crc xor the CRC32C of
+ * window_size zero bytes.
+ */
+
+/* Windows each lane of aws_rolling_crc32c_scan() checks per block. */
+#define ROLLING_LANE_WINDOWS 1024
+/* The lane loop in aws_rolling_crc32c_scan() is unrolled for exactly this many. */
+#define ROLLING_LANES 4
+
+static inline uint32_t s_roll(const uint32_t out_table[256], uint32_t crc, uint8_t in, uint8_t out) {
+    return (crc >> 8) ^ CRC32C_TABLE[0][(crc ^ in) & 0xff] ^ out_table[out];
+}
+
+static inline uint32_t s_raw_crc(const struct aws_rolling_crc32c *rolling, const uint8_t *window) {
+    return aws_checksums_crc32c_ex(window, rolling->window_size, 0) ^ rolling->zero_window_crc;
+}
+
+int aws_rolling_crc32c_init(struct aws_rolling_crc32c *rolling, size_t window_size) {
+    AWS_ERROR_PRECONDITION(rolling);
+
+    if (window_size == 0) {
+        return aws_raise_error(AWS_ERROR_INVALID_ARGUMENT);
+    }
+
+    rolling->window_size = window_size;
+    rolling->crc = 0;
+    rolling->zero_window_crc = aws_checksums_crc32c_zero_extend(0, window_size);
+
+    /* the table is linear in the outgoing byte, so only the single bit entries need shifting by the window */
+    rolling->out_table[0] = 0;
+    for (size_t bit = 1; bit < 256; bit <<= 1) {
+        uint32_t shifted = aws_checksums_crc32c_combine(CRC32C_TABLE[0][bit], 0, window_size);
+        for (size_t i = 0; i < bit; ++i) {
+            rolling->out_table[bit | i] = shifted ^ rolling->out_table[i];
+        }
+    }
+
+    return AWS_OP_SUCCESS;
+}
+
+uint32_t aws_rolling_crc32c_reset(struct aws_rolling_crc32c *rolling, const uint8_t *window) {
+    rolling->crc = s_raw_crc(rolling, window);
+    return rolling->crc ^ rolling->zero_window_crc;
+}
+
+uint32_t aws_rolling_crc32c_roll(struct aws_rolling_crc32c *rolling, uint8_t in, uint8_t out) {
+    rolling->crc = s_roll(rolling->out_table, rolling->crc, in, out);
+    return rolling->crc ^ rolling->zero_window_crc;
+}
+
+/*
+ * Rolls one lane over the windows ending at (begin, end] of data, starting from the raw crc of the window ending at
+ * begin. Stops at the first raw crc matching target under mask.
+ */
+static bool s_scan_lane(
+    const struct aws_rolling_crc32c *rolling,
+    const uint8_t *data,
+    size_t begin,
+    size_t end,
+    uint32_t mask,
+    uint32_t target,
+    uint32_t *crc,
+    size_t *out_end) {
+
+    const uint8_t *out = data + begin - rolling->window_size;
+    uint32_t raw = *crc;
+    for (size_t i = begin; i < end; ++i) {
+        raw = s_roll(rolling->out_table, raw, data[i], *out++);
+        if ((raw & mask) == target) {
+            *crc = raw;
+            *out_end = i + 1;
+            return true;
+        }
+    }
+    *crc = raw;
+    return false;
+}
+
+bool aws_rolling_crc32c_scan(
+    struct aws_rolling_crc32c *rolling,
+    const uint8_t *data,
+    size_t len,
+    uint32_t mask,
+    size_t *out_end) {
+    AWS_PRECONDITION(rolling);
+    AWS_PRECONDITION(out_end);
+
+    const size_t window_size = rolling->window_size;
+    if (len < window_size) {
+        return false;
+    }
+
+    /* compare raw crcs, so the loops don't xor in zero_window_crc every byte */
+    const uint32_t target = rolling->zero_window_crc & mask;
+
+    size_t end = window_size;
+    rolling->crc = s_raw_crc(rolling, data);
+    if ((rolling->crc & mask) == target) {
+        *out_end = end;
+        return true;
+    }
+
+    /*
+     * Every byte depends on the crc of the previous one, so a single lane is bound by the latency of the table
+     * lookup. Instead split the data into ROLLING_LANES stretches, start each from its own window, and interleave
+     * their independent dependency chains. The first matching window is still the one reported.
+     */
+    const size_t block = ROLLING_LANES * ROLLING_LANE_WINDOWS;
+    while (len - end > block) {
+        uint32_t crcs[ROLLING_LANES];
+        size_t begins[ROLLING_LANES];
+        for (size_t lane = 0; lane < ROLLING_LANES; ++lane) {
+            begins[lane] = end + lane * ROLLING_LANE_WINDOWS;
+            crcs[lane] = lane == 0 ? rolling->crc : s_raw_crc(rolling, data + begins[lane] - window_size);
+        }
+
+        /* unrolled by hand, with the lanes in locals the compiler keeps the four chains in registers */
+        const uint32_t *out_table = rolling->out_table;
+        const uint8_t *in = data + end;
+        const uint8_t *out = in - window_size;
+        uint32_t crc0 = crcs[0];
+        uint32_t crc1 = crcs[1];
+        uint32_t crc2 = crcs[2];
+        uint32_t crc3 = crcs[3];
+        size_t i = 0;
+        unsigned hits = 0;
+        for (; i < ROLLING_LANE_WINDOWS; ++i) {
+            crc0 = s_roll(out_table, crc0, in[i], out[i]);
+            crc1 = s_roll(out_table, crc1, in[i + ROLLING_LANE_WINDOWS], out[i + ROLLING_LANE_WINDOWS]);
+            crc2 = s_roll(out_table, crc2, in[i + 2 * ROLLING_LANE_WINDOWS], out[i + 2 * ROLLING_LANE_WINDOWS]);
+            crc3 = s_roll(out_table, crc3, in[i + 3 * ROLLING_LANE_WINDOWS], out[i + 3 * ROLLING_LANE_WINDOWS]);
+            if (((crc0 & mask) == target) | ((crc1 & mask) == target) | ((crc2 & mask) == target) |
+                ((crc3 & mask) == target)) {
+                hits = (unsigned)((crc0 & mask) == target) | (unsigned)((crc1 & mask) == target) << 1 |
+                       (unsigned)((crc2 & mask) == target) << 2 | (unsigned)((crc3 & mask) == target) << 3;
+                break;
+            }
+        }
+        crcs[0] = crc0;
+        crcs[1] = crc1;
+        crcs[2] = crc2;
+        crcs[3] = crc3;
+
+        if (!hits) {
+            end += block;
+            rolling->crc = crcs[ROLLING_LANES - 1];
+            continue;
+        }
+
+        /* lanes before the first hitting one may still match later in their stretch, which comes first in data */
+        size_t hit_lane = 0;
+        while (!(hits & (1u << hit_lane))) {
+            ++hit_lane;
+        }
+        for (size_t lane = 0; lane < hit_lane; ++lane) {
+            if (s_scan_lane(
+                    rolling,
+                    data,
+                    begins[lane] + i + 1,
+                    begins[lane] + ROLLING_LANE_WINDOWS,
+                    mask,
+                    target,
+                    &crcs[lane],
+                    out_end)) {
+                rolling->crc = crcs[lane];
+                return true;
+            }
+        }
+        rolling->crc = crcs[hit_lane];
+        *out_end = begins[hit_lane] + i + 1;
+        return true;
+    }
+
+    return s_scan_lane(rolling, data, end, len, mask, target, &rolling->crc, out_end);
+}
@@ -0,0 +1,63 @@
+/**
+ * Copyright Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0.
+ */
+
+#include <aws/checksums/private/file_map_priv.h>
+
+#include <io.h>
+#include <windows.h>
+
+static size_t s_allocation_granularity(void) {
+    SYSTEM_INFO system_info;
+    GetSystemInfo(&system_info);
+    return system_info.dwAllocationGranularity;
+}
+
+int aws_checksums_file_map(FILE *file, uint64_t offset, size_t length, struct aws_checksums_file_mapping *out_mapping) {
+    AWS_PRECONDITION(length > 0);
+
+    uint64_t aligned_offset = offset - offset % s_allocation_granularity();
+    size_t lead = (size_t)(offset - aligned_offset);
+    if (length > SIZE_MAX - lead) {
+        return aws_raise_error(AWS_ERROR_OVERFLOW_DETECTED);
+    }
+
+    HANDLE file_handle = (HANDLE)_get_osfhandle(_fileno(file));
+    if (file_handle == INVALID_HANDLE_VALUE) {
+        return aws_raise_error(AWS_ERROR_INVALID_FILE_HANDLE);
+    }
+
+    HANDLE mapping = CreateFileMappingW(file_handle, NULL, PAGE_READONLY, 0, 0, NULL);
+    if (mapping == NULL) {
+        return aws_raise_error(AWS_ERROR_SYS_CALL_FAILURE);
+    }
+
+    void *base =
+        MapViewOfFile(mapping, FILE_MAP_READ, (DWORD)(aligned_offset >> 32), (DWORD)aligned_offset, lead + length);
+    /* the view keeps the mapping object alive */
+    CloseHandle(mapping);
+    if (base == NULL) {
+        return aws_raise_error(AWS_ERROR_SYS_CALL_FAILURE);
+    }
+
+    out_mapping->base = base;
+    out_mapping->base_length = lead + length;
+    out_mapping->data = (const uint8_t *)base + lead;
+    return AWS_OP_SUCCESS;
+}
+
+void aws_checksums_file_unmap(struct aws_checksums_file_mapping *mapping) {
+    UnmapViewOfFile(mapping->base);
+    AWS_ZERO_STRUCT(*mapping);
+}
+
+void aws_checksums_file_prefetch(const uint8_t *data, size_t length) {
+#if defined(_WIN32_WINNT) && _WIN32_WINNT >= 0x0602 /* PrefetchVirtualMemory is Windows 8+ */
+    WIN32_MEMORY_RANGE_ENTRY range = {(PVOID)data, length};
+    PrefetchVirtualMemory(GetCurrentProcess(), 1, &range, 0);
+#else
+    (void)data;
+    (void)length;
+#endif
+}
@@ -3,15 +3,41 @@
  * SPDX-License-Identifier: Apache-2.0.
  */
 
+#include <aws/checksums/checksum.h>
+#include <aws/checksums/private/parallel_priv.h>
+#include <aws/checksums/private/xxhash_priv.h>
 #include <aws/checksums/xxhash.h>
 #include <aws/common/cpuid.h>
+#include <aws/common/math.h>
 
 /*
  * Below dispatch is heavily influenced by x86 dispatch sample in the reference impl.
  * Do not change names of any defined macros as they impact what gets compiled in the impl.
  * i.e. defines like XXH_DISPATCH_AVX2 are not only used in this file, but affect how xxhash compiles dispatch.
  */
-#if defined(AWS_ARCH_INTEL_X64)
+/*
+ * With AWS_CHECKSUMS_STATIC_DISPATCH the build already targets a known cpu, so skip runtime dispatch and let the
+ * vendored impl pick XXH_VECTOR from the target ISA macros (e.g. __AVX512F__) instead.
+ */
+#if defined(AWS_ARCH_INTEL_X64) && !defined(AWS_CHECKSUMS_STATIC_DISPATCH)
+#    define AWS_XXH_X86_DISPATCH
+#endif
+
+/*
+ * On AArch64 the vendored impl builds NEON, which every AArch64 cpu has, and SVE kernels built separately in
+ * source/arm/xxhash_sve.c are switched in at runtime. AWS_CHECKSUMS_HAVE_SVE is set by the build on Linux when the
+ * compiler can target SVE.
+ */
+#if defined(AWS_ARCH_ARM64) && defined(AWS_USE_CPU_EXTENSIONS) && defined(AWS_CHECKSUMS_HAVE_SVE) &&                   \
+    !defined(AWS_CHECKSUMS_STATIC_DISPATCH)
+#    define AWS_XXH_ARM_DISPATCH
+#endif
+
+#if defined(AWS_XXH_X86_DISPATCH) || defined(AWS_XXH_ARM_DISPATCH)
+#    define AWS_XXH_RUNTIME_DISPATCH
+#endif
+
+#if defined(AWS_XXH_X86_DISPATCH)
 #    define XXH_X86DISPATCH
 
 #    if defined(AWS_USE_CPU_EXTENSIONS)
@@ -71,7 +97,7 @@
 #define XXH_INLINE_ALL
 #include "external/xxhash.h"
 
-#if defined(AWS_ARCH_INTEL_X64)
+#if defined(AWS_XXH_X86_DISPATCH)
 #    if XXH_DISPATCH_SCALAR
 XXH_NO_INLINE XXH64_hash_t
     XXH3_64_seed_scalar(XXH_NOESCAPE const void *XXH_RESTRICT input, size_t len, XXH64_hash_t seed) {
@@ -85,6 +111,25 @@ XXH_NO_INLINE XXH128_hash_t
         input, len, seed, XXH3_accumulate_scalar, XXH3_scrambleAcc_scalar, XXH3_initCustomSecret_scalar);
 }
 
+XXH_NO_INLINE XXH64_hash_t
+    XXH3_64_secret_scalar(
+        XXH_NOESCAPE const void *XXH_RESTRICT input,
+        size_t len,
+        const void *XXH_RESTRICT secret,
+        size_t secretLen) {
+    return XXH3_hashLong_64b_internal(input, len, secret, secretLen, XXH3_accumulate_scalar, XXH3_scrambleAcc_scalar);
+}
+
+XXH_NO_INLINE XXH128_hash_t
+    XXH3_128_secret_scalar(
+        XXH_NOESCAPE const void *XXH_RESTRICT input,
+        size_t len,
+        const void *XXH_RESTRICT secret,
+        size_t secretLen) {
+    return XXH3_hashLong_128b_internal(
+        input, len, (const xxh_u8 *)secret, secretLen, XXH3_accumulate_scalar, XXH3_scrambleAcc_scalar);
+}
+
 XXH_NO_INLINE XXH_errorcode
     XXH3_update_scalar(XXH_NOESCAPE XXH3_state_t *state, XXH_NOESCAPE const void *input, size_t len) {
     return XXH3_update(state, (const xxh_u8 *)input, len, XXH3_accumulate_scalar, XXH3_scrambleAcc_scalar);
@@ -105,6 +150,25 @@ XXH_NO_INLINE XXH_TARGET_SSE2 XXH128_hash_t
         input, len, seed, XXH3_accumulate_sse2, XXH3_scrambleAcc_sse2, XXH3_initCustomSecret_sse2);
 }
 
+XXH_NO_INLINE XXH_TARGET_SSE2 XXH64_hash_t
+    XXH3_64_secret_sse2(
+        XXH_NOESCAPE const void *XXH_RESTRICT input,
+        size_t len,
+        const void *XXH_RESTRICT secret,
+        size_t secretLen) {
+    return XXH3_hashLong_64b_internal(input, len, secret, secretLen, XXH3_accumulate_sse2, XXH3_scrambleAcc_sse2);
+}
+
+XXH_NO_INLINE XXH_TARGET_SSE2 XXH128_hash_t
+    XXH3_128_secret_sse2(
+        XXH_NOESCAPE const void *XXH_RESTRICT input,
+        size_t len,
+        const void *XXH_RESTRICT secret,
+        size_t secretLen) {
+    return XXH3_hashLong_128b_internal(
+        input, len, (const xxh_u8 *)secret, secretLen, XXH3_accumulate_sse2, XXH3_scrambleAcc_sse2);
+}
+
 XXH_NO_INLINE XXH_TARGET_SSE2 XXH_errorcode
     XXH3_update_sse2(XXH_NOESCAPE XXH3_state_t *state, XXH_NOESCAPE const void *input, size_t len) {
     return XXH3_update(state, (const xxh_u8 *)input, len, XXH3_accumulate_sse2, XXH3_scrambleAcc_sse2);
@@ -123,6 +187,25 @@ XXH_NO_INLINE XXH_TARGET_AVX2 XXH128_hash_t
         input, len, seed, XXH3_accumulate_avx2, XXH3_scrambleAcc_avx2, XXH3_initCustomSecret_avx2);
 }
 
+XXH_NO_INLINE XXH_TARGET_AVX2 XXH64_hash_t
+    XXH3_64_secret_avx2(
+        XXH_NOESCAPE const void *XXH_RESTRICT input,
+        size_t len,
+        const void *XXH_RESTRICT secret,
+        size_t secretLen) {
+    return XXH3_hashLong_64b_internal(input, len, secret, secretLen, XXH3_accumulate_avx2, XXH3_scrambleAcc_avx2);
+}
+
+XXH_NO_INLINE XXH_TARGET_AVX2 XXH128_hash_t
+    XXH3_128_secret_avx2(
+        XXH_NOESCAPE const void *XXH_RESTRICT input,
+        size_t len,
+        const void *XXH_RESTRICT secret,
+        size_t secretLen) {
+    return XXH3_hashLong_128b_internal(
+        input, len, (const xxh_u8 *)secret, secretLen, XXH3_accumulate_avx2, XXH3_scrambleAcc_avx2);
+}
+
 XXH_NO_INLINE XXH_TARGET_AVX2 XXH_errorcode
     XXH3_update_avx2(XXH_NOESCAPE XXH3_state_t *state, XXH_NOESCAPE const void *input, size_t len) {
     return XXH3_update(state, (const xxh_u8 *)input, len, XXH3_accumulate_avx2, XXH3_scrambleAcc_avx2);
@@ -142,58 +225,206 @@ XXH_NO_INLINE XXH_TARGET_AVX512 XXH128_hash_t
         input, len, seed, XXH3_accumulate_avx512, XXH3_scrambleAcc_avx512, XXH3_initCustomSecret_avx512);
 }
 
+XXH_NO_INLINE XXH_TARGET_AVX512 XXH64_hash_t
+    XXH3_64_secret_avx512(
+        XXH_NOESCAPE const void *XXH_RESTRICT input,
+        size_t len,
+        const void *XXH_RESTRICT secret,
+        size_t secretLen) {
+    return XXH3_hashLong_64b_internal(input, len, secret, secretLen, XXH3_accumulate_avx512, XXH3_scrambleAcc_avx512);
+}
+
+XXH_NO_INLINE XXH_TARGET_AVX512 XXH128_hash_t
+    XXH3_128_secret_avx512(
+        XXH_NOESCAPE const void *XXH_RESTRICT input,
+        size_t len,
+        const void *XXH_RESTRICT secret,
+        size_t secretLen) {
+    return XXH3_hashLong_128b_internal(
+        input, len, (const xxh_u8 *)secret, secretLen, XXH3_accumulate_avx512, XXH3_scrambleAcc_avx512);
+}
+
 XXH_NO_INLINE XXH_TARGET_AVX512 XXH_errorcode
     XXH3_update_avx512(XXH_NOESCAPE XXH3_state_t *state, XXH_NOESCAPE const void *input, size_t len) {
     return XXH3_update(state, (const xxh_u8 *)input, len, XXH3_accumulate_avx512, XXH3_scrambleAcc_avx512);
 }
 #        endif
 #    endif
+#endif
 
-typedef XXH64_hash_t (*dispatch_x86_XXH3_64_seed_fn)(XXH_NOESCAPE const void *XXH_RESTRICT, size_t, XXH64_hash_t);
-typedef XXH_errorcode (*dispatch_x86_XXH3_update_fn)(XXH_NOESCAPE XXH3_state_t *, XXH_NOESCAPE const void *, size_t);
-typedef XXH128_hash_t (*dispatch_x86_XXH3_128_seed_fn)(XXH_NOESCAPE const void *XXH_RESTRICT, size_t, XXH64_hash_t);
+#if defined(AWS_XXH_ARM_DISPATCH)
+#    if defined(__linux__)
+#        include <sys/auxv.h>
+#        ifndef HWCAP_SVE
+#            define HWCAP_SVE (1 << 22)
+#        endif
+#    endif
 
-static dispatch_x86_XXH3_64_seed_fn s_x86_XXH3_64_seed_compute = NULL;
-static dispatch_x86_XXH3_128_seed_fn s_x86_XXH3_128_seed_compute = NULL;
-static dispatch_x86_XXH3_update_fn s_x86_XXH3_update = NULL;
+/* Baseline, with the accumulate loop the vendored impl picked for this target (NEON). */
+XXH_NO_INLINE XXH64_hash_t
+    XXH3_64_seed_baseline(XXH_NOESCAPE const void *XXH_RESTRICT input, size_t len, XXH64_hash_t seed) {
+    return XXH3_hashLong_64b_withSeed_internal(
+        input, len, seed, XXH3_accumulate, XXH3_scrambleAcc, XXH3_initCustomSecret);
+}
+
+XXH_NO_INLINE XXH128_hash_t
+    XXH3_128_seed_baseline(XXH_NOESCAPE const void *XXH_RESTRICT input, size_t len, XXH64_hash_t seed) {
+    return XXH3_hashLong_128b_withSeed_internal(
+        input, len, seed, XXH3_accumulate, XXH3_scrambleAcc, XXH3_initCustomSecret);
+}
+
+XXH_NO_INLINE XXH64_hash_t XXH3_64_secret_baseline(
+    XXH_NOESCAPE const void *XXH_RESTRICT input,
+    size_t len,
+    const void *XXH_RESTRICT secret,
+    size_t secretLen) {
+    return XXH3_hashLong_64b_internal(input, len, secret, secretLen, XXH3_accumulate, XXH3_scrambleAcc);
+}
+
+XXH_NO_INLINE XXH128_hash_t XXH3_128_secret_baseline(
+    XXH_NOESCAPE const void *XXH_RESTRICT input,
+    size_t len,
+    const void *XXH_RESTRICT secret,
+    size_t secretLen) {
+    return XXH3_hashLong_128b_internal(
+        input, len, (const xxh_u8 *)secret, secretLen, XXH3_accumulate, XXH3_scrambleAcc);
+}
+
+XXH_NO_INLINE XXH_errorcode
+    XXH3_update_baseline(XXH_NOESCAPE XXH3_state_t *state, XXH_NOESCAPE const void *input, size_t len) {
+    return XXH3_update(state, (const xxh_u8 *)input, len, XXH3_accumulate, XXH3_scrambleAcc);
+}
 
+/* Note: wrappers to match the dispatch signatures, the SVE kernels are declared without xxhash types. */
+static XXH64_hash_t XXH3_64_seed_sve(XXH_NOESCAPE const void *XXH_RESTRICT input, size_t len, XXH64_hash_t seed) {
+    return aws_checksums_xxh3_64_seed_sve(input, len, seed);
+}
+
+static XXH128_hash_t XXH3_128_seed_sve(XXH_NOESCAPE const void *XXH_RESTRICT input, size_t len, XXH64_hash_t seed) {
+    XXH128_hash_t hash;
+    aws_checksums_xxh3_128_seed_sve(input, len, seed, &hash.low64, &hash.high64);
+    return hash;
+}
+
+static XXH64_hash_t XXH3_64_secret_sve(
+    XXH_NOESCAPE const void *XXH_RESTRICT input,
+    size_t len,
+    const void *XXH_RESTRICT secret,
+    size_t secretLen) {
+    return aws_checksums_xxh3_64_secret_sve(input, len, secret, secretLen);
+}
+
+static XXH128_hash_t XXH3_128_secret_sve(
+    XXH_NOESCAPE const void *XXH_RESTRICT input,
+    size_t len,
+    const void *XXH_RESTRICT secret,
+    size_t secretLen) {
+    XXH128_hash_t hash;
+    aws_checksums_xxh3_128_secret_sve(input, len, secret, secretLen, &hash.low64, &hash.high64);
+    return hash;
+}
+
+static XXH_errorcode XXH3_update_sve(XXH_NOESCAPE XXH3_state_t *state, XXH_NOESCAPE const void *input, size_t len) {
+    return aws_checksums_xxh3_update_sve(state, input, len) ? XXH_ERROR : XXH_OK;
+}
+
+static bool s_use_sve(void) {
+#    if defined(__linux__)
+    /* aws_cpu_has_feature() has no SVE bit, so ask the kernel */
+    if ((getauxval(AT_HWCAP) & HWCAP_SVE) == 0) {
+        return false;
+    }
+    /*
+     * With 128 bit vectors SVE does as much per instruction as NEON, and the NEON kernel also keeps part of the
+     * accumulators in scalar registers to use the integer pipes. SVE only pays off with wider vectors.
+     */
+    return aws_checksums_xxhash_sve_vector_bytes() > 16;
+#    else
+    return false;
+#    endif
+}
+#endif
+
+#if defined(AWS_XXH_RUNTIME_DISPATCH)
+typedef XXH64_hash_t (*dispatch_XXH3_64_seed_fn)(XXH_NOESCAPE const void *XXH_RESTRICT, size_t, XXH64_hash_t);
+typedef XXH_errorcode (*dispatch_XXH3_update_fn)(XXH_NOESCAPE XXH3_state_t *, XXH_NOESCAPE const void *, size_t);
+typedef XXH128_hash_t (*dispatch_XXH3_128_seed_fn)(XXH_NOESCAPE const void *XXH_RESTRICT, size_t, XXH64_hash_t);
+typedef XXH64_hash_t (*dispatch_XXH3_64_secret_fn)(
+    XXH_NOESCAPE const void *XXH_RESTRICT,
+    size_t,
+    const void *XXH_RESTRICT,
+    size_t);
+typedef XXH128_hash_t (*dispatch_XXH3_128_secret_fn)(
+    XXH_NOESCAPE const void *XXH_RESTRICT,
+    size_t,
+    const void *XXH_RESTRICT,
+    size_t);
+
+static dispatch_XXH3_64_seed_fn s_dispatch_XXH3_64_seed_compute = NULL;
+static dispatch_XXH3_128_seed_fn s_dispatch_XXH3_128_seed_compute = NULL;
+static dispatch_XXH3_update_fn s_dispatch_XXH3_update = NULL;
+static dispatch_XXH3_64_secret_fn s_dispatch_XXH3_64_secret_compute = NULL;
+static dispatch_XXH3_128_secret_fn s_dispatch_XXH3_128_secret_compute = NULL;
 #endif
 
 void aws_checksums_xxhash_init(struct aws_allocator *allocator) {
 
     XXH_set_allocator(allocator);
 
-#if defined(AWS_ARCH_INTEL_X64)
+#if defined(AWS_XXH_X86_DISPATCH)
 
 #    if XXH_DISPATCH_SCALAR
-    s_x86_XXH3_64_seed_compute = XXH3_64_seed_scalar;
-    s_x86_XXH3_128_seed_compute = XXH3_128_seed_scalar;
-    s_x86_XXH3_update = XXH3_update_scalar;
+    s_dispatch_XXH3_64_seed_compute = XXH3_64_seed_scalar;
+    s_dispatch_XXH3_128_seed_compute = XXH3_128_seed_scalar;
+    s_dispatch_XXH3_update = XXH3_update_scalar;
+    s_dispatch_XXH3_64_secret_compute = XXH3_64_secret_scalar;
+    s_dispatch_XXH3_128_secret_compute = XXH3_128_secret_scalar;
 #    else
-    s_x86_XXH3_64_seed_compute = XXH3_64_seed_sse2;
-    s_x86_XXH3_128_seed_compute = XXH3_128_seed_sse2;
-    s_x86_XXH3_update = XXH3_update_sse2;
+    s_dispatch_XXH3_64_seed_compute = XXH3_64_seed_sse2;
+    s_dispatch_XXH3_128_seed_compute = XXH3_128_seed_sse2;
+    s_dispatch_XXH3_update = XXH3_update_sse2;
+    s_dispatch_XXH3_64_secret_compute = XXH3_64_secret_sse2;
+    s_dispatch_XXH3_128_secret_compute = XXH3_128_secret_sse2;
 #    endif
 
 #    if XXH_DISPATCH_AVX2
     if (aws_cpu_has_feature(AWS_CPU_FEATURE_AVX2)) {
-        s_x86_XXH3_64_seed_compute = XXH3_64_seed_avx2;
-        s_x86_XXH3_128_seed_compute = XXH3_128_seed_avx2;
-        s_x86_XXH3_update = XXH3_update_avx2;
+        s_dispatch_XXH3_64_seed_compute = XXH3_64_seed_avx2;
+        s_dispatch_XXH3_128_seed_compute = XXH3_128_seed_avx2;
+        s_dispatch_XXH3_update = XXH3_update_avx2;
+        s_dispatch_XXH3_64_secret_compute = XXH3_64_secret_avx2;
+        s_dispatch_XXH3_128_secret_compute = XXH3_128_secret_avx2;
     }
 #    endif
 
 #    if XXH_DISPATCH_AVX512
     if (aws_cpu_has_feature(AWS_CPU_FEATURE_AVX512)) {
-        s_x86_XXH3_64_seed_compute = XXH3_64_seed_avx512;
-        s_x86_XXH3_128_seed_compute = XXH3_128_seed_avx512;
-        s_x86_XXH3_update = XXH3_update_avx512;
+        s_dispatch_XXH3_64_seed_compute = XXH3_64_seed_avx512;
+        s_dispatch_XXH3_128_seed_compute = XXH3_128_seed_avx512;
+        s_dispatch_XXH3_update = XXH3_update_avx512;
+        s_dispatch_XXH3_64_secret_compute = XXH3_64_secret_avx512;
+        s_dispatch_XXH3_128_secret_compute = XXH3_128_secret_avx512;
     }
 #    endif
 #endif
+
+#if defined(AWS_XXH_ARM_DISPATCH)
+    s_dispatch_XXH3_64_seed_compute = XXH3_64_seed_baseline;
+    s_dispatch_XXH3_128_seed_compute = XXH3_128_seed_baseline;
+    s_dispatch_XXH3_update = XXH3_update_baseline;
+    s_dispatch_XXH3_64_secret_compute = XXH3_64_secret_baseline;
+    s_dispatch_XXH3_128_secret_compute = XXH3_128_secret_baseline;
+
+    if (s_use_sve()) {
+        s_dispatch_XXH3_64_seed_compute = XXH3_64_seed_sve;
+        s_dispatch_XXH3_128_seed_compute = XXH3_128_seed_sve;
+        s_dispatch_XXH3_update = XXH3_update_sve;
+        s_dispatch_XXH3_64_secret_compute = XXH3_64_secret_sve;
+        s_dispatch_XXH3_128_secret_compute = XXH3_128_secret_sve;
+    }
+#endif
 }
 
-typedef int (*xxhash_update_fn)(void *state, struct aws_byte_cursor data);
 int s_update_XXH64(void *state, struct aws_byte_cursor data) {
     if (XXH64_update((XXH64_state_t *)state, data.ptr, data.len) == XXH_ERROR) {
         return aws_raise_error(AWS_ERROR_INVALID_STATE);
@@ -202,9 +433,9 @@ int s_update_XXH64(void *state, struct aws_byte_cursor data) {
 }
 
 int s_update_XXH3_64(void *state, struct aws_byte_cursor data) {
-#if defined(AWS_ARCH_INTEL_X64)
-    AWS_FATAL_ASSERT(s_x86_XXH3_update);
-    if (s_x86_XXH3_update((XXH3_state_t *)state, data.ptr, data.len) == XXH_ERROR) {
+#if defined(AWS_XXH_RUNTIME_DISPATCH)
+    AWS_FATAL_ASSERT(s_dispatch_XXH3_update);
+    if (s_dispatch_XXH3_update((XXH3_state_t *)state, data.ptr, data.len) == XXH_ERROR) {
 #else
     if (XXH3_64bits_update((XXH3_state_t *)state, data.ptr, data.len) == XXH_ERROR) {
 #endif
@@ -214,9 +445,9 @@ int s_update_XXH3_64(void *state, struct aws_byte_cursor data) {
 }
 
 int s_update_XXH3_128(void *state, struct aws_byte_cursor data) {
-#if defined(AWS_ARCH_INTEL_X64)
-    AWS_FATAL_ASSERT(s_x86_XXH3_update);
-    if (s_x86_XXH3_update((XXH3_state_t *)state, data.ptr, data.len) == XXH_ERROR) {
+#if defined(AWS_XXH_RUNTIME_DISPATCH)
+    AWS_FATAL_ASSERT(s_dispatch_XXH3_update);
+    if (s_dispatch_XXH3_update((XXH3_state_t *)state, data.ptr, data.len) == XXH_ERROR) {
 #else
     if (XXH3_128bits_update((XXH3_state_t *)state, data.ptr, data.len) == XXH_ERROR) {
 #endif
@@ -226,7 +457,6 @@ int s_update_XXH3_128(void *state, struct aws_byte_cursor data) {
     return AWS_OP_SUCCESS;
 }
 
-typedef int (*xxhash_finalize_fn)(void *state, struct aws_byte_buf *out);
 int s_finalize_XXH64(void *state, struct aws_byte_buf *out) {
     XXH64_hash_t hash = XXH64_digest((XXH64_state_t *)state);
 
@@ -255,143 +485,246 @@ int s_finalize_XXH3_128(void *state, struct aws_byte_buf *out) {
     return AWS_OP_SUCCESS;
 }
 
-typedef void (*xxhash_state_free_fn)(void *state);
-void s_state_free_XXH64(void *state) {
-    XXH64_freeState((XXH64_state_t *)state);
-}
+/* struct aws_checksum and struct aws_xxhash_impl reserve inline storage for these, see AWS_CHECKSUM_STATE_SIZE */
+AWS_STATIC_ASSERT(sizeof(XXH64_state_t) <= AWS_CHECKSUM_STATE_SIZE);
+AWS_STATIC_ASSERT(sizeof(XXH3_state_t) <= AWS_CHECKSUM_STATE_SIZE);
+
+#define XXHASH_STATE_ALIGNMENT 64
+
+int aws_xxhash_state_reset(void *state, enum aws_xxhash_type type, uint64_t seed) {
+    AWS_PRECONDITION(((uintptr_t)state & (XXHASH_STATE_ALIGNMENT - 1)) == 0);
+
+    XXH_errorcode result = XXH_ERROR;
+    switch (type) {
+        case XXHASH64:
+            result = XXH64_reset((XXH64_state_t *)state, seed);
+            break;
+        case XXHASH3_64:
+            result = XXH3_64bits_reset_withSeed((XXH3_state_t *)state, seed);
+            break;
+        case XXHASH3_128:
+            result = XXH3_128bits_reset_withSeed((XXH3_state_t *)state, seed);
+            break;
+        case XXHASH3_TREE:
+            /* needs the two states of struct aws_xxhash_impl */
+            break;
+    }
 
-void s_state_free_XXH3(void *state) {
-    XXH3_freeState((XXH3_state_t *)state);
+    if (result == XXH_ERROR) {
+        return aws_raise_error(AWS_ERROR_INVALID_STATE);
+    }
+    return AWS_OP_SUCCESS;
 }
 
-struct aws_xxhash_impl {
-    void *state;
-    xxhash_update_fn update_fn;
-    xxhash_finalize_fn finalize_fn;
-    xxhash_state_free_fn state_free_fn;
-};
-
-struct aws_xxhash *aws_xxhash64_new(struct aws_allocator *allocator, uint64_t seed) {
-    XXH64_state_t *const state = XXH64_createState();
-
-    if (state == NULL) {
-        aws_raise_error(AWS_ERROR_INVALID_STATE);
-        return NULL;
+int aws_xxhash_state_update(void *state, enum aws_xxhash_type type, struct aws_byte_cursor data) {
+    switch (type) {
+        case XXHASH64:
+            return s_update_XXH64(state, data);
+        case XXHASH3_64:
+            return s_update_XXH3_64(state, data);
+        case XXHASH3_128:
+            return s_update_XXH3_128(state, data);
+        case XXHASH3_TREE:
+            break;
     }
+    return aws_raise_error(AWS_ERROR_INVALID_STATE);
+}
 
-    if (XXH64_reset(state, seed) == XXH_ERROR) {
-        aws_raise_error(AWS_ERROR_INVALID_STATE);
-        goto on_error;
+int aws_xxhash_state_finalize(void *state, enum aws_xxhash_type type, struct aws_byte_buf *out) {
+    switch (type) {
+        case XXHASH64:
+            return s_finalize_XXH64(state, out);
+        case XXHASH3_64:
+            return s_finalize_XXH3_64(state, out);
+        case XXHASH3_128:
+            return s_finalize_XXH3_128(state, out);
+        case XXHASH3_TREE:
+            break;
     }
+    return aws_raise_error(AWS_ERROR_INVALID_STATE);
+}
 
-    struct aws_xxhash *hash = NULL;
-    struct aws_xxhash_impl *impl = NULL;
-
-    aws_mem_acquire_many(allocator, 2, &hash, sizeof(struct aws_xxhash), &impl, sizeof(struct aws_xxhash_impl));
-    hash->allocator = allocator;
-    hash->type = XXHASH64;
+/*
+ * XXHASH3_TREE streaming, see AWS_XXHASH3_TREE_LEAF_SIZE for the format. The totalLen of the leaf and root states
+ * tell how far the input got.
+ */
+static struct aws_xxhash_tree_impl *s_tree_impl(struct aws_xxhash *hash) {
+    return AWS_CONTAINER_OF(hash->impl, struct aws_xxhash_tree_impl, leaf);
+}
 
-    impl->state = state;
-    impl->update_fn = s_update_XXH64;
-    impl->finalize_fn = s_finalize_XXH64;
-    impl->state_free_fn = s_state_free_XXH64;
-    hash->impl = impl;
+static int s_tree_reset(struct aws_xxhash_tree_impl *impl, uint64_t seed) {
+    if (XXH3_128bits_reset_withSeed((XXH3_state_t *)&impl->leaf.state, seed) == XXH_ERROR ||
+        XXH3_128bits_reset_withSeed((XXH3_state_t *)&impl->root, seed) == XXH_ERROR) {
+        return aws_raise_error(AWS_ERROR_INVALID_STATE);
+    }
+    return AWS_OP_SUCCESS;
+}
 
-    return hash;
+static int s_tree_add_leaf(const XXH3_state_t *leaf, XXH3_state_t *root) {
+    uint8_t digest_storage[16] = {0};
+    struct aws_byte_buf digest = aws_byte_buf_from_empty_array(digest_storage, sizeof(digest_storage));
+    s_finalize_XXH3_128((void *)leaf, &digest);
+    return s_update_XXH3_128(root, aws_byte_cursor_from_buf(&digest));
+}
 
-on_error:
-    XXH64_freeState(state);
-    return NULL;
+static int s_tree_update(struct aws_xxhash_tree_impl *impl, struct aws_byte_cursor data) {
+    XXH3_state_t *leaf = (XXH3_state_t *)&impl->leaf.state;
+    XXH3_state_t *root = (XXH3_state_t *)&impl->root;
+
+    while (data.len > 0) {
+        size_t leaf_space = AWS_XXHASH3_TREE_LEAF_SIZE - (size_t)leaf->totalLen;
+        if (s_update_XXH3_128(leaf, aws_byte_cursor_advance(&data, aws_min_size(data.len, leaf_space)))) {
+            return AWS_OP_ERR;
+        }
+
+        /* a full leaf is closed right away, an empty one is never hashed */
+        if (leaf->totalLen == AWS_XXHASH3_TREE_LEAF_SIZE) {
+            if (s_tree_add_leaf(leaf, root) || XXH3_128bits_reset_withSeed(leaf, leaf->seed) == XXH_ERROR) {
+                return aws_raise_error(AWS_ERROR_INVALID_STATE);
+            }
+        }
+    }
+    return AWS_OP_SUCCESS;
 }
 
-struct aws_xxhash *aws_xxhash3_64_new(struct aws_allocator *allocator, uint64_t seed) {
-    XXH3_state_t *state = XXH3_createState();
+static int s_tree_finalize(struct aws_xxhash_tree_impl *impl, struct aws_byte_buf *out) {
+    const XXH3_state_t *leaf = (const XXH3_state_t *)&impl->leaf.state;
 
-    if (state == NULL) {
-        aws_raise_error(AWS_ERROR_INVALID_STATE);
-        return NULL;
+    /* finalizing doesn't end the stream, so the last leaf and the length go into a copy of the root */
+    XXH3_state_t root;
+    XXH_memcpy(&root, &impl->root, sizeof(root));
+    uint64_t total_length = root.totalLen / 16 * AWS_XXHASH3_TREE_LEAF_SIZE + leaf->totalLen;
+    if (leaf->totalLen > 0 && s_tree_add_leaf(leaf, &root)) {
+        return AWS_OP_ERR;
     }
 
-    if (XXH3_64bits_reset_withSeed(state, seed) == XXH_ERROR) {
-        aws_raise_error(AWS_ERROR_INVALID_STATE);
-        goto on_error;
+    uint8_t length_storage[8] = {0};
+    struct aws_byte_buf length = aws_byte_buf_from_empty_array(length_storage, sizeof(length_storage));
+    aws_byte_buf_write_be64(&length, total_length);
+    if (s_update_XXH3_128(&root, aws_byte_cursor_from_buf(&length))) {
+        return AWS_OP_ERR;
     }
+    return s_finalize_XXH3_128(&root, out);
+}
 
-    struct aws_xxhash *hash = NULL;
-    struct aws_xxhash_impl *impl = NULL;
-
-    aws_mem_acquire_many(allocator, 2, &hash, sizeof(struct aws_xxhash), &impl, sizeof(struct aws_xxhash_impl));
+static void s_xxhash_bind(
+    struct aws_xxhash *hash,
+    struct aws_allocator *allocator,
+    enum aws_xxhash_type type,
+    struct aws_xxhash_impl *impl) {
     hash->allocator = allocator;
-    hash->type = XXHASH3_64;
-
-    impl->state = state;
-    impl->update_fn = s_update_XXH3_64;
-    impl->finalize_fn = s_finalize_XXH3_64;
-    impl->state_free_fn = s_state_free_XXH3;
+    hash->type = type;
     hash->impl = impl;
+}
 
-    return hash;
+struct aws_xxhash *aws_xxhash_init_inplace(
+    struct aws_xxhash_inplace *storage,
+    enum aws_xxhash_type type,
+    uint64_t seed) {
+    AWS_PRECONDITION(storage);
 
-on_error:
-    XXH3_freeState(state);
-    return NULL;
+    if (type != XXHASH64 && type != XXHASH3_64 && type != XXHASH3_128) {
+        aws_raise_error(AWS_ERROR_INVALID_ARGUMENT);
+        return NULL;
+    }
+
+    s_xxhash_bind(&storage->hash, NULL, type, &storage->impl);
+    if (aws_xxhash_reset(&storage->hash, seed)) {
+        return NULL;
+    }
+    return &storage->hash;
 }
 
-struct aws_xxhash *aws_xxhash3_128_new(struct aws_allocator *allocator, uint64_t seed) {
-    XXH3_state_t *state = XXH3_createState();
+struct aws_xxhash *aws_xxhash3_tree_init_inplace(struct aws_xxhash_tree_inplace *storage, uint64_t seed) {
+    AWS_PRECONDITION(storage);
 
-    if (state == NULL) {
-        aws_raise_error(AWS_ERROR_INVALID_STATE);
+    s_xxhash_bind(&storage->hash, NULL, XXHASH3_TREE, &storage->impl.leaf);
+    if (aws_xxhash_reset(&storage->hash, seed)) {
         return NULL;
     }
+    return &storage->hash;
+}
+
+/*
+ * The wrapper and the state come from one allocation. The state needs 64 byte alignment, which the allocator doesn't
+ * promise, so the impl goes at the first aligned address after the wrapper. Only XXHASH3_TREE gets room for the
+ * struct aws_xxhash_tree_impl, whose first member is the struct aws_xxhash_impl every type uses.
+ */
+static struct aws_xxhash *s_xxhash_new(struct aws_allocator *allocator, enum aws_xxhash_type type, uint64_t seed) {
+    size_t impl_size = type == XXHASH3_TREE ? sizeof(struct aws_xxhash_tree_impl) : sizeof(struct aws_xxhash_impl);
+    uint8_t *block = aws_mem_acquire(allocator, sizeof(struct aws_xxhash) + XXHASH_STATE_ALIGNMENT - 1 + impl_size);
 
-    if (XXH3_128bits_reset_withSeed(state, seed) == XXH_ERROR) {
-        aws_raise_error(AWS_ERROR_INVALID_STATE);
-        goto on_error;
+    uintptr_t impl_address = (uintptr_t)(block + sizeof(struct aws_xxhash));
+    impl_address = (impl_address + XXHASH_STATE_ALIGNMENT - 1) & ~(uintptr_t)(XXHASH_STATE_ALIGNMENT - 1);
+
+    struct aws_xxhash *hash = (struct aws_xxhash *)block;
+    s_xxhash_bind(hash, allocator, type, (struct aws_xxhash_impl *)impl_address);
+    if (aws_xxhash_reset(hash, seed)) {
+        aws_mem_release(allocator, block);
+        return NULL;
     }
+    return hash;
+}
 
-    struct aws_xxhash *hash = NULL;
-    struct aws_xxhash_impl *impl = NULL;
+struct aws_xxhash *aws_xxhash64_new(struct aws_allocator *allocator, uint64_t seed) {
+    return s_xxhash_new(allocator, XXHASH64, seed);
+}
 
-    aws_mem_acquire_many(allocator, 2, &hash, sizeof(struct aws_xxhash), &impl, sizeof(struct aws_xxhash_impl));
-    hash->allocator = allocator;
-    hash->type = XXHASH3_128;
+struct aws_xxhash *aws_xxhash3_64_new(struct aws_allocator *allocator, uint64_t seed) {
+    return s_xxhash_new(allocator, XXHASH3_64, seed);
+}
 
-    impl->state = state;
-    impl->update_fn = s_update_XXH3_128;
-    impl->finalize_fn = s_finalize_XXH3_128;
-    impl->state_free_fn = s_state_free_XXH3; /* Same free as 64bit variant */
-    hash->impl = impl;
+struct aws_xxhash *aws_xxhash3_128_new(struct aws_allocator *allocator, uint64_t seed) {
+    return s_xxhash_new(allocator, XXHASH3_128, seed);
+}
 
-    return hash;
+struct aws_xxhash *aws_xxhash3_tree_new(struct aws_allocator *allocator, uint64_t seed) {
+    return s_xxhash_new(allocator, XXHASH3_TREE, seed);
+}
+
+int aws_xxhash_reset(struct aws_xxhash *hash, uint64_t seed) {
+    AWS_ERROR_PRECONDITION(hash);
 
-on_error:
-    XXH3_freeState(state);
-    return NULL;
+    if (hash->type == XXHASH3_TREE) {
+        return s_tree_reset(s_tree_impl(hash), seed);
+    }
+    return aws_xxhash_state_reset(&hash->impl->state, hash->type, seed);
 }
 
 int aws_xxhash_update(struct aws_xxhash *hash, struct aws_byte_cursor data) {
     AWS_ERROR_PRECONDITION(hash);
 
-    return hash->impl->update_fn(hash->impl->state, data);
+    if (hash->type == XXHASH3_TREE) {
+        return s_tree_update(s_tree_impl(hash), data);
+    }
+    return aws_xxhash_state_update(&hash->impl->state, hash->type, data);
 }
 
 int aws_xxhash_finalize(struct aws_xxhash *hash, struct aws_byte_buf *out) {
     AWS_ERROR_PRECONDITION(hash);
     AWS_ERROR_PRECONDITION(out);
 
-    return hash->impl->finalize_fn(hash->impl->state, out);
+    if (hash->type == XXHASH3_TREE) {
+        return s_tree_finalize(s_tree_impl(hash), out);
+    }
+    return aws_xxhash_state_finalize(&hash->impl->state, hash->type, out);
 }
 
 void aws_xxhash_destroy(struct aws_xxhash *hash) {
-    if (hash == NULL) {
+    /* in-place hashes have no allocator and nothing to free */
+    if (hash == NULL || hash->allocator == NULL) {
         return;
     }
 
-    hash->impl->state_free_fn(hash->impl->state);
     aws_mem_release(hash->allocator, hash);
 }
 
+/*
+ * Note: XXH64 is deliberately not dispatched. Its four lanes fit one YMM register, but every 32 byte stripe is a
+ * multiply, rotate, multiply chain per lane that depends on the previous stripe, so a single stream can't be spread
+ * over more lanes or stripes. That leaves vpmullq latency (15 cycles on Intel, vs 3 for scalar imul) on the critical
+ * path. An AVX-512DQ/VL kernel measured slower than the scalar loop even on AMD Zen, where vpmullq is cheap.
+ */
 int aws_xxhash64_compute(uint64_t seed, struct aws_byte_cursor data, struct aws_byte_buf *out) {
     XXH64_hash_t hash = XXH64(data.ptr, data.len, seed);
     if (!aws_byte_buf_write_be64(out, hash)) {
@@ -400,9 +733,9 @@ int aws_xxhash64_compute(uint64_t seed, struct aws_byte_cursor data, struct aws_
     return AWS_OP_SUCCESS;
 }
 
-#if defined(AWS_ARCH_INTEL_X64)
+#if defined(AWS_XXH_RUNTIME_DISPATCH)
 /* Note: wrapper to tweak interface that internal call expects. */
-static XXH64_hash_t s_x86_XXH3_64_seed_wrapper(
+static XXH64_hash_t s_dispatch_XXH3_64_seed_wrapper(
     const void *XXH_RESTRICT input,
     size_t len,
     XXH64_hash_t seed64,
@@ -410,28 +743,31 @@ static XXH64_hash_t s_x86_XXH3_64_seed_wrapper(
     size_t secretLen) {
     (void)secret;
     (void)secretLen;
-    AWS_FATAL_ASSERT(s_x86_XXH3_64_seed_compute);
-    return s_x86_XXH3_64_seed_compute(input, len, seed64);
+    AWS_FATAL_ASSERT(s_dispatch_XXH3_64_seed_compute);
+    return s_dispatch_XXH3_64_seed_compute(input, len, seed64);
 }
 #endif
 
-int aws_xxhash3_64_compute(uint64_t seed, struct aws_byte_cursor data, struct aws_byte_buf *out) {
-#if defined(AWS_ARCH_INTEL_X64)
-    XXH64_hash_t hash =
-        XXH3_64bits_internal(data.ptr, data.len, seed, XXH3_kSecret, sizeof(XXH3_kSecret), s_x86_XXH3_64_seed_wrapper);
+static XXH64_hash_t s_XXH3_64(uint64_t seed, struct aws_byte_cursor data) {
+#if defined(AWS_XXH_RUNTIME_DISPATCH)
+    return XXH3_64bits_internal(
+        data.ptr, data.len, seed, XXH3_kSecret, sizeof(XXH3_kSecret), s_dispatch_XXH3_64_seed_wrapper);
 #else
-    XXH64_hash_t hash = XXH3_64bits_withSeed(data.ptr, data.len, seed);
+    return XXH3_64bits_withSeed(data.ptr, data.len, seed);
 #endif
+}
 
+int aws_xxhash3_64_compute(uint64_t seed, struct aws_byte_cursor data, struct aws_byte_buf *out) {
+    XXH64_hash_t hash = s_XXH3_64(seed, data);
     if (!aws_byte_buf_write_be64(out, hash)) {
         return aws_raise_error(AWS_ERROR_INVALID_BUFFER_SIZE);
     }
     return AWS_OP_SUCCESS;
 }
 
-#if defined(AWS_ARCH_INTEL_X64)
+#if defined(AWS_XXH_RUNTIME_DISPATCH)
 /* Note: wrapper to tweak interface that internal call expects. */
-static XXH128_hash_t s_x86_XXH3_128_seed_wrapper(
+static XXH128_hash_t s_dispatch_XXH3_128_seed_wrapper(
     const void *input,
     size_t len,
     XXH64_hash_t seed64,
@@ -439,18 +775,293 @@ static XXH128_hash_t s_x86_XXH3_128_seed_wrapper(
     size_t secretLen) {
     (void)secret;
     (void)secretLen;
-    AWS_FATAL_ASSERT(s_x86_XXH3_128_seed_compute);
-    return s_x86_XXH3_128_seed_compute(input, len, seed64);
+    AWS_FATAL_ASSERT(s_dispatch_XXH3_128_seed_compute);
+    return s_dispatch_XXH3_128_seed_compute(input, len, seed64);
 }
 #endif
 
+static XXH128_hash_t s_XXH3_128(uint64_t seed, struct aws_byte_cursor data) {
+#if defined(AWS_XXH_RUNTIME_DISPATCH)
+    return XXH3_128bits_internal(
+        data.ptr, data.len, seed, XXH3_kSecret, sizeof(XXH3_kSecret), s_dispatch_XXH3_128_seed_wrapper);
+#else
+    return XXH3_128bits_withSeed(data.ptr, data.len, seed);
+#endif
+}
+
 int aws_xxhash3_128_compute(uint64_t seed, struct aws_byte_cursor data, struct aws_byte_buf *out) {
-#if defined(AWS_ARCH_INTEL_X64)
-    XXH128_hash_t hash = XXH3_128bits_internal(
-        data.ptr, data.len, seed, XXH3_kSecret, sizeof(XXH3_kSecret), s_x86_XXH3_128_seed_wrapper);
+    XXH128_hash_t hash = s_XXH3_128(seed, data);
+    if (out->capacity - out->len < 16) {
+        return aws_raise_error(AWS_ERROR_INVALID_BUFFER_SIZE);
+    }
+    aws_byte_buf_write_be64(out, hash.high64);
+    aws_byte_buf_write_be64(out, hash.low64);
+    return AWS_OP_SUCCESS;
+}
+
+struct tree_hash_job {
+    struct aws_byte_cursor data;
+    uint64_t seed;
+    size_t leaves_per_task;
+    size_t leaf_count;
+    /* 16 bytes per leaf, followed by the 8 byte total length, i.e. the input of the root hash */
+    uint8_t *root_input;
+};
+
+static void s_tree_hash_leaves(size_t task_index, void *user_data) {
+    struct tree_hash_job *job = user_data;
+    size_t first_leaf = task_index * job->leaves_per_task;
+    size_t end_leaf = aws_min_size(first_leaf + job->leaves_per_task, job->leaf_count);
+
+    for (size_t i = first_leaf; i < end_leaf; ++i) {
+        size_t offset = i * AWS_XXHASH3_TREE_LEAF_SIZE;
+        size_t length = aws_min_size(AWS_XXHASH3_TREE_LEAF_SIZE, job->data.len - offset);
+        XXH128_hash_t hash = s_XXH3_128(job->seed, aws_byte_cursor_from_array(job->data.ptr + offset, length));
+
+        struct aws_byte_buf digest = aws_byte_buf_from_empty_array(job->root_input + i * 16, 16);
+        aws_byte_buf_write_be64(&digest, hash.high64);
+        aws_byte_buf_write_be64(&digest, hash.low64);
+    }
+}
+
+int aws_xxhash3_tree_compute(
+    struct aws_allocator *allocator,
+    uint64_t seed,
+    struct aws_byte_cursor data,
+    const struct aws_checksums_parallel_options *options,
+    struct aws_byte_buf *out) {
+    AWS_ERROR_PRECONDITION(out);
+
+    if (data.ptr == NULL && data.len > 0) {
+        return aws_raise_error(AWS_ERROR_INVALID_ARGUMENT);
+    }
+    if (out->capacity - out->len < 16) {
+        return aws_raise_error(AWS_ERROR_INVALID_BUFFER_SIZE);
+    }
+
+    size_t chunk_size = options != NULL && options->chunk_size != 0 ? options->chunk_size
+                                                                    : AWS_CHECKSUMS_PARALLEL_DEFAULT_CHUNK_SIZE;
+    struct tree_hash_job job = {
+        .data = data,
+        .seed = seed,
+        .leaves_per_task = aws_max_size(chunk_size / AWS_XXHASH3_TREE_LEAF_SIZE, 1),
+        .leaf_count = (data.len + AWS_XXHASH3_TREE_LEAF_SIZE - 1) / AWS_XXHASH3_TREE_LEAF_SIZE,
+    };
+    size_t root_input_size = job.leaf_count * 16 + 8;
+    job.root_input = aws_mem_acquire(allocator, root_input_size);
+
+    size_t task_count = (job.leaf_count + job.leaves_per_task - 1) / job.leaves_per_task;
+    if (data.len / 2 < chunk_size) {
+        for (size_t i = 0; i < task_count; ++i) {
+            s_tree_hash_leaves(i, &job);
+        }
+    } else {
+        aws_checksums_parallel_for(allocator, options, task_count, s_tree_hash_leaves, &job);
+    }
+
+    struct aws_byte_buf length = aws_byte_buf_from_empty_array(job.root_input + job.leaf_count * 16, 8);
+    aws_byte_buf_write_be64(&length, data.len);
+    XXH128_hash_t hash = s_XXH3_128(seed, aws_byte_cursor_from_array(job.root_input, root_input_size));
+    aws_mem_release(allocator, job.root_input);
+
+    aws_byte_buf_write_be64(out, hash.high64);
+    aws_byte_buf_write_be64(out, hash.low64);
+    return AWS_OP_SUCCESS;
+}
+
+/*
+ * Note: keys are hashed one after another rather than across SIMD lanes. Short XXH3 and XXH64 inputs take a chain of
+ * 64 bit multiplies whose shape depends on the key length, so lanes of mixed length keys can't share instructions.
+ * What the batch saves is the per-key call, cursor and output buffer overhead, and the independent chains of
+ * consecutive keys overlap in the cpu's pipeline.
+ */
+void aws_xxhash64_batch(const struct aws_byte_cursor *keys, uint64_t seed, uint64_t *out, size_t n) {
+    AWS_PRECONDITION(n == 0 || (keys && out));
+
+    for (size_t i = 0; i < n; ++i) {
+        out[i] = XXH64(keys[i].ptr, keys[i].len, seed);
+    }
+}
+
+void aws_xxhash3_64_batch(const struct aws_byte_cursor *keys, uint64_t seed, uint64_t *out, size_t n) {
+    AWS_PRECONDITION(n == 0 || (keys && out));
+
+    for (size_t i = 0; i < n; ++i) {
+        out[i] = s_XXH3_64(seed, keys[i]);
+    }
+}
+
+AWS_STATIC_ASSERT(AWS_XXHASH3_SECRET_SIZE == XXH3_SECRET_DEFAULT_SIZE);
+
+void aws_xxhash3_seeded_hasher_init(struct aws_xxhash3_seeded_hasher *hasher, uint64_t seed) {
+    AWS_PRECONDITION(hasher);
+
+    hasher->seed = seed;
+    XXH3_generateSecret_fromSeed(hasher->secret, seed);
+}
+
+/*
+ * Inputs up to XXH3_MIDSIZE_MAX only use the seed, longer ones only the secret derived from it, which is exactly what
+ * the *_withSeed() functions would derive on every call.
+ */
+static XXH64_hash_t s_XXH3_64_seeded(const struct aws_xxhash3_seeded_hasher *hasher, struct aws_byte_cursor data) {
+#if defined(AWS_XXH_RUNTIME_DISPATCH)
+    if (data.len > XXH3_MIDSIZE_MAX) {
+        AWS_FATAL_ASSERT(s_dispatch_XXH3_64_secret_compute);
+        return s_dispatch_XXH3_64_secret_compute(data.ptr, data.len, hasher->secret, sizeof(hasher->secret));
+    }
+#endif
+    return XXH3_64bits_withSecretandSeed(data.ptr, data.len, hasher->secret, sizeof(hasher->secret), hasher->seed);
+}
+
+static XXH128_hash_t s_XXH3_128_seeded(const struct aws_xxhash3_seeded_hasher *hasher, struct aws_byte_cursor data) {
+#if defined(AWS_XXH_RUNTIME_DISPATCH)
+    if (data.len > XXH3_MIDSIZE_MAX) {
+        AWS_FATAL_ASSERT(s_dispatch_XXH3_128_secret_compute);
+        return s_dispatch_XXH3_128_secret_compute(data.ptr, data.len, hasher->secret, sizeof(hasher->secret));
+    }
+#endif
+    return XXH3_128bits_withSecretandSeed(data.ptr, data.len, hasher->secret, sizeof(hasher->secret), hasher->seed);
+}
+
+int aws_xxhash3_64_compute_seeded(
+    const struct aws_xxhash3_seeded_hasher *hasher,
+    struct aws_byte_cursor data,
+    struct aws_byte_buf *out) {
+    AWS_ERROR_PRECONDITION(hasher);
+    AWS_ERROR_PRECONDITION(out);
+
+    XXH64_hash_t hash = s_XXH3_64_seeded(hasher, data);
+    if (!aws_byte_buf_write_be64(out, hash)) {
+        return aws_raise_error(AWS_ERROR_INVALID_BUFFER_SIZE);
+    }
+    return AWS_OP_SUCCESS;
+}
+
+int aws_xxhash3_128_compute_seeded(
+    const struct aws_xxhash3_seeded_hasher *hasher,
+    struct aws_byte_cursor data,
+    struct aws_byte_buf *out) {
+    AWS_ERROR_PRECONDITION(hasher);
+    AWS_ERROR_PRECONDITION(out);
+
+    XXH128_hash_t hash = s_XXH3_128_seeded(hasher, data);
+    if (out->capacity - out->len < 16) {
+        return aws_raise_error(AWS_ERROR_INVALID_BUFFER_SIZE);
+    }
+    aws_byte_buf_write_be64(out, hash.high64);
+    aws_byte_buf_write_be64(out, hash.low64);
+    return AWS_OP_SUCCESS;
+}
+
+int aws_xxhash_reset_seeded(struct aws_xxhash *hash, const struct aws_xxhash3_seeded_hasher *hasher) {
+    AWS_ERROR_PRECONDITION(hash);
+    AWS_ERROR_PRECONDITION(hasher);
+
+    XXH3_state_t *state = (XXH3_state_t *)&hash->impl->state;
+    XXH_errorcode result = XXH_ERROR;
+    switch (hash->type) {
+        case XXHASH3_64:
+            result = XXH3_64bits_reset_withSecretandSeed(state, hasher->secret, sizeof(hasher->secret), hasher->seed);
+            break;
+        case XXHASH3_128:
+            result = XXH3_128bits_reset_withSecretandSeed(state, hasher->secret, sizeof(hasher->secret), hasher->seed);
+            break;
+        default:
+            /* XXH64 has no secret, and the tree hash only takes a seed */
+            return aws_raise_error(AWS_ERROR_INVALID_ARGUMENT);
+    }
+
+    if (result == XXH_ERROR) {
+        return aws_raise_error(AWS_ERROR_INVALID_STATE);
+    }
+    return AWS_OP_SUCCESS;
+}
+
+AWS_STATIC_ASSERT(AWS_XXHASH3_SECRET_SIZE_MIN == XXH3_SECRET_SIZE_MIN);
+
+int aws_xxhash3_generate_secret(struct aws_byte_cursor key_material, size_t secret_size, struct aws_byte_buf *out) {
+    AWS_ERROR_PRECONDITION(out);
+
+    if (secret_size < AWS_XXHASH3_SECRET_SIZE_MIN) {
+        return aws_raise_error(AWS_ERROR_INVALID_ARGUMENT);
+    }
+    if (out->capacity - out->len < secret_size) {
+        return aws_raise_error(AWS_ERROR_INVALID_BUFFER_SIZE);
+    }
+
+    if (XXH3_generateSecret(out->buffer + out->len, secret_size, key_material.ptr, key_material.len) == XXH_ERROR) {
+        return aws_raise_error(AWS_ERROR_INVALID_ARGUMENT);
+    }
+    out->len += secret_size;
+    return AWS_OP_SUCCESS;
+}
+
+#if defined(AWS_XXH_RUNTIME_DISPATCH)
+/* Note: wrapper to tweak interface that internal call expects. */
+static XXH64_hash_t s_dispatch_XXH3_64_secret_wrapper(
+    const void *XXH_RESTRICT input,
+    size_t len,
+    XXH64_hash_t seed64,
+    const xxh_u8 *XXH_RESTRICT secret,
+    size_t secretLen) {
+    (void)seed64;
+    AWS_FATAL_ASSERT(s_dispatch_XXH3_64_secret_compute);
+    return s_dispatch_XXH3_64_secret_compute(input, len, secret, secretLen);
+}
+
+static XXH128_hash_t s_dispatch_XXH3_128_secret_wrapper(
+    const void *input,
+    size_t len,
+    XXH64_hash_t seed64,
+    const void *secret,
+    size_t secretLen) {
+    (void)seed64;
+    AWS_FATAL_ASSERT(s_dispatch_XXH3_128_secret_compute);
+    return s_dispatch_XXH3_128_secret_compute(input, len, secret, secretLen);
+}
+#endif
+
+int aws_xxhash3_64_compute_with_secret(
+    struct aws_byte_cursor secret,
+    struct aws_byte_cursor data,
+    struct aws_byte_buf *out) {
+    AWS_ERROR_PRECONDITION(out);
+
+    if (secret.len < AWS_XXHASH3_SECRET_SIZE_MIN) {
+        return aws_raise_error(AWS_ERROR_INVALID_ARGUMENT);
+    }
+
+#if defined(AWS_XXH_RUNTIME_DISPATCH)
+    XXH64_hash_t hash =
+        XXH3_64bits_internal(data.ptr, data.len, 0, secret.ptr, secret.len, s_dispatch_XXH3_64_secret_wrapper);
+#else
+    XXH64_hash_t hash = XXH3_64bits_withSecret(data.ptr, data.len, secret.ptr, secret.len);
+#endif
+
+    if (!aws_byte_buf_write_be64(out, hash)) {
+        return aws_raise_error(AWS_ERROR_INVALID_BUFFER_SIZE);
+    }
+    return AWS_OP_SUCCESS;
+}
+
+int aws_xxhash3_128_compute_with_secret(
+    struct aws_byte_cursor secret,
+    struct aws_byte_cursor data,
+    struct aws_byte_buf *out) {
+    AWS_ERROR_PRECONDITION(out);
+
+    if (secret.len < AWS_XXHASH3_SECRET_SIZE_MIN) {
+        return aws_raise_error(AWS_ERROR_INVALID_ARGUMENT);
+    }
+
+#if defined(AWS_XXH_RUNTIME_DISPATCH)
+    XXH128_hash_t hash =
+        XXH3_128bits_internal(data.ptr, data.len, 0, secret.ptr, secret.len, s_dispatch_XXH3_128_secret_wrapper);
 #else
-    XXH128_hash_t hash = XXH3_128bits_withSeed(data.ptr, data.len, seed);
+    XXH128_hash_t hash = XXH3_128bits_withSecret(data.ptr, data.len, secret.ptr, secret.len);
 #endif
+
     if (out->capacity - out->len < 16) {
         return aws_raise_error(AWS_ERROR_INVALID_BUFFER_SIZE);
     }
@@ -458,3 +1069,30 @@ int aws_xxhash3_128_compute(uint64_t seed, struct aws_byte_cursor data, struct a
     aws_byte_buf_write_be64(out, hash.low64);
     return AWS_OP_SUCCESS;
 }
+
+int aws_xxhash_reset_with_secret(struct aws_xxhash *hash, struct aws_byte_cursor secret) {
+    AWS_ERROR_PRECONDITION(hash);
+
+    if (secret.len < AWS_XXHASH3_SECRET_SIZE_MIN) {
+        return aws_raise_error(AWS_ERROR_INVALID_ARGUMENT);
+    }
+
+    XXH3_state_t *state = (XXH3_state_t *)&hash->impl->state;
+    XXH_errorcode result = XXH_ERROR;
+    switch (hash->type) {
+        case XXHASH3_64:
+            result = XXH3_64bits_reset_withSecret(state, secret.ptr, secret.len);
+            break;
+        case XXHASH3_128:
+            result = XXH3_128bits_reset_withSecret(state, secret.ptr, secret.len);
+            break;
+        default:
+            /* XXH64 has no secret, and the tree hash only takes a seed */
+            return aws_raise_error(AWS_ERROR_INVALID_ARGUMENT);
+    }
+
+    if (result == XXH_ERROR) {
+        return aws_raise_error(AWS_ERROR_INVALID_STATE);
+    }
+    return AWS_OP_SUCCESS;
+}
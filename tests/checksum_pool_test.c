@@ -0,0 +1,167 @@
+/**
+ * Copyright Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0.
+ */
+
+#include <aws/checksums/checksum_pool.h>
+#include <aws/checksums/checksums.h>
+
+#include <aws/common/thread.h>
+#include <aws/testing/aws_test_harness.h>
+
+#define POOL_TEST_THREADS 4
+#define POOL_TEST_STREAMS 100
+#define POOL_TEST_ITERATIONS 50
+
+static const char *TEST_VECTOR = "abcdefghijklmnopqrstuvwxyz";
+
+static int s_expected(enum aws_checksum_algorithm algorithm, uint64_t seed, struct aws_byte_buf *out) {
+    return aws_checksum_compute(algorithm, seed, aws_byte_cursor_from_c_str(TEST_VECTOR), out);
+}
+
+static int s_test_checksum_pool(struct aws_allocator *allocator, void *ctx) {
+    (void)ctx;
+
+    aws_checksums_library_init(allocator);
+
+    const uint64_t seed = 0x1234;
+    for (size_t a = 0; a < AWS_CHECKSUM_ALGORITHM_COUNT; ++a) {
+        enum aws_checksum_algorithm algorithm = (enum aws_checksum_algorithm)a;
+        uint8_t expected_storage[AWS_CHECKSUM_MAX_DIGEST_SIZE] = {0};
+        struct aws_byte_buf expected = aws_byte_buf_from_empty_array(expected_storage, sizeof(expected_storage));
+        ASSERT_SUCCESS(s_expected(algorithm, seed, &expected));
+
+        struct aws_checksum_pool *pool = aws_checksum_pool_new(allocator, algorithm, seed);
+        ASSERT_NOT_NULL(pool);
+
+        /* more streams open at once than one slab or thread cache holds */
+        struct aws_checksum *streams[POOL_TEST_STREAMS * 2];
+        for (size_t round = 0; round < 3; ++round) {
+            for (size_t i = 0; i < AWS_ARRAY_SIZE(streams); ++i) {
+                streams[i] = aws_checksum_pool_acquire(pool);
+                ASSERT_NOT_NULL(streams[i]);
+                ASSERT_UINT_EQUALS(0, (uintptr_t)streams[i] % 64);
+                ASSERT_SUCCESS(aws_checksum_update(streams[i], aws_byte_cursor_from_c_str(TEST_VECTOR)));
+            }
+            for (size_t i = 0; i < AWS_ARRAY_SIZE(streams); ++i) {
+                uint8_t digest_storage[AWS_CHECKSUM_MAX_DIGEST_SIZE] = {0};
+                struct aws_byte_buf digest = aws_byte_buf_from_empty_array(digest_storage, sizeof(digest_storage));
+                if (i % 3 == 0) {
+                    aws_checksum_pool_release(pool, streams[i]);
+                    continue;
+                }
+                ASSERT_SUCCESS(aws_checksum_pool_finalize(pool, streams[i], &digest));
+                ASSERT_BIN_ARRAYS_EQUALS(expected.buffer, expected.len, digest.buffer, digest.len);
+            }
+        }
+
+        /* the most recently released context is handed out again first */
+        struct aws_checksum *checksum = aws_checksum_pool_acquire(pool);
+        aws_checksum_pool_release(pool, checksum);
+        ASSERT_PTR_EQUALS(checksum, aws_checksum_pool_acquire(pool));
+
+        /* a failed finalize still recycles the context, reset */
+        ASSERT_SUCCESS(aws_checksum_update(checksum, aws_byte_cursor_from_c_str("garbage")));
+        struct aws_byte_buf too_small = aws_byte_buf_from_empty_array(expected_storage, 1);
+        ASSERT_ERROR(AWS_ERROR_INVALID_BUFFER_SIZE, aws_checksum_pool_finalize(pool, checksum, &too_small));
+        checksum = aws_checksum_pool_acquire(pool);
+        ASSERT_SUCCESS(aws_checksum_update(checksum, aws_byte_cursor_from_c_str(TEST_VECTOR)));
+        uint8_t digest_storage[AWS_CHECKSUM_MAX_DIGEST_SIZE] = {0};
+        struct aws_byte_buf digest = aws_byte_buf_from_empty_array(digest_storage, sizeof(digest_storage));
+        ASSERT_SUCCESS(aws_checksum_pool_finalize(pool, checksum, &digest));
+        ASSERT_BIN_ARRAYS_EQUALS(expected.buffer, expected.len, digest.buffer, digest.len);
+
+        aws_checksum_pool_release(pool, NULL);
+        aws_checksum_pool_destroy(pool);
+    }
+
+    aws_checksum_pool_destroy(NULL);
+    ASSERT_NULL(aws_checksum_pool_new(allocator, AWS_CHECKSUM_ALGORITHM_COUNT, 0));
+    ASSERT_INT_EQUALS(AWS_ERROR_INVALID_ARGUMENT, aws_last_error());
+
+    aws_checksums_library_clean_up();
+
+    return AWS_OP_SUCCESS;
+}
+AWS_TEST_CASE(test_checksum_pool, s_test_checksum_pool)
+
+struct pool_thread_data {
+    struct aws_checksum_pool *pools[2];
+    struct aws_byte_buf *expected;
+    /* contexts acquired by the previous thread and released by this one */
+    struct aws_checksum *handoff[POOL_TEST_STREAMS];
+    bool failed;
+};
+
+static void s_pool_thread(void *arg) {
+    struct pool_thread_data *data = arg;
+
+    for (size_t i = 0; i < POOL_TEST_STREAMS; ++i) {
+        aws_checksum_pool_release(data->pools[0], data->handoff[i]);
+    }
+
+    for (size_t iteration = 0; iteration < POOL_TEST_ITERATIONS; ++iteration) {
+        for (size_t p = 0; p < AWS_ARRAY_SIZE(data->pools); ++p) {
+            struct aws_checksum *streams[POOL_TEST_STREAMS];
+            for (size_t i = 0; i < POOL_TEST_STREAMS; ++i) {
+                streams[i] = aws_checksum_pool_acquire(data->pools[p]);
+                aws_checksum_update(streams[i], aws_byte_cursor_from_c_str(TEST_VECTOR));
+            }
+            for (size_t i = 0; i < POOL_TEST_STREAMS; ++i) {
+                uint8_t digest_storage[AWS_CHECKSUM_MAX_DIGEST_SIZE] = {0};
+                struct aws_byte_buf digest = aws_byte_buf_from_empty_array(digest_storage, sizeof(digest_storage));
+                if (aws_checksum_pool_finalize(data->pools[p], streams[i], &digest) ||
+                    !aws_byte_buf_eq(&digest, &data->expected[p])) {
+                    data->failed = true;
+                }
+            }
+        }
+    }
+}
+
+static int s_test_checksum_pool_threads(struct aws_allocator *allocator, void *ctx) {
+    (void)ctx;
+
+    aws_checksums_library_init(allocator);
+
+    const enum aws_checksum_algorithm algorithms[] = {AWS_CHECKSUM_XXHASH3_64, AWS_CHECKSUM_CRC32C};
+    uint8_t expected_storage[2][AWS_CHECKSUM_MAX_DIGEST_SIZE] = {{0}};
+    struct aws_byte_buf expected[2];
+    struct aws_checksum_pool *pools[2];
+    for (size_t p = 0; p < 2; ++p) {
+        expected[p] = aws_byte_buf_from_empty_array(expected_storage[p], sizeof(expected_storage[p]));
+        ASSERT_SUCCESS(s_expected(algorithms[p], 7, &expected[p]));
+        pools[p] = aws_checksum_pool_new(allocator, algorithms[p], 7);
+        ASSERT_NOT_NULL(pools[p]);
+    }
+
+    struct pool_thread_data data[POOL_TEST_THREADS];
+    AWS_ZERO_ARRAY(data);
+    for (size_t t = 0; t < POOL_TEST_THREADS; ++t) {
+        data[t].pools[0] = pools[0];
+        data[t].pools[1] = pools[1];
+        data[t].expected = expected;
+        for (size_t i = 0; i < POOL_TEST_STREAMS; ++i) {
+            data[t].handoff[i] = aws_checksum_pool_acquire(pools[0]);
+        }
+    }
+
+    struct aws_thread threads[POOL_TEST_THREADS];
+    for (size_t t = 0; t < POOL_TEST_THREADS; ++t) {
+        ASSERT_SUCCESS(aws_thread_init(&threads[t], allocator));
+        ASSERT_SUCCESS(aws_thread_launch(&threads[t], s_pool_thread, &data[t], aws_default_thread_options()));
+    }
+    for (size_t t = 0; t < POOL_TEST_THREADS; ++t) {
+        ASSERT_SUCCESS(aws_thread_join(&threads[t]));
+        aws_thread_clean_up(&threads[t]);
+        ASSERT_FALSE(data[t].failed);
+    }
+
+    aws_checksum_pool_destroy(pools[0]);
+    aws_checksum_pool_destroy(pools[1]);
+
+    aws_checksums_library_clean_up();
+
+    return AWS_OP_SUCCESS;
+}
+AWS_TEST_CASE(test_checksum_pool_threads, s_test_checksum_pool_threads)
@@ -0,0 +1,138 @@
+/**
+ * Copyright Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0.
+ */
+
+#include <aws/checksums/checksum.h>
+#include <aws/checksums/checksums.h>
+#include <aws/checksums/crc.h>
+#include <aws/checksums/xxhash.h>
+#include <aws/testing/aws_test_harness.h>
+
+#define TEST_BUFFER_SIZE (10 * 1024 + 3)
+
+static int s_expected_digest(
+    enum aws_checksum_algorithm algorithm,
+    uint64_t seed,
+    struct aws_byte_cursor input,
+    struct aws_byte_buf *out) {
+
+    switch (algorithm) {
+        case AWS_CHECKSUM_CRC32:
+            aws_byte_buf_write_be32(out, aws_checksums_crc32_ex(input.ptr, input.len, (uint32_t)seed));
+            return AWS_OP_SUCCESS;
+        case AWS_CHECKSUM_CRC32C:
+            aws_byte_buf_write_be32(out, aws_checksums_crc32c_ex(input.ptr, input.len, (uint32_t)seed));
+            return AWS_OP_SUCCESS;
+        case AWS_CHECKSUM_CRC64NVME:
+            aws_byte_buf_write_be64(out, aws_checksums_crc64nvme_ex(input.ptr, input.len, seed));
+            return AWS_OP_SUCCESS;
+        case AWS_CHECKSUM_XXHASH64:
+            return aws_xxhash64_compute(seed, input, out);
+        case AWS_CHECKSUM_XXHASH3_64:
+            return aws_xxhash3_64_compute(seed, input, out);
+        case AWS_CHECKSUM_XXHASH3_128:
+            return aws_xxhash3_128_compute(seed, input, out);
+        default:
+            return AWS_OP_ERR;
+    }
+}
+
+static int s_check_digest(struct aws_checksum *checksum, const struct aws_byte_buf *expected) {
+    uint8_t digest_storage[AWS_CHECKSUM_MAX_DIGEST_SIZE] = {0};
+    struct aws_byte_buf digest = aws_byte_buf_from_empty_array(digest_storage, sizeof(digest_storage));
+    ASSERT_SUCCESS(aws_checksum_finalize(checksum, &digest));
+    ASSERT_BIN_ARRAYS_EQUALS(expected->buffer, expected->len, digest.buffer, digest.len);
+    return AWS_OP_SUCCESS;
+}
+
+static int s_test_checksum_streaming(struct aws_allocator *allocator, void *ctx) {
+    (void)ctx;
+
+    aws_checksums_library_init(allocator);
+
+    uint8_t *buffer = aws_mem_acquire(allocator, TEST_BUFFER_SIZE);
+    for (size_t i = 0; i < TEST_BUFFER_SIZE; ++i) {
+        buffer[i] = (uint8_t)(i * 151 + 13);
+    }
+    struct aws_byte_cursor input = aws_byte_cursor_from_array(buffer, TEST_BUFFER_SIZE);
+    const uint64_t seeds[] = {0, 0xDEADBEEF, 0x0123456789ABCDEF};
+
+    for (size_t a = 0; a < AWS_CHECKSUM_ALGORITHM_COUNT; ++a) {
+        enum aws_checksum_algorithm algorithm = (enum aws_checksum_algorithm)a;
+        for (size_t s = 0; s < AWS_ARRAY_SIZE(seeds); ++s) {
+            uint8_t expected_storage[AWS_CHECKSUM_MAX_DIGEST_SIZE] = {0};
+            struct aws_byte_buf expected = aws_byte_buf_from_empty_array(expected_storage, sizeof(expected_storage));
+            ASSERT_SUCCESS(s_expected_digest(algorithm, seeds[s], input, &expected));
+            ASSERT_UINT_EQUALS(aws_checksum_digest_size(algorithm), expected.len);
+
+            /* streamed in uneven pieces, from a stack allocated checksum */
+            struct aws_checksum checksum;
+            ASSERT_SUCCESS(aws_checksum_init(&checksum, algorithm, seeds[s]));
+            ASSERT_UINT_EQUALS(0, (uintptr_t)&checksum.state.xxhash % 64);
+            struct aws_byte_cursor remaining = input;
+            const size_t pieces[] = {0, 1, 63, 240, 4 * 1024 + 5};
+            for (size_t i = 0; i < AWS_ARRAY_SIZE(pieces); ++i) {
+                ASSERT_SUCCESS(aws_checksum_update(&checksum, aws_byte_cursor_advance(&remaining, pieces[i])));
+            }
+
+            /* a copy continues independently of the original */
+            struct aws_checksum copy = checksum;
+            ASSERT_SUCCESS(aws_checksum_update(&checksum, remaining));
+            ASSERT_SUCCESS(s_check_digest(&checksum, &expected));
+            ASSERT_SUCCESS(aws_checksum_update(&copy, remaining));
+            ASSERT_SUCCESS(s_check_digest(&copy, &expected));
+
+            /* reset starts over with the same seed */
+            ASSERT_SUCCESS(aws_checksum_reset(&checksum));
+            ASSERT_SUCCESS(aws_checksum_update(&checksum, input));
+            ASSERT_SUCCESS(s_check_digest(&checksum, &expected));
+
+            uint8_t computed_storage[AWS_CHECKSUM_MAX_DIGEST_SIZE] = {0};
+            struct aws_byte_buf computed = aws_byte_buf_from_empty_array(computed_storage, sizeof(computed_storage));
+            ASSERT_SUCCESS(aws_checksum_compute(algorithm, seeds[s], input, &computed));
+            ASSERT_BIN_ARRAYS_EQUALS(expected.buffer, expected.len, computed.buffer, computed.len);
+        }
+    }
+
+    aws_mem_release(allocator, buffer);
+    aws_checksums_library_clean_up();
+
+    return AWS_OP_SUCCESS;
+}
+AWS_TEST_CASE(test_checksum_streaming, s_test_checksum_streaming)
+
+static int s_test_checksum_invalid(struct aws_allocator *allocator, void *ctx) {
+    (void)ctx;
+
+    aws_checksums_library_init(allocator);
+
+    struct aws_checksum checksum;
+    ASSERT_ERROR(
+        AWS_ERROR_INVALID_ARGUMENT,
+        aws_checksum_init(&checksum, (enum aws_checksum_algorithm)AWS_CHECKSUM_ALGORITHM_COUNT, 0));
+    ASSERT_UINT_EQUALS(0, aws_checksum_digest_size((enum aws_checksum_algorithm)AWS_CHECKSUM_ALGORITHM_COUNT));
+
+    uint8_t digest_storage[AWS_CHECKSUM_MAX_DIGEST_SIZE] = {0};
+    for (size_t a = 0; a < AWS_CHECKSUM_ALGORITHM_COUNT; ++a) {
+        enum aws_checksum_algorithm algorithm = (enum aws_checksum_algorithm)a;
+        ASSERT_SUCCESS(aws_checksum_init(&checksum, algorithm, 0));
+
+        size_t digest_size = aws_checksum_digest_size(algorithm);
+        struct aws_byte_buf digest = aws_byte_buf_from_empty_array(digest_storage, digest_size - 1);
+        ASSERT_ERROR(AWS_ERROR_INVALID_BUFFER_SIZE, aws_checksum_finalize(&checksum, &digest));
+        ASSERT_UINT_EQUALS(0, digest.len);
+        ASSERT_ERROR(
+            AWS_ERROR_INVALID_BUFFER_SIZE,
+            aws_checksum_compute(algorithm, 0, aws_byte_cursor_from_c_str("abc"), &digest));
+
+        digest.capacity = digest_size;
+        ASSERT_SUCCESS(aws_checksum_finalize(&checksum, &digest));
+        ASSERT_UINT_EQUALS(digest_size, digest.len);
+    }
+
+    aws_checksums_library_clean_up();
+
+    return AWS_OP_SUCCESS;
+}
+AWS_TEST_CASE(test_checksum_invalid, s_test_checksum_invalid)
@@ -204,3 +204,327 @@ static int s_test_crc64nvme_combine(struct aws_allocator *allocator, void *ctx)
     return AWS_OP_SUCCESS;
 }
 AWS_TEST_CASE(test_crc64nvme_combine, s_test_crc64nvme_combine)
+
+static int s_test_crc64nvme_zero_extend(struct aws_allocator *allocator, void *ctx) {
+    (void)ctx;
+
+    aws_checksums_library_init(allocator);
+
+    const size_t prefix_len = 37;
+    const size_t zero_counts[] = {0, 1, 7, 8, 9, 255, 4096, 65536 + 7};
+    uint8_t *buffer = aws_mem_calloc(allocator, prefix_len + 65536 + 7, 1);
+    for (size_t i = 0; i < prefix_len; ++i) {
+        buffer[i] = (uint8_t)(i * 151 + 13);
+    }
+
+    for (size_t i = 0; i < AWS_ARRAY_SIZE(zero_counts); ++i) {
+        size_t total = prefix_len + zero_counts[i];
+        ASSERT_HEX_EQUALS(
+            aws_checksums_crc64nvme_ex(buffer, total, 0),
+            aws_checksums_crc64nvme_zero_extend(aws_checksums_crc64nvme_ex(buffer, prefix_len, 0), zero_counts[i]));
+    }
+
+    /* same as test_large_buffer_crc64, without the 3GB buffer */
+    ASSERT_HEX_EQUALS(0xa1dddd7c6fd17075, aws_checksums_crc64nvme_zero_extend(0, 3 * 1024 * 1024 * 1024ULL));
+
+    aws_mem_release(allocator, buffer);
+    aws_checksums_library_clean_up();
+
+    return AWS_OP_SUCCESS;
+}
+AWS_TEST_CASE(test_crc64nvme_zero_extend, s_test_crc64nvme_zero_extend)
+
+static int s_test_crc64nvme_uncombine(struct aws_allocator *allocator, void *ctx) {
+    (void)ctx;
+
+    aws_checksums_library_init(allocator);
+
+    const size_t total = 4096 + 13;
+    const size_t split_points[] = {0, 1, 7, 8, 255, 1024, 4096, 4096 + 12, 4096 + 13};
+    uint8_t *buffer = aws_mem_acquire(allocator, total);
+    for (size_t i = 0; i < total; ++i) {
+        buffer[i] = (uint8_t)(i * 149 + 5);
+    }
+
+    const uint64_t crc_ab = aws_checksums_crc64nvme_ex(buffer, total, 0);
+    for (size_t i = 0; i < AWS_ARRAY_SIZE(split_points); ++i) {
+        const size_t len_a = split_points[i];
+        const size_t len_b = total - len_a;
+        const uint64_t crc_a = aws_checksums_crc64nvme_ex(buffer, len_a, 0);
+        const uint64_t crc_b = aws_checksums_crc64nvme_ex(buffer + len_a, len_b, 0);
+        ASSERT_HEX_EQUALS(crc_a, aws_checksums_crc64nvme_uncombine_suffix(crc_ab, crc_b, len_b), "split %zu", len_a);
+        ASSERT_HEX_EQUALS(crc_b, aws_checksums_crc64nvme_uncombine_prefix(crc_ab, crc_a, len_b), "split %zu", len_a);
+    }
+
+    /* lengths too large to checksum here, round tripped through combine */
+    const uint64_t large_lengths[] = {1ULL << 32, 3 * 1024 * 1024 * 1024ULL + 5, UINT64_MAX / 3};
+    const uint64_t crc_a = aws_checksums_crc64nvme_ex(buffer, 17, 0);
+    const uint64_t crc_b = aws_checksums_crc64nvme_ex(buffer + 17, 29, 0);
+    for (size_t i = 0; i < AWS_ARRAY_SIZE(large_lengths); ++i) {
+        uint64_t combined = aws_checksums_crc64nvme_combine(crc_a, crc_b, large_lengths[i]);
+        ASSERT_HEX_EQUALS(crc_a, aws_checksums_crc64nvme_uncombine_suffix(combined, crc_b, large_lengths[i]));
+        ASSERT_HEX_EQUALS(crc_b, aws_checksums_crc64nvme_uncombine_prefix(combined, crc_a, large_lengths[i]));
+    }
+
+    /* stripping 3GB of zeros, see test_crc64nvme_zero_extend */
+    ASSERT_HEX_EQUALS(
+        0, aws_checksums_crc64nvme_uncombine_suffix(0xa1dddd7c6fd17075, 0xa1dddd7c6fd17075, 3 * 1024 * 1024 * 1024ULL));
+
+    aws_mem_release(allocator, buffer);
+    aws_checksums_library_clean_up();
+
+    return AWS_OP_SUCCESS;
+}
+AWS_TEST_CASE(test_crc64nvme_uncombine, s_test_crc64nvme_uncombine)
+
+static int s_test_crc64nvme_patch(struct aws_allocator *allocator, void *ctx) {
+    (void)ctx;
+
+    aws_checksums_library_init(allocator);
+
+    const size_t total = 3 * 4096 + 29;
+    /* {offset, len}, including empty ranges, both ends and ranges larger than the internal staging buffer */
+    const size_t ranges[][2] = {
+        {0, 0}, {0, 1}, {0, 17}, {100, 1}, {100, 4096 + 5}, {total - 1, 1}, {total - 64, 64}, {0, total}, {5, 0}};
+    uint8_t *buffer = aws_mem_acquire(allocator, total);
+    uint8_t *old_bytes = aws_mem_acquire(allocator, total);
+    for (size_t i = 0; i < total; ++i) {
+        buffer[i] = (uint8_t)(i * 167 + 3);
+    }
+
+    for (size_t r = 0; r < AWS_ARRAY_SIZE(ranges); ++r) {
+        const size_t offset = ranges[r][0];
+        const size_t len = ranges[r][1];
+        const uint64_t old_crc = aws_checksums_crc64nvme_ex(buffer, total, 0);
+
+        memcpy(old_bytes, buffer + offset, len);
+        for (size_t i = 0; i < len; ++i) {
+            buffer[offset + i] = (uint8_t)(buffer[offset + i] * 31 + r);
+        }
+
+        ASSERT_HEX_EQUALS(
+            aws_checksums_crc64nvme_ex(buffer, total, 0),
+            aws_checksums_crc64nvme_patch(old_crc, total, offset, old_bytes, buffer + offset, len),
+            "offset %zu len %zu",
+            offset,
+            len);
+    }
+
+    aws_mem_release(allocator, old_bytes);
+    aws_mem_release(allocator, buffer);
+    aws_checksums_library_clean_up();
+
+    return AWS_OP_SUCCESS;
+}
+AWS_TEST_CASE(test_crc64nvme_patch, s_test_crc64nvme_patch)
+
+static int s_test_crc64nvme_combine_many(struct aws_allocator *allocator, void *ctx) {
+    (void)ctx;
+
+    aws_checksums_library_init(allocator);
+
+    /* {length, repeat}, see s_test_crc32_combine_many_impl() */
+    const size_t runs[][2] = {
+        {100, 12}, {3, 1}, {0, 2}, {64, 1}, {1, 1}, {2, 1}, {5, 1}, {4, 1}, {9, 1}, {6, 1}, {8, 1}, {7, 7},
+        {33, 9}, {1, 1}, {4096 + 1, 1}, {0, 8}, {17, 1}, {18, 1}, {19, 1}, {20, 1}, {21, 1}, {22, 1}, {23, 1},
+        {24, 1}, {25, 1}, {26, 1}, {27, 1}, {28, 1}, {29, 1}, {30, 1}, {31, 1}, {32, 1}, {250, 30}};
+    struct aws_crc_segment segs[128];
+    size_t count = 0;
+    size_t total = 0;
+    for (size_t r = 0; r < AWS_ARRAY_SIZE(runs); ++r) {
+        for (size_t i = 0; i < runs[r][1]; ++i) {
+            segs[count++].length = runs[r][0];
+            total += runs[r][0];
+        }
+    }
+    ASSERT_TRUE(count <= AWS_ARRAY_SIZE(segs));
+
+    uint8_t *buffer = aws_mem_acquire(allocator, total);
+    for (size_t i = 0; i < total; ++i) {
+        buffer[i] = (uint8_t)(i * 173 + 11);
+    }
+    size_t offset = 0;
+    for (size_t i = 0; i < count; ++i) {
+        segs[i].crc = aws_checksums_crc64nvme_ex(buffer + offset, (size_t)segs[i].length, 0);
+        offset += (size_t)segs[i].length;
+    }
+
+    ASSERT_HEX_EQUALS(0, aws_checksums_crc64nvme_combine_many(NULL, 0));
+    offset = 0;
+    for (size_t n = 1; n <= count; ++n) {
+        offset += (size_t)segs[n - 1].length;
+        ASSERT_HEX_EQUALS(
+            aws_checksums_crc64nvme_ex(buffer, offset, 0), aws_checksums_crc64nvme_combine_many(segs, n), "n %zu", n);
+    }
+
+    struct aws_crc_segment *parts = aws_mem_calloc(allocator, 10000, sizeof(struct aws_crc_segment));
+    uint64_t state = 0x9E3779B97F4A7C15ULL;
+    for (size_t i = 0; i < 10000; ++i) {
+        state ^= state << 13;
+        state ^= state >> 7;
+        state ^= state << 17;
+        parts[i].crc = state;
+        parts[i].length = i < 5000 ? 8 * 1024 * 1024 : (state >> 40);
+    }
+    parts[4999].length = 12345;
+    uint64_t expected = 0;
+    for (size_t i = 0; i < 10000; ++i) {
+        expected = aws_checksums_crc64nvme_combine(expected, parts[i].crc, parts[i].length);
+        if (i == 4999 || i == 9999) {
+            ASSERT_HEX_EQUALS(expected, aws_checksums_crc64nvme_combine_many(parts, i + 1), "n %zu", i + 1);
+        }
+    }
+
+    aws_mem_release(allocator, parts);
+    aws_mem_release(allocator, buffer);
+    aws_checksums_library_clean_up();
+
+    return AWS_OP_SUCCESS;
+}
+AWS_TEST_CASE(test_crc64nvme_combine_many, s_test_crc64nvme_combine_many)
+
+static int s_test_crc64nvme_size_classes(struct aws_allocator *allocator, void *ctx) {
+    (void)ctx;
+
+    aws_checksums_library_init(allocator);
+
+    /* Lengths straddling every enum aws_checksums_size_class boundary, where the dispatched kernel changes. */
+    const int lengths[] = {63, 64, 65, 1023, 1024, 1025, 64 * 1024 - 1, 64 * 1024, 64 * 1024 + 1};
+    const int max_len = 64 * 1024 + 1;
+    uint8_t *buffer = aws_mem_acquire(allocator, (size_t)max_len + 7);
+    for (int i = 0; i < max_len + 7; ++i) {
+        buffer[i] = (uint8_t)(i * 131 + 7);
+    }
+
+    for (size_t i = 0; i < AWS_ARRAY_SIZE(lengths); ++i) {
+        const int len = lengths[i];
+        for (int off = 0; off < 8; off += 3) {
+            uint64_t expected = aws_checksums_crc64nvme_sw(buffer + off, len, 0);
+            ASSERT_HEX_EQUALS(expected, aws_checksums_crc64nvme(buffer + off, len, 0), "len %d offset %d", len, off);
+
+            uint64_t crc = aws_checksums_crc64nvme(buffer + off, 17, 0);
+            crc = aws_checksums_crc64nvme(buffer + off + 17, len - 17, crc);
+            ASSERT_HEX_EQUALS(expected, crc, "chained len %d offset %d", len, off);
+        }
+    }
+
+    aws_mem_release(allocator, buffer);
+    aws_checksums_library_clean_up();
+
+    return AWS_OP_SUCCESS;
+}
+AWS_TEST_CASE(test_crc64nvme_size_classes, s_test_crc64nvme_size_classes)
+
+static int s_test_crc64nvme_batch(struct aws_allocator *allocator, void *ctx) {
+    (void)ctx;
+
+    aws_checksums_library_init(allocator);
+
+    const size_t lengths[] = {0, 1, 7, 8, 63, 100, 511, 512, 4096, 33, 64 * 1024, 17};
+    enum { count = AWS_ARRAY_SIZE(lengths) };
+
+    uint8_t *buffer = aws_mem_acquire(allocator, 128 * 1024);
+    for (int i = 0; i < 128 * 1024; ++i) {
+        buffer[i] = (uint8_t)(i * 151 + 13);
+    }
+
+    struct aws_byte_cursor inputs[count];
+    uint64_t crcs[count];
+    size_t offset = 0;
+    for (size_t i = 0; i < count; ++i) {
+        inputs[i] = aws_byte_cursor_from_array(buffer + offset, lengths[i]);
+        offset += lengths[i] + 3;
+    }
+
+    aws_checksums_crc64nvme_batch(inputs, crcs, count);
+    for (size_t i = 0; i < count; ++i) {
+        ASSERT_UINT_EQUALS(aws_checksums_crc64nvme_sw(inputs[i].ptr, (int)inputs[i].len, 0), crcs[i], "index %zu", i);
+    }
+
+    /* nothing to do is fine */
+    aws_checksums_crc64nvme_batch(NULL, NULL, 0);
+
+    aws_mem_release(allocator, buffer);
+    aws_checksums_library_clean_up();
+
+    return AWS_OP_SUCCESS;
+}
+AWS_TEST_CASE(test_crc64nvme_batch, s_test_crc64nvme_batch)
+
+static int s_test_crc64nvme_iov(struct aws_allocator *allocator, void *ctx) {
+    (void)ctx;
+
+    aws_checksums_library_init(allocator);
+
+    const size_t lengths[] = {0, 1, 7, 255, 256, 13, 0, 4096, 100, 200, 3, 64 * 1024, 255, 255, 255, 1, 2, 3, 40};
+    enum { count = AWS_ARRAY_SIZE(lengths) };
+
+    size_t total = 0;
+    for (size_t i = 0; i < count; ++i) {
+        total += lengths[i];
+    }
+
+    uint8_t *buffer = aws_mem_acquire(allocator, total);
+    for (size_t i = 0; i < total; ++i) {
+        buffer[i] = (uint8_t)(i * 151 + 13);
+    }
+
+    struct aws_byte_cursor segments[count];
+    size_t offset = 0;
+    for (size_t i = 0; i < count; ++i) {
+        segments[i] = aws_byte_cursor_from_array(buffer + offset, lengths[i]);
+        offset += lengths[i];
+    }
+
+    uint64_t expected = aws_checksums_crc64nvme_sw(buffer, (int)total, 0);
+    ASSERT_UINT_EQUALS(expected, aws_checksums_crc64nvme_iov(segments, count, 0));
+
+    uint64_t crc = aws_checksums_crc64nvme_iov(segments, 5, 0);
+    ASSERT_UINT_EQUALS(expected, aws_checksums_crc64nvme_iov(segments + 5, count - 5, crc));
+
+    aws_mem_release(allocator, buffer);
+    aws_checksums_library_clean_up();
+
+    return AWS_OP_SUCCESS;
+}
+AWS_TEST_CASE(test_crc64nvme_iov, s_test_crc64nvme_iov)
+
+typedef uint64_t(crc64_copy_fn)(uint8_t *dst, const uint8_t *src, size_t length, uint64_t previous_crc);
+
+static int s_test_crc64nvme_copy_impl(struct aws_allocator *allocator, crc64_copy_fn *copy_fn) {
+    const size_t lengths[] = {
+        0, 1, 15, 16, 17, 63, 64, 65, 1000, 16 * 1024 - 1, 16 * 1024, 16 * 1024 + 1, 100 * 1024 + 3};
+    enum { max_length = 100 * 1024 + 3, max_offset = 4 };
+
+    uint8_t *src = aws_mem_acquire(allocator, max_length + max_offset);
+    uint8_t *dst = aws_mem_acquire(allocator, max_length + max_offset);
+    for (size_t i = 0; i < max_length + max_offset; ++i) {
+        src[i] = (uint8_t)(i * 151 + 13);
+    }
+
+    for (size_t i = 0; i < AWS_ARRAY_SIZE(lengths); ++i) {
+        for (size_t offset = 0; offset < max_offset; ++offset) {
+            memset(dst, 0, max_length + max_offset);
+            uint64_t expected = aws_checksums_crc64nvme_sw(src + offset, (int)lengths[i], 0x1234);
+            ASSERT_UINT_EQUALS(expected, copy_fn(dst + max_offset - offset, src + offset, lengths[i], 0x1234));
+            ASSERT_BIN_ARRAYS_EQUALS(src + offset, lengths[i], dst + max_offset - offset, lengths[i]);
+        }
+    }
+
+    aws_mem_release(allocator, dst);
+    aws_mem_release(allocator, src);
+
+    return AWS_OP_SUCCESS;
+}
+
+static int s_test_crc64nvme_copy(struct aws_allocator *allocator, void *ctx) {
+    (void)ctx;
+
+    aws_checksums_library_init(allocator);
+    ASSERT_SUCCESS(s_test_crc64nvme_copy_impl(allocator, aws_checksums_crc64nvme_copy));
+    ASSERT_SUCCESS(s_test_crc64nvme_copy_impl(allocator, aws_checksums_crc64nvme_copy_nt));
+    aws_checksums_library_clean_up();
+
+    return AWS_OP_SUCCESS;
+}
+AWS_TEST_CASE(test_crc64nvme_copy, s_test_crc64nvme_copy)
@@ -0,0 +1,192 @@
+/**
+ * Copyright Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0.
+ */
+
+#include <aws/checksums/checksums.h>
+#include <aws/checksums/crc.h>
+#include <aws/checksums/private/crc32_priv.h>
+#include <aws/checksums/private/crc64_priv.h>
+#include <aws/checksums/private/crc_kernels_priv.h>
+#include <aws/checksums/private/crc_util.h>
+
+#include <aws/common/clock.h>
+#include <aws/common/file.h>
+
+#include <aws/testing/aws_test_harness.h>
+
+/* Checks the public entry points still agree with the sw kernels at a length from every size class. */
+static int s_check_dispatched_crcs(struct aws_allocator *allocator) {
+    const int lengths[] = {32, 512, 16 * 1024, 256 * 1024};
+    uint8_t *buffer = aws_mem_acquire(allocator, 256 * 1024);
+    for (int i = 0; i < 256 * 1024; ++i) {
+        buffer[i] = (uint8_t)(i * 17 + 3);
+    }
+
+    for (size_t i = 0; i < AWS_ARRAY_SIZE(lengths); ++i) {
+        ASSERT_HEX_EQUALS(aws_checksums_crc32_sw(buffer, lengths[i], 0), aws_checksums_crc32(buffer, lengths[i], 0));
+        ASSERT_HEX_EQUALS(
+            aws_checksums_crc32c_sw(buffer, lengths[i], 0), aws_checksums_crc32c(buffer, lengths[i], 0));
+        ASSERT_HEX_EQUALS(
+            aws_checksums_crc64nvme_sw(buffer, lengths[i], 0), aws_checksums_crc64nvme(buffer, lengths[i], 0));
+    }
+
+    aws_mem_release(allocator, buffer);
+    return AWS_OP_SUCCESS;
+}
+
+static int s_test_crc_calibration_round_trip(struct aws_allocator *allocator, void *ctx) {
+    (void)ctx;
+
+    aws_checksums_library_init(allocator);
+
+#if defined(AWS_CHECKSUMS_STATIC_DISPATCH)
+    /* the kernels are fixed at compile time, so there is nothing to calibrate or load */
+    const struct aws_checksums_crc_kernel *before =
+        aws_checksums_crc_active_kernel(AWS_CHECKSUMS_CRC_ALGORITHM_CRC32C, AWS_CHECKSUMS_SIZE_CLASS_LARGE);
+    ASSERT_ERROR(AWS_ERROR_UNSUPPORTED_OPERATION, aws_checksums_crc_calibrate(allocator));
+    ASSERT_ERROR(
+        AWS_ERROR_UNSUPPORTED_OPERATION,
+        aws_checksums_crc_calibration_load(
+            aws_byte_cursor_from_c_str("crc32=sw,sw,sw,sw;crc32c=sw,sw,sw,sw;crc64nvme=sw,sw,sw,sw")));
+    ASSERT_PTR_EQUALS(
+        before, aws_checksums_crc_active_kernel(AWS_CHECKSUMS_CRC_ALGORITHM_CRC32C, AWS_CHECKSUMS_SIZE_CLASS_LARGE));
+    ASSERT_SUCCESS(s_check_dispatched_crcs(allocator));
+#else
+    uint64_t start = 0;
+    uint64_t end = 0;
+    aws_high_res_clock_get_ticks(&start);
+    ASSERT_SUCCESS(aws_checksums_crc_calibrate(allocator));
+    aws_high_res_clock_get_ticks(&end);
+    /* generous bound, it is expected to take a few milliseconds */
+    ASSERT_TRUE(end - start < 2000000000ULL);
+
+    ASSERT_SUCCESS(s_check_dispatched_crcs(allocator));
+
+    struct aws_byte_buf saved;
+    ASSERT_SUCCESS(aws_byte_buf_init(&saved, allocator, 16));
+    ASSERT_SUCCESS(aws_checksums_crc_calibration_save(&saved));
+
+    /* every algorithm and size class is in the output, and it loads back as the same choices */
+    ASSERT_SUCCESS(aws_checksums_crc_calibration_load(aws_byte_cursor_from_buf(&saved)));
+
+    struct aws_byte_buf reloaded;
+    ASSERT_SUCCESS(aws_byte_buf_init(&reloaded, allocator, 16));
+    ASSERT_SUCCESS(aws_checksums_crc_calibration_save(&reloaded));
+    ASSERT_BIN_ARRAYS_EQUALS(saved.buffer, saved.len, reloaded.buffer, reloaded.len);
+
+    /* all sw is valid on every host */
+    ASSERT_SUCCESS(aws_checksums_crc_calibration_load(
+        aws_byte_cursor_from_c_str("crc32=sw,sw,sw,sw;crc32c=sw,sw,sw,sw;crc64nvme=sw,sw,sw,sw")));
+    for (size_t size_class = 0; size_class < AWS_CHECKSUMS_SIZE_CLASS_COUNT; ++size_class) {
+        ASSERT_STR_EQUALS(
+            "sw", aws_checksums_crc_active_kernel(AWS_CHECKSUMS_CRC_ALGORITHM_CRC32C, size_class)->name);
+    }
+    ASSERT_SUCCESS(s_check_dispatched_crcs(allocator));
+
+    ASSERT_SUCCESS(aws_checksums_crc_calibration_load(aws_byte_cursor_from_buf(&saved)));
+
+    aws_byte_buf_clean_up(&reloaded);
+    aws_byte_buf_clean_up(&saved);
+#endif
+    aws_checksums_library_clean_up();
+
+    return AWS_OP_SUCCESS;
+}
+AWS_TEST_CASE(test_crc_calibration_round_trip, s_test_crc_calibration_round_trip)
+
+static int s_test_crc_calibration_load_rejects_invalid(struct aws_allocator *allocator, void *ctx) {
+    (void)ctx;
+
+    aws_checksums_library_init(allocator);
+
+#if !defined(AWS_CHECKSUMS_STATIC_DISPATCH)
+    const char *invalid[] = {
+        "",
+        "crc32=sw,sw,sw,sw", /* missing algorithms */
+        "crc32=sw,sw,sw;crc32c=sw,sw,sw,sw;crc64nvme=sw,sw,sw,sw", /* missing size class */
+        "crc32=sw,sw,sw,sw,sw;crc32c=sw,sw,sw,sw;crc64nvme=sw,sw,sw,sw", /* extra size class */
+        "crc32=sw,sw,sw,sw;crc32c=sw,sw,sw,bogus;crc64nvme=sw,sw,sw,sw", /* unknown kernel */
+        "crc32=sw,sw,sw,sw;crc32c=sw,sw,sw,sw;crc65=sw,sw,sw,sw", /* unknown algorithm */
+        "crc32sw,sw,sw,sw;crc32c=sw,sw,sw,sw;crc64nvme=sw,sw,sw,sw", /* missing separator */
+        "crc32=sw,sw,sw,sw;crc32c=sw,sw,sw,sw;crc64nvme=clmul,pmull,sw,sw", /* never both supported */
+    };
+
+    const struct aws_checksums_crc_kernel *before =
+        aws_checksums_crc_active_kernel(AWS_CHECKSUMS_CRC_ALGORITHM_CRC32C, AWS_CHECKSUMS_SIZE_CLASS_TINY);
+    for (size_t i = 0; i < AWS_ARRAY_SIZE(invalid); ++i) {
+        ASSERT_ERROR(
+            AWS_ERROR_INVALID_ARGUMENT, aws_checksums_crc_calibration_load(aws_byte_cursor_from_c_str(invalid[i])));
+        ASSERT_PTR_EQUALS(
+            before, aws_checksums_crc_active_kernel(AWS_CHECKSUMS_CRC_ALGORITHM_CRC32C, AWS_CHECKSUMS_SIZE_CLASS_TINY));
+    }
+#endif
+
+    aws_checksums_library_clean_up();
+
+    return AWS_OP_SUCCESS;
+}
+AWS_TEST_CASE(test_crc_calibration_load_rejects_invalid, s_test_crc_calibration_load_rejects_invalid)
+
+static int s_test_library_init_calibration_file(struct aws_allocator *allocator, void *ctx) {
+    (void)ctx;
+
+    const char *path = "aws_checksums_calibration_test.txt";
+    remove(path);
+
+#if defined(AWS_CHECKSUMS_STATIC_DISPATCH)
+    /* calibration is skipped entirely, so no file is written */
+    struct aws_checksums_library_options static_options = {
+        .calibrate = true,
+        .calibration_file_path = path,
+    };
+    aws_checksums_library_init_with_options(allocator, &static_options);
+    ASSERT_SUCCESS(s_check_dispatched_crcs(allocator));
+    aws_checksums_library_clean_up();
+
+    ASSERT_NULL(aws_fopen(path, "r"));
+
+    return AWS_OP_SUCCESS;
+#else
+
+    /* remember the active kernels so the ones installed below don't leak into other tests */
+    struct aws_byte_buf original;
+    ASSERT_SUCCESS(aws_byte_buf_init(&original, allocator, 16));
+    ASSERT_SUCCESS(aws_checksums_crc_calibration_save(&original));
+
+    struct aws_checksums_library_options options = {
+        .calibrate = true,
+        .calibration_file_path = path,
+    };
+
+    /* no file yet, so init calibrates and saves the result */
+    aws_checksums_library_init_with_options(allocator, &options);
+    ASSERT_SUCCESS(s_check_dispatched_crcs(allocator));
+    aws_checksums_library_clean_up();
+
+    struct aws_byte_buf contents;
+    ASSERT_SUCCESS(aws_byte_buf_init_from_file(&contents, allocator, path));
+    ASSERT_TRUE(contents.len > 0);
+    aws_byte_buf_clean_up(&contents);
+
+    /* a saved result is installed as is instead of re-calibrating */
+    FILE *file = aws_fopen(path, "w");
+    ASSERT_NOT_NULL(file);
+    fputs("crc32=sw,sw,sw,sw;crc32c=sw,sw,sw,sw;crc64nvme=sw,sw,sw,sw\n", file);
+    fclose(file);
+
+    aws_checksums_library_init_with_options(allocator, &options);
+    ASSERT_STR_EQUALS(
+        "sw",
+        aws_checksums_crc_active_kernel(AWS_CHECKSUMS_CRC_ALGORITHM_CRC64NVME, AWS_CHECKSUMS_SIZE_CLASS_LARGE)->name);
+    ASSERT_SUCCESS(s_check_dispatched_crcs(allocator));
+    aws_checksums_library_clean_up();
+
+    remove(path);
+    ASSERT_SUCCESS(aws_checksums_crc_calibration_load(aws_byte_cursor_from_buf(&original)));
+    aws_byte_buf_clean_up(&original);
+
+    return AWS_OP_SUCCESS;
+#endif
+}
+AWS_TEST_CASE(test_library_init_calibration_file, s_test_library_init_calibration_file)
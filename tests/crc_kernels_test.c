@@ -0,0 +1,232 @@
+/**
+ * Copyright Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0.
+ */
+
+#include <aws/checksums/checksums.h>
+#include <aws/checksums/crc.h>
+#include <aws/checksums/crc_kernels.h>
+#include <aws/checksums/private/crc32_priv.h>
+#include <aws/checksums/private/crc64_priv.h>
+#include <aws/checksums/private/crc_kernels_priv.h>
+#include <aws/checksums/private/crc_util.h>
+
+#include <aws/testing/aws_test_harness.h>
+
+static const int s_lengths[] = {0, 1, 31, 63, 64, 100, 1023, 1024, 4096 + 7, 64 * 1024, 100 * 1024};
+
+static uint8_t *s_make_buffer(struct aws_allocator *allocator) {
+    uint8_t *buffer = aws_mem_acquire(allocator, 100 * 1024);
+    for (int i = 0; i < 100 * 1024; ++i) {
+        buffer[i] = (uint8_t)(i * 31 + 7);
+    }
+    return buffer;
+}
+
+/* Checks every supported kernel of the algorithm against the sw kernel through the public registry. */
+static int s_check_registry_kernels(
+    struct aws_allocator *allocator,
+    enum aws_checksums_crc_algorithm algorithm,
+    size_t *out_supported) {
+    uint8_t *buffer = s_make_buffer(allocator);
+
+    size_t count = aws_checksums_crc_kernel_count(algorithm);
+    ASSERT_TRUE(count > 0);
+
+    *out_supported = 0;
+    for (size_t i = 0; i < count; ++i) {
+        struct aws_checksums_crc_kernel_info info;
+        ASSERT_SUCCESS(aws_checksums_crc_kernel_get_info(algorithm, i, &info));
+        ASSERT_NOT_NULL(info.name);
+        ASSERT_NOT_NULL(info.required_features);
+
+        if (i == 0) {
+            /* the portable kernel always comes first and runs everywhere */
+            ASSERT_STR_EQUALS("sw", info.name);
+            ASSERT_STR_EQUALS("", info.required_features);
+            ASSERT_TRUE(info.supported);
+        }
+
+        if (!info.supported) {
+            continue;
+        }
+        ++*out_supported;
+
+        for (size_t j = 0; j < AWS_ARRAY_SIZE(s_lengths); ++j) {
+            if (algorithm == AWS_CHECKSUMS_CRC_ALGORITHM_CRC64NVME) {
+                ASSERT_NULL(info.crc32_fn);
+                ASSERT_HEX_EQUALS(
+                    aws_checksums_crc64nvme_sw(buffer, s_lengths[j], 0), info.crc64_fn(buffer, s_lengths[j], 0));
+            } else {
+                ASSERT_NULL(info.crc64_fn);
+                uint32_t expected = algorithm == AWS_CHECKSUMS_CRC_ALGORITHM_CRC32
+                                        ? aws_checksums_crc32_sw(buffer, s_lengths[j], 0)
+                                        : aws_checksums_crc32c_sw(buffer, s_lengths[j], 0);
+                ASSERT_HEX_EQUALS(expected, info.crc32_fn(buffer, s_lengths[j], 0));
+            }
+        }
+    }
+
+    struct aws_checksums_crc_kernel_info info;
+    ASSERT_ERROR(AWS_ERROR_INVALID_INDEX, aws_checksums_crc_kernel_get_info(algorithm, count, &info));
+
+    aws_mem_release(allocator, buffer);
+    return AWS_OP_SUCCESS;
+}
+
+static int s_test_crc_kernel_registry(struct aws_allocator *allocator, void *ctx) {
+    (void)ctx;
+
+    aws_checksums_library_init(allocator);
+
+    ASSERT_STR_EQUALS("crc32", aws_checksums_crc_algorithm_name(AWS_CHECKSUMS_CRC_ALGORITHM_CRC32));
+    ASSERT_STR_EQUALS("crc32c", aws_checksums_crc_algorithm_name(AWS_CHECKSUMS_CRC_ALGORITHM_CRC32C));
+    ASSERT_STR_EQUALS("crc64nvme", aws_checksums_crc_algorithm_name(AWS_CHECKSUMS_CRC_ALGORITHM_CRC64NVME));
+
+    for (size_t algorithm = 0; algorithm < AWS_CHECKSUMS_CRC_ALGORITHM_COUNT; ++algorithm) {
+        size_t supported = 0;
+        ASSERT_SUCCESS(s_check_registry_kernels(allocator, algorithm, &supported));
+
+        /* the active kernel for every size is one of the supported kernels */
+        const size_t input_lengths[] = {0, 63, 64, 1023, 1024, 64 * 1024, SIZE_MAX};
+        for (size_t i = 0; i < AWS_ARRAY_SIZE(input_lengths); ++i) {
+            const char *active = aws_checksums_crc_active_kernel_name(algorithm, input_lengths[i]);
+            ASSERT_NOT_NULL(active);
+
+            bool found = false;
+            for (size_t j = 0; j < aws_checksums_crc_kernel_count(algorithm); ++j) {
+                struct aws_checksums_crc_kernel_info info;
+                ASSERT_SUCCESS(aws_checksums_crc_kernel_get_info(algorithm, j, &info));
+                found |= info.supported && strcmp(info.name, active) == 0;
+            }
+            ASSERT_TRUE(found);
+        }
+    }
+
+    aws_checksums_library_clean_up();
+
+    return AWS_OP_SUCCESS;
+}
+AWS_TEST_CASE(test_crc_kernel_registry, s_test_crc_kernel_registry)
+
+static int s_check_dispatched_crcs(struct aws_allocator *allocator) {
+    uint8_t *buffer = s_make_buffer(allocator);
+
+    for (size_t i = 0; i < AWS_ARRAY_SIZE(s_lengths); ++i) {
+        ASSERT_HEX_EQUALS(
+            aws_checksums_crc32_sw(buffer, s_lengths[i], 0), aws_checksums_crc32(buffer, s_lengths[i], 0));
+        ASSERT_HEX_EQUALS(
+            aws_checksums_crc32c_sw(buffer, s_lengths[i], 0), aws_checksums_crc32c(buffer, s_lengths[i], 0));
+        ASSERT_HEX_EQUALS(
+            aws_checksums_crc64nvme_sw(buffer, s_lengths[i], 0), aws_checksums_crc64nvme(buffer, s_lengths[i], 0));
+    }
+
+    aws_mem_release(allocator, buffer);
+    return AWS_OP_SUCCESS;
+}
+
+static int s_test_crc_kernel_pin(struct aws_allocator *allocator, void *ctx) {
+    (void)ctx;
+
+    aws_checksums_library_init(allocator);
+
+#if defined(AWS_CHECKSUMS_STATIC_DISPATCH)
+    ASSERT_ERROR(
+        AWS_ERROR_UNSUPPORTED_OPERATION, aws_checksums_crc_pin_kernel(AWS_CHECKSUMS_CRC_ALGORITHM_CRC32C, "sw"));
+#else
+    for (size_t algorithm = 0; algorithm < AWS_CHECKSUMS_CRC_ALGORITHM_COUNT; ++algorithm) {
+        /* start from the defaults, the environment may have pinned something */
+        aws_checksums_crc_unpin_kernel(algorithm);
+        const char *default_large = aws_checksums_crc_active_kernel_name(algorithm, SIZE_MAX);
+
+        /* pin every supported kernel in turn, results must not change */
+        for (size_t i = 0; i < aws_checksums_crc_kernel_count(algorithm); ++i) {
+            struct aws_checksums_crc_kernel_info info;
+            ASSERT_SUCCESS(aws_checksums_crc_kernel_get_info(algorithm, i, &info));
+            if (!info.supported) {
+                ASSERT_ERROR(AWS_ERROR_INVALID_ARGUMENT, aws_checksums_crc_pin_kernel(algorithm, info.name));
+                continue;
+            }
+
+            ASSERT_SUCCESS(aws_checksums_crc_pin_kernel(algorithm, info.name));
+            ASSERT_STR_EQUALS(info.name, aws_checksums_crc_active_kernel_name(algorithm, 0));
+            ASSERT_STR_EQUALS(info.name, aws_checksums_crc_active_kernel_name(algorithm, SIZE_MAX));
+            ASSERT_SUCCESS(s_check_dispatched_crcs(allocator));
+        }
+
+        ASSERT_ERROR(AWS_ERROR_INVALID_ARGUMENT, aws_checksums_crc_pin_kernel(algorithm, "bogus"));
+        ASSERT_ERROR(AWS_ERROR_INVALID_ARGUMENT, aws_checksums_crc_pin_kernel(algorithm, ""));
+
+        aws_checksums_crc_unpin_kernel(algorithm);
+        ASSERT_STR_EQUALS(default_large, aws_checksums_crc_active_kernel_name(algorithm, SIZE_MAX));
+    }
+#endif
+
+    ASSERT_SUCCESS(s_check_dispatched_crcs(allocator));
+    aws_checksums_library_clean_up();
+
+    return AWS_OP_SUCCESS;
+}
+AWS_TEST_CASE(test_crc_kernel_pin, s_test_crc_kernel_pin)
+
+static int s_test_crc_kernel_pin_from_string(struct aws_allocator *allocator, void *ctx) {
+    (void)ctx;
+
+    aws_checksums_library_init(allocator);
+
+#if !defined(AWS_CHECKSUMS_STATIC_DISPATCH)
+    aws_checksums_crc_unpin_kernel(AWS_CHECKSUMS_CRC_ALGORITHM_CRC32);
+    const char *default_crc32 = aws_checksums_crc_active_kernel_name(AWS_CHECKSUMS_CRC_ALGORITHM_CRC32, SIZE_MAX);
+
+    /* invalid pairs are skipped, the valid ones still apply */
+    aws_checksums_crc_pin_kernels_from_string(
+        aws_byte_cursor_from_c_str(" crc32c=sw ;crc65=sw;crc32=bogus;crc32;=sw;crc64nvme=;;crc64nvme=sw"));
+    ASSERT_STR_EQUALS("sw", aws_checksums_crc_active_kernel_name(AWS_CHECKSUMS_CRC_ALGORITHM_CRC32C, 0));
+    ASSERT_STR_EQUALS("sw", aws_checksums_crc_active_kernel_name(AWS_CHECKSUMS_CRC_ALGORITHM_CRC32C, SIZE_MAX));
+    ASSERT_STR_EQUALS("sw", aws_checksums_crc_active_kernel_name(AWS_CHECKSUMS_CRC_ALGORITHM_CRC64NVME, SIZE_MAX));
+    ASSERT_STR_EQUALS(default_crc32, aws_checksums_crc_active_kernel_name(AWS_CHECKSUMS_CRC_ALGORITHM_CRC32, SIZE_MAX));
+    ASSERT_SUCCESS(s_check_dispatched_crcs(allocator));
+
+    aws_checksums_crc_unpin_kernel(AWS_CHECKSUMS_CRC_ALGORITHM_CRC32C);
+    aws_checksums_crc_unpin_kernel(AWS_CHECKSUMS_CRC_ALGORITHM_CRC64NVME);
+#endif
+
+    aws_checksums_library_clean_up();
+
+    return AWS_OP_SUCCESS;
+}
+AWS_TEST_CASE(test_crc_kernel_pin_from_string, s_test_crc_kernel_pin_from_string)
+
+static int s_test_crc_dispatch_table(struct aws_allocator *allocator, void *ctx) {
+    (void)ctx;
+
+    ASSERT_UINT_EQUALS(0, (uintptr_t)&aws_checksums_dispatch % 64);
+
+#if !defined(AWS_CHECKSUMS_EAGER_INIT)
+    /* otherwise the library constructor already resolved everything */
+    aws_checksums_library_init(allocator);
+#endif
+
+    ASSERT_TRUE(aws_checksums_dispatch.detection_performed);
+    ASSERT_NOT_NULL(aws_checksums_dispatch.crc64nvme_combine_fn);
+    for (size_t algorithm = 0; algorithm < 2; ++algorithm) {
+        ASSERT_NOT_NULL(aws_checksums_dispatch.crc32_combine_fns[algorithm]);
+        for (size_t size_class = 0; size_class < AWS_CHECKSUMS_SIZE_CLASS_COUNT; ++size_class) {
+            ASSERT_NOT_NULL(aws_checksums_dispatch.crc32_fns[algorithm][size_class]);
+            ASSERT_NOT_NULL(aws_checksums_dispatch.crc32_kernels[algorithm][size_class]);
+        }
+    }
+    for (size_t size_class = 0; size_class < AWS_CHECKSUMS_SIZE_CLASS_COUNT; ++size_class) {
+        ASSERT_NOT_NULL(aws_checksums_dispatch.crc64nvme_fns[size_class]);
+        ASSERT_NOT_NULL(aws_checksums_dispatch.crc64nvme_kernels[size_class]);
+    }
+
+    ASSERT_SUCCESS(s_check_dispatched_crcs(allocator));
+
+#if !defined(AWS_CHECKSUMS_EAGER_INIT)
+    aws_checksums_library_clean_up();
+#endif
+
+    return AWS_OP_SUCCESS;
+}
+AWS_TEST_CASE(test_crc_dispatch_table, s_test_crc_dispatch_table)
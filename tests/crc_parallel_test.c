@@ -0,0 +1,228 @@
+/**
+ * Copyright Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0.
+ */
+
+#include <aws/checksums/crc.h>
+#include <aws/checksums/parallel.h>
+
+#include <aws/common/thread.h>
+#include <aws/testing/aws_test_harness.h>
+
+#define TEST_BUFFER_SIZE (3 * 1024 * 1024 + 123)
+#define TEST_CHUNK_SIZE (64 * 1024)
+#define MAX_EXECUTOR_THREADS 16
+
+static uint8_t *s_make_buffer(struct aws_allocator *allocator) {
+    uint8_t *buffer = aws_mem_acquire(allocator, TEST_BUFFER_SIZE);
+    for (size_t i = 0; i < TEST_BUFFER_SIZE; ++i) {
+        buffer[i] = (uint8_t)(i * 31 + (i >> 13));
+    }
+    return buffer;
+}
+
+/* Runs every submitted task on a new thread, joined once the checksum call returned. */
+struct test_executor {
+    struct aws_allocator *allocator;
+    struct aws_thread threads[MAX_EXECUTOR_THREADS];
+    size_t thread_count;
+};
+
+static int s_thread_executor_submit(struct aws_checksums_executor *executor, void (*task_fn)(void *arg), void *arg) {
+    struct test_executor *impl = executor->impl;
+    if (impl->thread_count == MAX_EXECUTOR_THREADS) {
+        return aws_raise_error(AWS_ERROR_INVALID_STATE);
+    }
+
+    struct aws_thread *thread = &impl->threads[impl->thread_count];
+    aws_thread_init(thread, impl->allocator);
+    if (aws_thread_launch(thread, task_fn, arg, aws_default_thread_options())) {
+        aws_thread_clean_up(thread);
+        return AWS_OP_ERR;
+    }
+    ++impl->thread_count;
+    return AWS_OP_SUCCESS;
+}
+
+static void s_test_executor_join(struct test_executor *impl) {
+    for (size_t i = 0; i < impl->thread_count; ++i) {
+        aws_thread_join(&impl->threads[i]);
+        aws_thread_clean_up(&impl->threads[i]);
+    }
+    impl->thread_count = 0;
+}
+
+static int s_rejecting_executor_submit(struct aws_checksums_executor *executor, void (*task_fn)(void *arg), void *arg) {
+    (void)executor;
+    (void)task_fn;
+    (void)arg;
+    return aws_raise_error(AWS_ERROR_INVALID_STATE);
+}
+
+static int s_inline_executor_submit(struct aws_checksums_executor *executor, void (*task_fn)(void *arg), void *arg) {
+    (void)executor;
+    task_fn(arg);
+    return AWS_OP_SUCCESS;
+}
+
+/* Queues every submitted task and runs none of them until told to, like a busy single threaded event loop. */
+struct deferred_executor {
+    void (*task_fns[MAX_EXECUTOR_THREADS])(void *arg);
+    void *args[MAX_EXECUTOR_THREADS];
+    size_t task_count;
+};
+
+static int s_deferred_executor_submit(struct aws_checksums_executor *executor, void (*task_fn)(void *arg), void *arg) {
+    struct deferred_executor *impl = executor->impl;
+    if (impl->task_count == MAX_EXECUTOR_THREADS) {
+        return aws_raise_error(AWS_ERROR_INVALID_STATE);
+    }
+
+    impl->task_fns[impl->task_count] = task_fn;
+    impl->args[impl->task_count] = arg;
+    ++impl->task_count;
+    return AWS_OP_SUCCESS;
+}
+
+static void s_deferred_executor_run(struct deferred_executor *impl) {
+    for (size_t i = 0; i < impl->task_count; ++i) {
+        impl->task_fns[i](impl->args[i]);
+    }
+    impl->task_count = 0;
+}
+
+/* Checks all three algorithms against the single threaded functions for one set of options. */
+static int s_check_parallel_crcs(
+    struct aws_allocator *allocator,
+    const uint8_t *buffer,
+    size_t length,
+    const struct aws_checksums_parallel_options *options,
+    struct test_executor *executor_impl) {
+
+    uint32_t crc32 = 0;
+    ASSERT_SUCCESS(aws_checksums_crc32_parallel(allocator, buffer, length, 0x1234, options, &crc32));
+    if (executor_impl != NULL) {
+        s_test_executor_join(executor_impl);
+    }
+    ASSERT_HEX_EQUALS(aws_checksums_crc32_ex(buffer, length, 0x1234), crc32);
+
+    uint32_t crc32c = 0;
+    ASSERT_SUCCESS(aws_checksums_crc32c_parallel(allocator, buffer, length, 0x5678, options, &crc32c));
+    if (executor_impl != NULL) {
+        s_test_executor_join(executor_impl);
+    }
+    ASSERT_HEX_EQUALS(aws_checksums_crc32c_ex(buffer, length, 0x5678), crc32c);
+
+    uint64_t crc64 = 0;
+    ASSERT_SUCCESS(aws_checksums_crc64nvme_parallel(allocator, buffer, length, 0x9abcdef0, options, &crc64));
+    if (executor_impl != NULL) {
+        s_test_executor_join(executor_impl);
+    }
+    ASSERT_HEX_EQUALS(aws_checksums_crc64nvme_ex(buffer, length, 0x9abcdef0), crc64);
+
+    return AWS_OP_SUCCESS;
+}
+
+static int s_test_crc_parallel(struct aws_allocator *allocator, void *ctx) {
+    (void)ctx;
+
+    uint8_t *buffer = s_make_buffer(allocator);
+    const size_t lengths[] = {0, 1, TEST_CHUNK_SIZE * 2 - 1, TEST_CHUNK_SIZE * 2, TEST_CHUNK_SIZE * 7 + 5};
+    const size_t thread_counts[] = {1, 2, 3, 8};
+
+    for (size_t i = 0; i < AWS_ARRAY_SIZE(thread_counts); ++i) {
+        struct aws_checksums_parallel_options options = {
+            .max_threads = thread_counts[i],
+            .chunk_size = TEST_CHUNK_SIZE,
+        };
+
+        for (size_t j = 0; j < AWS_ARRAY_SIZE(lengths); ++j) {
+            ASSERT_SUCCESS(s_check_parallel_crcs(allocator, buffer, lengths[j], &options, NULL));
+        }
+        /* unaligned start and more chunks than the per thread cap allows, so chunks get resized */
+        ASSERT_SUCCESS(s_check_parallel_crcs(allocator, buffer + 3, TEST_BUFFER_SIZE - 3, &options, NULL));
+    }
+
+    /* defaults: one thread per cpu and chunk sizes too large to split this buffer */
+    ASSERT_SUCCESS(s_check_parallel_crcs(allocator, buffer, TEST_BUFFER_SIZE, NULL, NULL));
+
+    aws_mem_release(allocator, buffer);
+    return AWS_OP_SUCCESS;
+}
+AWS_TEST_CASE(test_crc_parallel, s_test_crc_parallel)
+
+static int s_test_crc_parallel_numa_aware(struct aws_allocator *allocator, void *ctx) {
+    (void)ctx;
+
+    uint8_t *buffer = s_make_buffer(allocator);
+    struct aws_checksums_parallel_options options = {
+        .max_threads = 4,
+        .chunk_size = TEST_CHUNK_SIZE,
+        .numa_aware = true,
+    };
+    ASSERT_SUCCESS(s_check_parallel_crcs(allocator, buffer, TEST_BUFFER_SIZE, &options, NULL));
+
+    aws_mem_release(allocator, buffer);
+    return AWS_OP_SUCCESS;
+}
+AWS_TEST_CASE(test_crc_parallel_numa_aware, s_test_crc_parallel_numa_aware)
+
+static int s_test_crc_parallel_executor(struct aws_allocator *allocator, void *ctx) {
+    (void)ctx;
+
+    uint8_t *buffer = s_make_buffer(allocator);
+
+    struct test_executor executor_impl = {.allocator = allocator};
+    struct aws_checksums_executor executor = {
+        .submit = s_thread_executor_submit,
+        .impl = &executor_impl,
+    };
+    struct aws_checksums_parallel_options options = {
+        .max_threads = 4,
+        .chunk_size = TEST_CHUNK_SIZE,
+        .executor = &executor,
+        /* ignored with an executor */
+        .numa_aware = true,
+    };
+    ASSERT_SUCCESS(s_check_parallel_crcs(allocator, buffer, TEST_BUFFER_SIZE, &options, &executor_impl));
+
+    /* an executor that can't take work leaves everything to the calling thread */
+    executor.submit = s_rejecting_executor_submit;
+    ASSERT_SUCCESS(s_check_parallel_crcs(allocator, buffer, TEST_BUFFER_SIZE, &options, NULL));
+
+    /* running the task synchronously inside submit is allowed */
+    executor.submit = s_inline_executor_submit;
+    ASSERT_SUCCESS(s_check_parallel_crcs(allocator, buffer, TEST_BUFFER_SIZE, &options, NULL));
+
+    /* tasks queued behind the calling thread don't block it, and are harmless when they finally run */
+    struct deferred_executor deferred_impl = {.task_count = 0};
+    executor.submit = s_deferred_executor_submit;
+    executor.impl = &deferred_impl;
+    uint32_t crc32c = 0;
+    ASSERT_SUCCESS(aws_checksums_crc32c_parallel(allocator, buffer, TEST_BUFFER_SIZE, 0x5678, &options, &crc32c));
+    ASSERT_HEX_EQUALS(aws_checksums_crc32c_ex(buffer, TEST_BUFFER_SIZE, 0x5678), crc32c);
+    ASSERT_UINT_EQUALS(options.max_threads - 1, deferred_impl.task_count);
+    s_deferred_executor_run(&deferred_impl);
+
+    aws_mem_release(allocator, buffer);
+    return AWS_OP_SUCCESS;
+}
+AWS_TEST_CASE(test_crc_parallel_executor, s_test_crc_parallel_executor)
+
+static int s_test_crc_parallel_invalid_args(struct aws_allocator *allocator, void *ctx) {
+    (void)ctx;
+
+    uint8_t byte = 0;
+    uint32_t crc32 = 0;
+    uint64_t crc64 = 0;
+    ASSERT_ERROR(AWS_ERROR_INVALID_ARGUMENT, aws_checksums_crc32_parallel(allocator, &byte, 1, 0, NULL, NULL));
+    ASSERT_ERROR(AWS_ERROR_INVALID_ARGUMENT, aws_checksums_crc32c_parallel(allocator, NULL, 1, 0, NULL, &crc32));
+    ASSERT_ERROR(AWS_ERROR_INVALID_ARGUMENT, aws_checksums_crc64nvme_parallel(allocator, NULL, 1, 0, NULL, &crc64));
+
+    /* empty input may be NULL */
+    ASSERT_SUCCESS(aws_checksums_crc32c_parallel(allocator, NULL, 0, 0, NULL, &crc32));
+    ASSERT_HEX_EQUALS(0, crc32);
+
+    return AWS_OP_SUCCESS;
+}
+AWS_TEST_CASE(test_crc_parallel_invalid_args, s_test_crc_parallel_invalid_args)
@@ -0,0 +1,125 @@
+/**
+ * Copyright Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0.
+ */
+
+#include <aws/checksums/checksums.h>
+#include <aws/checksums/crc.h>
+#include <aws/checksums/file_checksum.h>
+
+#include <aws/common/file.h>
+#include <aws/testing/aws_test_harness.h>
+
+#define TEST_FILE_SIZE (3 * 1024 * 1024 + 4097)
+
+static const char *s_test_file_path = "aws_checksums_file_checksum_test.bin";
+
+static uint8_t *s_write_test_file(struct aws_allocator *allocator) {
+    uint8_t *buffer = aws_mem_acquire(allocator, TEST_FILE_SIZE);
+    for (size_t i = 0; i < TEST_FILE_SIZE; ++i) {
+        buffer[i] = (uint8_t)(i * 151 + (i >> 12));
+    }
+
+    FILE *file = aws_fopen(s_test_file_path, "wb");
+    AWS_FATAL_ASSERT(file != NULL);
+    AWS_FATAL_ASSERT(fwrite(buffer, 1, TEST_FILE_SIZE, file) == TEST_FILE_SIZE);
+    fclose(file);
+
+    return buffer;
+}
+
+/* Checks all three algorithms over one range of the test file against the in memory functions. */
+static int s_check_file_range(
+    struct aws_allocator *allocator,
+    const uint8_t *buffer,
+    uint64_t offset,
+    uint64_t length,
+    const struct aws_checksums_file_options *options) {
+
+    size_t expected_length = length == AWS_CHECKSUMS_FILE_TO_END ? TEST_FILE_SIZE - (size_t)offset : (size_t)length;
+    const uint8_t *expected_data = buffer + offset;
+
+    uint32_t crc32 = 0;
+    ASSERT_SUCCESS(aws_checksums_file_crc32(allocator, s_test_file_path, offset, length, options, &crc32));
+    ASSERT_HEX_EQUALS(aws_checksums_crc32_ex(expected_data, expected_length, 0), crc32);
+
+    uint32_t crc32c = 0;
+    ASSERT_SUCCESS(aws_checksums_file_crc32c(allocator, s_test_file_path, offset, length, options, &crc32c));
+    ASSERT_HEX_EQUALS(aws_checksums_crc32c_ex(expected_data, expected_length, 0), crc32c);
+
+    uint64_t crc64 = 0;
+    ASSERT_SUCCESS(aws_checksums_file_crc64nvme(allocator, s_test_file_path, offset, length, options, &crc64));
+    ASSERT_HEX_EQUALS(aws_checksums_crc64nvme_ex(expected_data, expected_length, 0), crc64);
+
+    return AWS_OP_SUCCESS;
+}
+
+static int s_test_file_checksums(struct aws_allocator *allocator, void *ctx) {
+    (void)ctx;
+
+    aws_checksums_library_init(allocator);
+    uint8_t *buffer = s_write_test_file(allocator);
+
+    /* defaults, a single window */
+    ASSERT_SUCCESS(s_check_file_range(allocator, buffer, 0, AWS_CHECKSUMS_FILE_TO_END, NULL));
+    ASSERT_SUCCESS(s_check_file_range(allocator, buffer, 0, TEST_FILE_SIZE, NULL));
+    ASSERT_SUCCESS(s_check_file_range(allocator, buffer, TEST_FILE_SIZE, 0, NULL));
+
+    /* windows and ranges that start and end off page boundaries */
+    struct aws_checksums_file_options options = {.window_size = 1024 * 1024 + 3};
+    ASSERT_SUCCESS(s_check_file_range(allocator, buffer, 0, AWS_CHECKSUMS_FILE_TO_END, &options));
+    ASSERT_SUCCESS(s_check_file_range(allocator, buffer, 4095, 2 * 1024 * 1024 + 7, &options));
+    ASSERT_SUCCESS(s_check_file_range(allocator, buffer, 12345, AWS_CHECKSUMS_FILE_TO_END, &options));
+    ASSERT_SUCCESS(s_check_file_range(allocator, buffer, TEST_FILE_SIZE - 1, 1, &options));
+
+    /* multithreaded windows */
+    struct aws_checksums_parallel_options parallel = {
+        .max_threads = 3,
+        .chunk_size = 64 * 1024,
+    };
+    options.parallel = &parallel;
+    ASSERT_SUCCESS(s_check_file_range(allocator, buffer, 0, AWS_CHECKSUMS_FILE_TO_END, &options));
+    ASSERT_SUCCESS(s_check_file_range(allocator, buffer, 777, 3 * 1024 * 1024, &options));
+
+    aws_mem_release(allocator, buffer);
+    remove(s_test_file_path);
+    aws_checksums_library_clean_up();
+
+    return AWS_OP_SUCCESS;
+}
+AWS_TEST_CASE(test_file_checksums, s_test_file_checksums)
+
+static int s_test_file_checksums_invalid(struct aws_allocator *allocator, void *ctx) {
+    (void)ctx;
+
+    aws_checksums_library_init(allocator);
+    uint8_t *buffer = s_write_test_file(allocator);
+
+    uint32_t crc32c = 0;
+    uint64_t crc64 = 0;
+
+    /* ranges past the end of the file */
+    ASSERT_ERROR(
+        AWS_ERROR_INVALID_ARGUMENT,
+        aws_checksums_file_crc32c(allocator, s_test_file_path, TEST_FILE_SIZE + 1, 0, NULL, &crc32c));
+    ASSERT_ERROR(
+        AWS_ERROR_INVALID_ARGUMENT,
+        aws_checksums_file_crc64nvme(allocator, s_test_file_path, 1, TEST_FILE_SIZE, NULL, &crc64));
+
+    ASSERT_ERROR(
+        AWS_ERROR_INVALID_ARGUMENT,
+        aws_checksums_file_crc32c(allocator, NULL, 0, AWS_CHECKSUMS_FILE_TO_END, NULL, &crc32c));
+    ASSERT_ERROR(
+        AWS_ERROR_INVALID_ARGUMENT,
+        aws_checksums_file_crc32c(allocator, s_test_file_path, 0, AWS_CHECKSUMS_FILE_TO_END, NULL, NULL));
+
+    ASSERT_FAILS(aws_checksums_file_crc64nvme(
+        allocator, "aws_checksums_file_that_does_not_exist.bin", 0, AWS_CHECKSUMS_FILE_TO_END, NULL, &crc64));
+
+    aws_mem_release(allocator, buffer);
+    remove(s_test_file_path);
+    aws_checksums_library_clean_up();
+
+    return AWS_OP_SUCCESS;
+}
+AWS_TEST_CASE(test_file_checksums_invalid, s_test_file_checksums_invalid)
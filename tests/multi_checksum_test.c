@@ -0,0 +1,118 @@
+/**
+ * Copyright Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0.
+ */
+
+#include <aws/checksums/checksums.h>
+#include <aws/checksums/crc.h>
+#include <aws/checksums/multi_checksum.h>
+#include <aws/checksums/xxhash.h>
+#include <aws/testing/aws_test_harness.h>
+
+#define TEST_BUFFER_SIZE (100 * 1024 + 7)
+
+static int s_check_digest(
+    struct aws_multi_checksum *checksum,
+    enum aws_multi_checksum_algorithm algorithm,
+    const struct aws_byte_buf *expected) {
+
+    uint8_t digest_storage[16] = {0};
+    struct aws_byte_buf digest = aws_byte_buf_from_empty_array(digest_storage, sizeof(digest_storage));
+    ASSERT_SUCCESS(aws_multi_checksum_finalize(checksum, algorithm, &digest));
+    ASSERT_BIN_ARRAYS_EQUALS(expected->buffer, expected->len, digest.buffer, digest.len);
+    return AWS_OP_SUCCESS;
+}
+
+static int s_test_multi_checksum(struct aws_allocator *allocator, void *ctx) {
+    (void)ctx;
+
+    aws_checksums_library_init(allocator);
+
+    uint8_t *buffer = aws_mem_acquire(allocator, TEST_BUFFER_SIZE);
+    for (size_t i = 0; i < TEST_BUFFER_SIZE; ++i) {
+        buffer[i] = (uint8_t)(i * 151 + 13);
+    }
+    struct aws_byte_cursor input = aws_byte_cursor_from_array(buffer, TEST_BUFFER_SIZE);
+    const uint64_t seed = 42;
+
+    uint8_t expected_storage[6][16] = {{0}};
+    struct aws_byte_buf expected[6];
+    for (size_t i = 0; i < 6; ++i) {
+        expected[i] = aws_byte_buf_from_empty_array(expected_storage[i], sizeof(expected_storage[i]));
+    }
+    aws_byte_buf_write_be32(&expected[0], aws_checksums_crc32_ex(buffer, TEST_BUFFER_SIZE, 0));
+    aws_byte_buf_write_be32(&expected[1], aws_checksums_crc32c_ex(buffer, TEST_BUFFER_SIZE, 0));
+    aws_byte_buf_write_be64(&expected[2], aws_checksums_crc64nvme_ex(buffer, TEST_BUFFER_SIZE, 0));
+    ASSERT_SUCCESS(aws_xxhash64_compute(seed, input, &expected[3]));
+    ASSERT_SUCCESS(aws_xxhash3_64_compute(seed, input, &expected[4]));
+    ASSERT_SUCCESS(aws_xxhash3_128_compute(seed, input, &expected[5]));
+
+    /* every algorithm, fed in pieces that straddle the internal blocks */
+    struct aws_multi_checksum *checksum = aws_multi_checksum_new(allocator, 0x3f, seed);
+    ASSERT_NOT_NULL(checksum);
+    struct aws_byte_cursor remaining = input;
+    const size_t pieces[] = {0, 1, 100, 16 * 1024, 40 * 1024 + 3};
+    for (size_t i = 0; i < AWS_ARRAY_SIZE(pieces); ++i) {
+        ASSERT_SUCCESS(aws_multi_checksum_update(checksum, aws_byte_cursor_advance(&remaining, pieces[i])));
+    }
+    ASSERT_SUCCESS(aws_multi_checksum_update(checksum, remaining));
+
+    for (size_t i = 0; i < 6; ++i) {
+        ASSERT_SUCCESS(s_check_digest(checksum, (enum aws_multi_checksum_algorithm)(1 << i), &expected[i]));
+    }
+    aws_multi_checksum_destroy(checksum);
+
+    /* the common pairs */
+    checksum = aws_multi_checksum_new(allocator, AWS_MULTI_CHECKSUM_CRC32C | AWS_MULTI_CHECKSUM_CRC64NVME, seed);
+    ASSERT_SUCCESS(aws_multi_checksum_update(checksum, input));
+    ASSERT_SUCCESS(s_check_digest(checksum, AWS_MULTI_CHECKSUM_CRC32C, &expected[1]));
+    ASSERT_SUCCESS(s_check_digest(checksum, AWS_MULTI_CHECKSUM_CRC64NVME, &expected[2]));
+    aws_multi_checksum_destroy(checksum);
+
+    checksum = aws_multi_checksum_new(allocator, AWS_MULTI_CHECKSUM_CRC32 | AWS_MULTI_CHECKSUM_XXHASH3_64, seed);
+    ASSERT_SUCCESS(aws_multi_checksum_update(checksum, input));
+    ASSERT_SUCCESS(s_check_digest(checksum, AWS_MULTI_CHECKSUM_CRC32, &expected[0]));
+    ASSERT_SUCCESS(s_check_digest(checksum, AWS_MULTI_CHECKSUM_XXHASH3_64, &expected[4]));
+    aws_multi_checksum_destroy(checksum);
+
+    aws_mem_release(allocator, buffer);
+    aws_checksums_library_clean_up();
+
+    return AWS_OP_SUCCESS;
+}
+AWS_TEST_CASE(test_multi_checksum, s_test_multi_checksum)
+
+static int s_test_multi_checksum_invalid(struct aws_allocator *allocator, void *ctx) {
+    (void)ctx;
+
+    aws_checksums_library_init(allocator);
+
+    ASSERT_NULL(aws_multi_checksum_new(allocator, 0, 0));
+    ASSERT_INT_EQUALS(AWS_ERROR_INVALID_ARGUMENT, aws_last_error());
+    ASSERT_NULL(aws_multi_checksum_new(allocator, 1 << 6, 0));
+    ASSERT_INT_EQUALS(AWS_ERROR_INVALID_ARGUMENT, aws_last_error());
+
+    struct aws_multi_checksum *checksum = aws_multi_checksum_new(allocator, AWS_MULTI_CHECKSUM_CRC64NVME, 0);
+    ASSERT_NOT_NULL(checksum);
+
+    uint8_t digest_storage[8] = {0};
+    struct aws_byte_buf digest = aws_byte_buf_from_empty_array(digest_storage, sizeof(digest_storage));
+    ASSERT_ERROR(AWS_ERROR_INVALID_ARGUMENT, aws_multi_checksum_finalize(checksum, AWS_MULTI_CHECKSUM_CRC32C, &digest));
+
+    digest.capacity = 7;
+    ASSERT_ERROR(
+        AWS_ERROR_INVALID_BUFFER_SIZE, aws_multi_checksum_finalize(checksum, AWS_MULTI_CHECKSUM_CRC64NVME, &digest));
+
+    /* nothing fed yet, so the crc of no data */
+    digest.capacity = 8;
+    ASSERT_SUCCESS(aws_multi_checksum_finalize(checksum, AWS_MULTI_CHECKSUM_CRC64NVME, &digest));
+    ASSERT_UINT_EQUALS(8, digest.len);
+
+    aws_multi_checksum_destroy(checksum);
+    aws_multi_checksum_destroy(NULL);
+
+    aws_checksums_library_clean_up();
+
+    return AWS_OP_SUCCESS;
+}
+AWS_TEST_CASE(test_multi_checksum_invalid, s_test_multi_checksum_invalid)
@@ -0,0 +1,142 @@
+/**
+ * Copyright Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0.
+ */
+
+#include <aws/checksums/checksums.h>
+#include <aws/checksums/crc.h>
+#include <aws/checksums/rolling_crc.h>
+
+#include <aws/testing/aws_test_harness.h>
+
+static void s_fill(uint8_t *buffer, size_t len) {
+    uint64_t state = 0x9E3779B97F4A7C15ULL;
+    for (size_t i = 0; i < len; ++i) {
+        state ^= state << 13;
+        state ^= state >> 7;
+        state ^= state << 17;
+        buffer[i] = (uint8_t)state;
+    }
+}
+
+static int s_test_rolling_crc32c(struct aws_allocator *allocator, void *ctx) {
+    (void)ctx;
+
+    aws_checksums_library_init(allocator);
+
+    const size_t len = 4096;
+    uint8_t *buffer = aws_mem_acquire(allocator, len);
+    s_fill(buffer, len);
+
+    const size_t window_sizes[] = {1, 3, 16, 48, 64, 255, 1000};
+    for (size_t w = 0; w < AWS_ARRAY_SIZE(window_sizes); ++w) {
+        const size_t window_size = window_sizes[w];
+        struct aws_rolling_crc32c rolling;
+        ASSERT_SUCCESS(aws_rolling_crc32c_init(&rolling, window_size));
+
+        /* rolling in the first window from the initial zero window */
+        uint32_t crc = 0;
+        for (size_t i = 0; i < window_size; ++i) {
+            crc = aws_rolling_crc32c_roll(&rolling, buffer[i], 0);
+        }
+        ASSERT_HEX_EQUALS(aws_checksums_crc32c_ex(buffer, window_size, 0), crc, "window %zu", window_size);
+
+        for (size_t end = window_size + 1; end <= len; ++end) {
+            crc = aws_rolling_crc32c_roll(&rolling, buffer[end - 1], buffer[end - 1 - window_size]);
+            ASSERT_HEX_EQUALS(
+                aws_checksums_crc32c_ex(buffer + end - window_size, window_size, 0),
+                crc,
+                "window %zu end %zu",
+                window_size,
+                end);
+        }
+
+        ASSERT_HEX_EQUALS(
+            aws_checksums_crc32c_ex(buffer + 7, window_size, 0), aws_rolling_crc32c_reset(&rolling, buffer + 7));
+        ASSERT_HEX_EQUALS(
+            aws_checksums_crc32c_ex(buffer + 8, window_size, 0),
+            aws_rolling_crc32c_roll(&rolling, buffer[7 + window_size], buffer[7]));
+    }
+
+    struct aws_rolling_crc32c rolling;
+    ASSERT_ERROR(AWS_ERROR_INVALID_ARGUMENT, aws_rolling_crc32c_init(&rolling, 0));
+
+    aws_mem_release(allocator, buffer);
+    aws_checksums_library_clean_up();
+
+    return AWS_OP_SUCCESS;
+}
+AWS_TEST_CASE(test_rolling_crc32c, s_test_rolling_crc32c)
+
+static int s_test_rolling_crc32c_scan(struct aws_allocator *allocator, void *ctx) {
+    (void)ctx;
+
+    aws_checksums_library_init(allocator);
+
+    /* long enough for several blocks of interleaved lanes */
+    const size_t len = 64 * 1024 + 77;
+    uint8_t *buffer = aws_mem_acquire(allocator, len);
+    s_fill(buffer, len);
+
+    const size_t window_sizes[] = {1, 48, 4096 + 3};
+    /* from boundaries every few bytes, several per lane, to none at all */
+    const uint32_t masks[] = {0, 0x3, 0xff, 0xfff, 0x7fff, 0xffffffff};
+    for (size_t w = 0; w < AWS_ARRAY_SIZE(window_sizes); ++w) {
+        const size_t window_size = window_sizes[w];
+        struct aws_rolling_crc32c rolling;
+        ASSERT_SUCCESS(aws_rolling_crc32c_init(&rolling, window_size));
+
+        for (size_t m = 0; m < AWS_ARRAY_SIZE(masks); ++m) {
+            const uint32_t mask = masks[m];
+
+            /* every boundary, as a chunker would find them, against checksumming every window */
+            size_t start = 0;
+            size_t expected_end = window_size;
+            while (true) {
+                while (expected_end <= len &&
+                       (aws_checksums_crc32c_ex(buffer + expected_end - window_size, window_size, 0) & mask) != 0) {
+                    ++expected_end;
+                }
+
+                size_t end = 0;
+                bool found = aws_rolling_crc32c_scan(&rolling, buffer + start, len - start, mask, &end);
+                if (expected_end > len) {
+                    ASSERT_FALSE(found, "window %zu mask %x start %zu", window_size, mask, start);
+                    if (len - start >= window_size) {
+                        /* rolling is left on the last window */
+                        const uint8_t next = 0x5a;
+                        uint32_t expected =
+                            aws_checksums_crc32c_ex(buffer + len + 1 - window_size, window_size - 1, 0);
+                        expected = aws_checksums_crc32c_ex(&next, 1, expected);
+                        ASSERT_HEX_EQUALS(
+                            expected, aws_rolling_crc32c_roll(&rolling, next, buffer[len - window_size]));
+                    }
+                    break;
+                }
+                ASSERT_TRUE(found, "window %zu mask %x start %zu", window_size, mask, start);
+                ASSERT_UINT_EQUALS(
+                    expected_end, start + end, "window %zu mask %x start %zu", window_size, mask, start);
+
+                /* rolling is left on the matching window */
+                if (expected_end < len) {
+                    ASSERT_HEX_EQUALS(
+                        aws_checksums_crc32c_ex(buffer + expected_end + 1 - window_size, window_size, 0),
+                        aws_rolling_crc32c_roll(&rolling, buffer[expected_end], buffer[expected_end - window_size]));
+                }
+
+                /* the next chunk is at least a window long */
+                start = expected_end;
+                expected_end = start + window_size;
+            }
+        }
+
+        size_t end = 0;
+        ASSERT_FALSE(aws_rolling_crc32c_scan(&rolling, buffer, window_size - 1, 0, &end));
+    }
+
+    aws_mem_release(allocator, buffer);
+    aws_checksums_library_clean_up();
+
+    return AWS_OP_SUCCESS;
+}
+AWS_TEST_CASE(test_rolling_crc32c_scan, s_test_rolling_crc32c_scan)
@@ -5,8 +5,17 @@
 
 #include <aws/checksums/checksums.h>
 #include <aws/checksums/xxhash.h>
+#include <aws/common/math.h>
 #include <aws/testing/aws_test_harness.h>
 
+#if defined(AWS_CHECKSUMS_HAVE_SVE) && defined(__linux__)
+#    include <aws/checksums/private/xxhash_priv.h>
+#    include <sys/auxv.h>
+#    ifndef HWCAP_SVE
+#        define HWCAP_SVE (1 << 22)
+#    endif
+#endif
+
 static const char *TEST_VECTOR = "abcdefghijklmnopqrstuvwxyz";
 
 static int s_test_xxhash64(struct aws_allocator *allocator, void *ctx) {
@@ -202,3 +211,520 @@ static int s_test_xxhash3_128_generic(struct aws_allocator *allocator, void *ctx
     return AWS_OP_SUCCESS;
 }
 AWS_TEST_CASE(test_xxhash3_128_generic, s_test_xxhash3_128_generic)
+
+static int s_test_xxhash_inplace_reset(struct aws_allocator *allocator, void *ctx) {
+    (void)ctx;
+
+    aws_checksums_library_init(allocator);
+
+    /* long enough to go through the XXH3 stripe loop */
+    uint8_t buffer[1000];
+    for (size_t i = 0; i < sizeof(buffer); ++i) {
+        buffer[i] = (uint8_t)(i * 31 + 7);
+    }
+    struct aws_byte_cursor input = aws_byte_cursor_from_array(buffer, sizeof(buffer));
+
+    const enum aws_xxhash_type types[] = {XXHASH64, XXHASH3_64, XXHASH3_128, XXHASH3_TREE};
+    const uint64_t seeds[] = {0, 0x9E3779B97F4A7C15};
+
+    for (size_t t = 0; t < AWS_ARRAY_SIZE(types); ++t) {
+        for (size_t s = 0; s < AWS_ARRAY_SIZE(seeds); ++s) {
+            uint8_t expected_storage[16] = {0};
+            struct aws_byte_buf expected = aws_byte_buf_from_empty_array(expected_storage, sizeof(expected_storage));
+            switch (types[t]) {
+                case XXHASH64:
+                    ASSERT_SUCCESS(aws_xxhash64_compute(seeds[s], input, &expected));
+                    break;
+                case XXHASH3_64:
+                    ASSERT_SUCCESS(aws_xxhash3_64_compute(seeds[s], input, &expected));
+                    break;
+                case XXHASH3_128:
+                    ASSERT_SUCCESS(aws_xxhash3_128_compute(seeds[s], input, &expected));
+                    break;
+                case XXHASH3_TREE:
+                    ASSERT_SUCCESS(aws_xxhash3_tree_compute(allocator, seeds[s], input, NULL, &expected));
+                    break;
+            }
+
+            uint8_t result_storage[16] = {0};
+            struct aws_byte_buf result = aws_byte_buf_from_empty_array(result_storage, sizeof(result_storage));
+
+            struct aws_xxhash_inplace storage;
+            struct aws_xxhash_tree_inplace tree_storage;
+            struct aws_xxhash *hash = types[t] == XXHASH3_TREE ? aws_xxhash3_tree_init_inplace(&tree_storage, seeds[s])
+                                                               : aws_xxhash_init_inplace(&storage, types[t], seeds[s]);
+            ASSERT_NOT_NULL(hash);
+            ASSERT_SUCCESS(aws_xxhash_update(hash, aws_byte_cursor_from_array(buffer, 100)));
+            ASSERT_SUCCESS(aws_xxhash_update(hash, aws_byte_cursor_from_array(buffer + 100, sizeof(buffer) - 100)));
+            ASSERT_SUCCESS(aws_xxhash_finalize(hash, &result));
+            ASSERT_BIN_ARRAYS_EQUALS(expected.buffer, expected.len, result.buffer, result.len);
+
+            /* reused for a different input, then back to the original */
+            ASSERT_SUCCESS(aws_xxhash_reset(hash, seeds[s] + 1));
+            ASSERT_SUCCESS(aws_xxhash_update(hash, aws_byte_cursor_from_c_str(TEST_VECTOR)));
+            ASSERT_SUCCESS(aws_xxhash_reset(hash, seeds[s]));
+            ASSERT_SUCCESS(aws_xxhash_update(hash, input));
+            aws_byte_buf_reset(&result, false);
+            ASSERT_SUCCESS(aws_xxhash_finalize(hash, &result));
+            ASSERT_BIN_ARRAYS_EQUALS(expected.buffer, expected.len, result.buffer, result.len);
+            aws_xxhash_destroy(hash);
+
+            /* the allocated variant resets the same way */
+            hash = types[t] == XXHASH64      ? aws_xxhash64_new(allocator, 0)
+                   : types[t] == XXHASH3_64  ? aws_xxhash3_64_new(allocator, 0)
+                   : types[t] == XXHASH3_128 ? aws_xxhash3_128_new(allocator, 0)
+                                             : aws_xxhash3_tree_new(allocator, 0);
+            ASSERT_NOT_NULL(hash);
+            ASSERT_SUCCESS(aws_xxhash_update(hash, aws_byte_cursor_from_c_str(TEST_VECTOR)));
+            ASSERT_SUCCESS(aws_xxhash_reset(hash, seeds[s]));
+            ASSERT_SUCCESS(aws_xxhash_update(hash, input));
+            aws_byte_buf_reset(&result, false);
+            ASSERT_SUCCESS(aws_xxhash_finalize(hash, &result));
+            ASSERT_BIN_ARRAYS_EQUALS(expected.buffer, expected.len, result.buffer, result.len);
+            aws_xxhash_destroy(hash);
+        }
+    }
+
+    struct aws_xxhash_inplace storage;
+    ASSERT_NULL(aws_xxhash_init_inplace(&storage, (enum aws_xxhash_type)4, 0));
+    ASSERT_INT_EQUALS(AWS_ERROR_INVALID_ARGUMENT, aws_last_error());
+    /* the tree needs two states, more than struct aws_xxhash_inplace holds */
+    ASSERT_NULL(aws_xxhash_init_inplace(&storage, XXHASH3_TREE, 0));
+    ASSERT_INT_EQUALS(AWS_ERROR_INVALID_ARGUMENT, aws_last_error());
+
+    aws_checksums_library_clean_up();
+
+    return AWS_OP_SUCCESS;
+}
+AWS_TEST_CASE(test_xxhash_inplace_reset, s_test_xxhash_inplace_reset)
+
+static int s_test_xxhash3_seeded_hasher(struct aws_allocator *allocator, void *ctx) {
+    (void)ctx;
+
+    aws_checksums_library_init(allocator);
+
+    /* lengths on both sides of the 240 byte cut-off where the secret starts being used, and a multi-block one */
+    const size_t lengths[] = {0, 1, 17, 240, 241, 1024, 5000};
+    const uint64_t seeds[] = {0, 1, 0x9E3779B97F4A7C15};
+    uint8_t buffer[5000];
+    for (size_t i = 0; i < sizeof(buffer); ++i) {
+        buffer[i] = (uint8_t)(i * 13 + 5);
+    }
+
+    for (size_t s = 0; s < AWS_ARRAY_SIZE(seeds); ++s) {
+        struct aws_xxhash3_seeded_hasher hasher;
+        aws_xxhash3_seeded_hasher_init(&hasher, seeds[s]);
+
+        for (size_t l = 0; l < AWS_ARRAY_SIZE(lengths); ++l) {
+            struct aws_byte_cursor input = aws_byte_cursor_from_array(buffer, lengths[l]);
+            uint8_t expected_storage[16] = {0};
+            uint8_t result_storage[16] = {0};
+            struct aws_byte_buf expected = aws_byte_buf_from_empty_array(expected_storage, sizeof(expected_storage));
+            struct aws_byte_buf result = aws_byte_buf_from_empty_array(result_storage, sizeof(result_storage));
+
+            ASSERT_SUCCESS(aws_xxhash3_64_compute(seeds[s], input, &expected));
+            ASSERT_SUCCESS(aws_xxhash3_64_compute_seeded(&hasher, input, &result));
+            ASSERT_BIN_ARRAYS_EQUALS(expected.buffer, expected.len, result.buffer, result.len);
+
+            struct aws_xxhash_inplace storage;
+            struct aws_xxhash *hash = aws_xxhash_init_inplace(&storage, XXHASH3_64, 0);
+            ASSERT_SUCCESS(aws_xxhash_reset_seeded(hash, &hasher));
+            ASSERT_SUCCESS(aws_xxhash_update(hash, aws_byte_cursor_advance(&input, input.len / 3)));
+            ASSERT_SUCCESS(aws_xxhash_update(hash, input));
+            aws_byte_buf_reset(&result, false);
+            ASSERT_SUCCESS(aws_xxhash_finalize(hash, &result));
+            ASSERT_BIN_ARRAYS_EQUALS(expected.buffer, expected.len, result.buffer, result.len);
+
+            input = aws_byte_cursor_from_array(buffer, lengths[l]);
+            aws_byte_buf_reset(&expected, false);
+            aws_byte_buf_reset(&result, false);
+            ASSERT_SUCCESS(aws_xxhash3_128_compute(seeds[s], input, &expected));
+            ASSERT_SUCCESS(aws_xxhash3_128_compute_seeded(&hasher, input, &result));
+            ASSERT_BIN_ARRAYS_EQUALS(expected.buffer, expected.len, result.buffer, result.len);
+
+            hash = aws_xxhash3_128_new(allocator, 0);
+            ASSERT_SUCCESS(aws_xxhash_reset_seeded(hash, &hasher));
+            ASSERT_SUCCESS(aws_xxhash_update(hash, input));
+            aws_byte_buf_reset(&result, false);
+            ASSERT_SUCCESS(aws_xxhash_finalize(hash, &result));
+            ASSERT_BIN_ARRAYS_EQUALS(expected.buffer, expected.len, result.buffer, result.len);
+            aws_xxhash_destroy(hash);
+        }
+    }
+
+    struct aws_xxhash3_seeded_hasher hasher;
+    aws_xxhash3_seeded_hasher_init(&hasher, 1);
+    struct aws_xxhash *hash = aws_xxhash64_new(allocator, 0);
+    ASSERT_ERROR(AWS_ERROR_INVALID_ARGUMENT, aws_xxhash_reset_seeded(hash, &hasher));
+    aws_xxhash_destroy(hash);
+
+    uint8_t small_storage[15] = {0};
+    struct aws_byte_buf small = aws_byte_buf_from_empty_array(small_storage, sizeof(small_storage));
+    ASSERT_ERROR(
+        AWS_ERROR_INVALID_BUFFER_SIZE,
+        aws_xxhash3_128_compute_seeded(&hasher, aws_byte_cursor_from_c_str(TEST_VECTOR), &small));
+
+    aws_checksums_library_clean_up();
+
+    return AWS_OP_SUCCESS;
+}
+AWS_TEST_CASE(test_xxhash3_seeded_hasher, s_test_xxhash3_seeded_hasher)
+
+static int s_test_xxhash3_secret(struct aws_allocator *allocator, void *ctx) {
+    (void)ctx;
+
+    aws_checksums_library_init(allocator);
+
+    const size_t lengths[] = {0, 3, 16, 128, 240, 241, 1024, 5000};
+    uint8_t buffer[5000];
+    for (size_t i = 0; i < sizeof(buffer); ++i) {
+        buffer[i] = (uint8_t)(i * 29 + 1);
+    }
+
+    /* the secret derived from seed 0 is the default one, so keyed hashing with it matches the unseeded hash */
+    struct aws_xxhash3_seeded_hasher default_secret;
+    aws_xxhash3_seeded_hasher_init(&default_secret, 0);
+    struct aws_byte_cursor default_cursor = aws_byte_cursor_from_array(default_secret.secret, AWS_XXHASH3_SECRET_SIZE);
+
+    uint8_t secret_storage[AWS_XXHASH3_SECRET_SIZE] = {0};
+    struct aws_byte_buf secret = aws_byte_buf_from_empty_array(secret_storage, sizeof(secret_storage));
+    struct aws_byte_cursor key = aws_byte_cursor_from_c_str("tenant key");
+    ASSERT_SUCCESS(aws_xxhash3_generate_secret(key, sizeof(secret_storage), &secret));
+    ASSERT_UINT_EQUALS(AWS_XXHASH3_SECRET_SIZE, secret.len);
+    struct aws_byte_cursor secret_cursor = aws_byte_cursor_from_buf(&secret);
+
+    /* the shortest secret allowed */
+    uint8_t min_secret_storage[AWS_XXHASH3_SECRET_SIZE_MIN] = {0};
+    struct aws_byte_buf min_secret = aws_byte_buf_from_empty_array(min_secret_storage, sizeof(min_secret_storage));
+    ASSERT_SUCCESS(aws_xxhash3_generate_secret(key, AWS_XXHASH3_SECRET_SIZE_MIN, &min_secret));
+    struct aws_byte_cursor min_secret_cursor = aws_byte_cursor_from_buf(&min_secret);
+
+    for (size_t l = 0; l < AWS_ARRAY_SIZE(lengths); ++l) {
+        struct aws_byte_cursor input = aws_byte_cursor_from_array(buffer, lengths[l]);
+        uint8_t expected_storage[16] = {0};
+        uint8_t result_storage[16] = {0};
+        struct aws_byte_buf expected = aws_byte_buf_from_empty_array(expected_storage, sizeof(expected_storage));
+        struct aws_byte_buf result = aws_byte_buf_from_empty_array(result_storage, sizeof(result_storage));
+
+        ASSERT_SUCCESS(aws_xxhash3_64_compute(0, input, &expected));
+        ASSERT_SUCCESS(aws_xxhash3_64_compute_with_secret(default_cursor, input, &result));
+        ASSERT_BIN_ARRAYS_EQUALS(expected.buffer, expected.len, result.buffer, result.len);
+
+        aws_byte_buf_reset(&expected, false);
+        aws_byte_buf_reset(&result, false);
+        ASSERT_SUCCESS(aws_xxhash3_128_compute(0, input, &expected));
+        ASSERT_SUCCESS(aws_xxhash3_128_compute_with_secret(default_cursor, input, &result));
+        ASSERT_BIN_ARRAYS_EQUALS(expected.buffer, expected.len, result.buffer, result.len);
+
+        /* custom secrets, one-shot against streaming in two pieces */
+        const struct aws_byte_cursor secrets[] = {secret_cursor, min_secret_cursor};
+        const enum aws_xxhash_type types[] = {XXHASH3_64, XXHASH3_128};
+        for (size_t s = 0; s < AWS_ARRAY_SIZE(secrets); ++s) {
+            for (size_t t = 0; t < AWS_ARRAY_SIZE(types); ++t) {
+                aws_byte_buf_reset(&expected, false);
+                aws_byte_buf_reset(&result, false);
+                if (types[t] == XXHASH3_64) {
+                    ASSERT_SUCCESS(aws_xxhash3_64_compute_with_secret(secrets[s], input, &expected));
+                } else {
+                    ASSERT_SUCCESS(aws_xxhash3_128_compute_with_secret(secrets[s], input, &expected));
+                }
+
+                struct aws_xxhash_inplace storage;
+                struct aws_xxhash *hash = aws_xxhash_init_inplace(&storage, types[t], 0);
+                ASSERT_SUCCESS(aws_xxhash_reset_with_secret(hash, secrets[s]));
+                struct aws_byte_cursor remaining = input;
+                ASSERT_SUCCESS(aws_xxhash_update(hash, aws_byte_cursor_advance(&remaining, remaining.len / 2)));
+                ASSERT_SUCCESS(aws_xxhash_update(hash, remaining));
+                ASSERT_SUCCESS(aws_xxhash_finalize(hash, &result));
+                ASSERT_BIN_ARRAYS_EQUALS(expected.buffer, expected.len, result.buffer, result.len);
+            }
+        }
+    }
+
+    /* keyed hashes depend on the key */
+    uint8_t other_storage[AWS_XXHASH3_SECRET_SIZE] = {0};
+    struct aws_byte_buf other = aws_byte_buf_from_empty_array(other_storage, sizeof(other_storage));
+    struct aws_byte_cursor other_key = aws_byte_cursor_from_c_str("tenant kez");
+    ASSERT_SUCCESS(aws_xxhash3_generate_secret(other_key, sizeof(other_storage), &other));
+    ASSERT_FALSE(aws_byte_buf_eq(&secret, &other));
+    aws_byte_buf_reset(&other, false);
+    ASSERT_SUCCESS(aws_xxhash3_generate_secret(key, sizeof(other_storage), &other));
+    ASSERT_TRUE(aws_byte_buf_eq(&secret, &other));
+
+    /* invalid secrets and buffers */
+    uint8_t digest_storage[16] = {0};
+    struct aws_byte_buf digest = aws_byte_buf_from_empty_array(digest_storage, sizeof(digest_storage));
+    struct aws_byte_cursor short_secret = aws_byte_cursor_from_array(secret_storage, AWS_XXHASH3_SECRET_SIZE_MIN - 1);
+    struct aws_byte_cursor input = aws_byte_cursor_from_c_str(TEST_VECTOR);
+    ASSERT_ERROR(AWS_ERROR_INVALID_ARGUMENT, aws_xxhash3_64_compute_with_secret(short_secret, input, &digest));
+    ASSERT_ERROR(AWS_ERROR_INVALID_ARGUMENT, aws_xxhash3_128_compute_with_secret(short_secret, input, &digest));
+    ASSERT_ERROR(
+        AWS_ERROR_INVALID_ARGUMENT,
+        aws_xxhash3_generate_secret(input, AWS_XXHASH3_SECRET_SIZE_MIN - 1, &other));
+    aws_byte_buf_reset(&other, false);
+    ASSERT_ERROR(
+        AWS_ERROR_INVALID_BUFFER_SIZE, aws_xxhash3_generate_secret(input, AWS_XXHASH3_SECRET_SIZE + 1, &other));
+
+    struct aws_xxhash *hash = aws_xxhash64_new(allocator, 0);
+    ASSERT_ERROR(AWS_ERROR_INVALID_ARGUMENT, aws_xxhash_reset_with_secret(hash, secret_cursor));
+    aws_xxhash_destroy(hash);
+    hash = aws_xxhash3_64_new(allocator, 0);
+    ASSERT_ERROR(AWS_ERROR_INVALID_ARGUMENT, aws_xxhash_reset_with_secret(hash, short_secret));
+    aws_xxhash_destroy(hash);
+
+    aws_checksums_library_clean_up();
+
+    return AWS_OP_SUCCESS;
+}
+AWS_TEST_CASE(test_xxhash3_secret, s_test_xxhash3_secret)
+
+/*
+ * Dispatch only switches to the SVE kernels on cpus with vectors wider than 128 bits, so call them directly to cover
+ * them on every SVE cpu.
+ */
+static int s_test_xxhash3_sve_kernels(struct aws_allocator *allocator, void *ctx) {
+    (void)ctx;
+#if defined(AWS_CHECKSUMS_HAVE_SVE) && defined(__linux__)
+    if ((getauxval(AT_HWCAP) & HWCAP_SVE) == 0) {
+        return AWS_OP_SKIP;
+    }
+
+    aws_checksums_library_init(allocator);
+
+    /* the kernels are only used past 240 bytes, where xxh3 switches to the striped accumulate loop */
+    const size_t lengths[] = {241, 1024, 4113};
+    const uint64_t seeds[] = {0, 0xDEADBEEF};
+    uint8_t buffer[4113];
+    for (size_t i = 0; i < sizeof(buffer); ++i) {
+        buffer[i] = (uint8_t)(i * 37 + 5);
+    }
+
+    uint8_t secret_storage[AWS_XXHASH3_SECRET_SIZE] = {0};
+    struct aws_byte_buf secret = aws_byte_buf_from_empty_array(secret_storage, sizeof(secret_storage));
+    ASSERT_SUCCESS(aws_xxhash3_generate_secret(aws_byte_cursor_from_c_str("sve key"), sizeof(secret_storage), &secret));
+    struct aws_byte_cursor secret_cursor = aws_byte_cursor_from_buf(&secret);
+
+    for (size_t l = 0; l < AWS_ARRAY_SIZE(lengths); ++l) {
+        struct aws_byte_cursor input = aws_byte_cursor_from_array(buffer, lengths[l]);
+        uint8_t expected_storage[16] = {0};
+        uint8_t result_storage[16] = {0};
+        struct aws_byte_buf expected = aws_byte_buf_from_empty_array(expected_storage, sizeof(expected_storage));
+        struct aws_byte_buf result = aws_byte_buf_from_empty_array(result_storage, sizeof(result_storage));
+        uint64_t low64 = 0;
+        uint64_t high64 = 0;
+
+        for (size_t s = 0; s < AWS_ARRAY_SIZE(seeds); ++s) {
+            aws_byte_buf_reset(&expected, false);
+            aws_byte_buf_reset(&result, false);
+            ASSERT_SUCCESS(aws_xxhash3_64_compute(seeds[s], input, &expected));
+            ASSERT_TRUE(aws_byte_buf_write_be64(
+                &result, aws_checksums_xxh3_64_seed_sve(input.ptr, input.len, seeds[s])));
+            ASSERT_BIN_ARRAYS_EQUALS(expected.buffer, expected.len, result.buffer, result.len);
+
+            aws_byte_buf_reset(&expected, false);
+            aws_byte_buf_reset(&result, false);
+            ASSERT_SUCCESS(aws_xxhash3_128_compute(seeds[s], input, &expected));
+            aws_checksums_xxh3_128_seed_sve(input.ptr, input.len, seeds[s], &low64, &high64);
+            ASSERT_TRUE(aws_byte_buf_write_be64(&result, high64));
+            ASSERT_TRUE(aws_byte_buf_write_be64(&result, low64));
+            ASSERT_BIN_ARRAYS_EQUALS(expected.buffer, expected.len, result.buffer, result.len);
+        }
+
+        aws_byte_buf_reset(&expected, false);
+        aws_byte_buf_reset(&result, false);
+        ASSERT_SUCCESS(aws_xxhash3_64_compute_with_secret(secret_cursor, input, &expected));
+        ASSERT_TRUE(aws_byte_buf_write_be64(
+            &result,
+            aws_checksums_xxh3_64_secret_sve(input.ptr, input.len, secret_cursor.ptr, secret_cursor.len)));
+        ASSERT_BIN_ARRAYS_EQUALS(expected.buffer, expected.len, result.buffer, result.len);
+
+        aws_byte_buf_reset(&expected, false);
+        aws_byte_buf_reset(&result, false);
+        ASSERT_SUCCESS(aws_xxhash3_128_compute_with_secret(secret_cursor, input, &expected));
+        aws_checksums_xxh3_128_secret_sve(input.ptr, input.len, secret_cursor.ptr, secret_cursor.len, &low64, &high64);
+        ASSERT_TRUE(aws_byte_buf_write_be64(&result, high64));
+        ASSERT_TRUE(aws_byte_buf_write_be64(&result, low64));
+        ASSERT_BIN_ARRAYS_EQUALS(expected.buffer, expected.len, result.buffer, result.len);
+    }
+
+    aws_checksums_library_clean_up();
+
+    return AWS_OP_SUCCESS;
+#else
+    (void)allocator;
+    return AWS_OP_SKIP;
+#endif
+}
+AWS_TEST_CASE(test_xxhash3_sve_kernels, s_test_xxhash3_sve_kernels)
+
+static int s_test_xxhash_batch(struct aws_allocator *allocator, void *ctx) {
+    (void)ctx;
+
+    aws_checksums_library_init(allocator);
+
+    uint8_t data[1024];
+    for (size_t i = 0; i < sizeof(data); ++i) {
+        data[i] = (uint8_t)(i * 151 + 13);
+    }
+
+    /* short keys of every length up to 64, plus a few taking the long input path */
+    struct aws_byte_cursor keys[70];
+    for (size_t i = 0; i < 65; ++i) {
+        keys[i] = aws_byte_cursor_from_array(data + i, i);
+    }
+    keys[65] = aws_byte_cursor_from_array(data, 128);
+    keys[66] = aws_byte_cursor_from_array(data, 240);
+    keys[67] = aws_byte_cursor_from_array(data, 241);
+    keys[68] = aws_byte_cursor_from_array(data, 1000);
+    keys[69] = aws_byte_cursor_from_array(NULL, 0);
+
+    const uint64_t seeds[] = {0, 0xDEADBEEF};
+    for (size_t s = 0; s < AWS_ARRAY_SIZE(seeds); ++s) {
+        uint64_t xxh64[AWS_ARRAY_SIZE(keys)];
+        uint64_t xxh3[AWS_ARRAY_SIZE(keys)];
+        aws_xxhash64_batch(keys, seeds[s], xxh64, AWS_ARRAY_SIZE(keys));
+        aws_xxhash3_64_batch(keys, seeds[s], xxh3, AWS_ARRAY_SIZE(keys));
+
+        for (size_t i = 0; i < AWS_ARRAY_SIZE(keys); ++i) {
+            uint8_t digest_storage[8] = {0};
+            struct aws_byte_buf digest = aws_byte_buf_from_empty_array(digest_storage, sizeof(digest_storage));
+            struct aws_byte_cursor digest_cursor = aws_byte_cursor_from_array(digest_storage, sizeof(digest_storage));
+            uint64_t expected = 0;
+
+            ASSERT_SUCCESS(aws_xxhash64_compute(seeds[s], keys[i], &digest));
+            ASSERT_TRUE(aws_byte_cursor_read_be64(&digest_cursor, &expected));
+            ASSERT_UINT_EQUALS(expected, xxh64[i]);
+
+            aws_byte_buf_reset(&digest, false);
+            digest_cursor = aws_byte_cursor_from_array(digest_storage, sizeof(digest_storage));
+            ASSERT_SUCCESS(aws_xxhash3_64_compute(seeds[s], keys[i], &digest));
+            ASSERT_TRUE(aws_byte_cursor_read_be64(&digest_cursor, &expected));
+            ASSERT_UINT_EQUALS(expected, xxh3[i]);
+        }
+    }
+
+    /* an empty batch touches nothing */
+    aws_xxhash64_batch(NULL, 0, NULL, 0);
+    aws_xxhash3_64_batch(NULL, 0, NULL, 0);
+
+    aws_checksums_library_clean_up();
+
+    return AWS_OP_SUCCESS;
+}
+AWS_TEST_CASE(test_xxhash_batch, s_test_xxhash_batch)
+
+/* XXHASH3_TREE as documented at AWS_XXHASH3_TREE_LEAF_SIZE, built from plain XXH3_128. */
+static int s_tree_reference(
+    struct aws_allocator *allocator,
+    uint64_t seed,
+    struct aws_byte_cursor input,
+    struct aws_byte_buf *out) {
+
+    size_t leaf_count = (input.len + AWS_XXHASH3_TREE_LEAF_SIZE - 1) / AWS_XXHASH3_TREE_LEAF_SIZE;
+    struct aws_byte_buf root_input;
+    ASSERT_SUCCESS(aws_byte_buf_init(&root_input, allocator, leaf_count * 16 + 8));
+
+    uint64_t total_length = input.len;
+    while (input.len > 0) {
+        size_t leaf_length = aws_min_size(input.len, AWS_XXHASH3_TREE_LEAF_SIZE);
+        ASSERT_SUCCESS(aws_xxhash3_128_compute(seed, aws_byte_cursor_advance(&input, leaf_length), &root_input));
+    }
+    ASSERT_TRUE(aws_byte_buf_write_be64(&root_input, total_length));
+    ASSERT_SUCCESS(aws_xxhash3_128_compute(seed, aws_byte_cursor_from_buf(&root_input), out));
+
+    aws_byte_buf_clean_up(&root_input);
+    return AWS_OP_SUCCESS;
+}
+
+static int s_test_xxhash3_tree(struct aws_allocator *allocator, void *ctx) {
+    (void)ctx;
+
+    aws_checksums_library_init(allocator);
+
+    const size_t buffer_size = 3 * AWS_XXHASH3_TREE_LEAF_SIZE + 5;
+    uint8_t *buffer = aws_mem_acquire(allocator, buffer_size);
+    for (size_t i = 0; i < buffer_size; ++i) {
+        buffer[i] = (uint8_t)(i * 151 + 13);
+    }
+
+    /* one leaf runs through the parallel path per task, with more threads than tasks */
+    struct aws_checksums_parallel_options options = {
+        .max_threads = 4,
+        .chunk_size = AWS_XXHASH3_TREE_LEAF_SIZE,
+    };
+
+    const size_t lengths[] = {
+        0,
+        1,
+        AWS_XXHASH3_TREE_LEAF_SIZE - 1,
+        AWS_XXHASH3_TREE_LEAF_SIZE,
+        AWS_XXHASH3_TREE_LEAF_SIZE + 1,
+        2 * AWS_XXHASH3_TREE_LEAF_SIZE,
+        buffer_size,
+    };
+    const uint64_t seeds[] = {0, 0x9E3779B97F4A7C15};
+
+    for (size_t l = 0; l < AWS_ARRAY_SIZE(lengths); ++l) {
+        struct aws_byte_cursor input = aws_byte_cursor_from_array(buffer, lengths[l]);
+        for (size_t s = 0; s < AWS_ARRAY_SIZE(seeds); ++s) {
+            uint8_t expected_storage[16] = {0};
+            struct aws_byte_buf expected = aws_byte_buf_from_empty_array(expected_storage, sizeof(expected_storage));
+            ASSERT_SUCCESS(s_tree_reference(allocator, seeds[s], input, &expected));
+
+            uint8_t result_storage[16] = {0};
+            struct aws_byte_buf result = aws_byte_buf_from_empty_array(result_storage, sizeof(result_storage));
+            ASSERT_SUCCESS(aws_xxhash3_tree_compute(allocator, seeds[s], input, NULL, &result));
+            ASSERT_BIN_ARRAYS_EQUALS(expected.buffer, expected.len, result.buffer, result.len);
+
+            aws_byte_buf_reset(&result, false);
+            ASSERT_SUCCESS(aws_xxhash3_tree_compute(allocator, seeds[s], input, &options, &result));
+            ASSERT_BIN_ARRAYS_EQUALS(expected.buffer, expected.len, result.buffer, result.len);
+
+            /* streamed in pieces that straddle leaf boundaries, finalizing midway */
+            struct aws_xxhash *hash = aws_xxhash3_tree_new(allocator, seeds[s]);
+            ASSERT_NOT_NULL(hash);
+            struct aws_byte_cursor remaining = input;
+            const size_t piece = AWS_XXHASH3_TREE_LEAF_SIZE / 3 + 7;
+            while (remaining.len > 0) {
+                struct aws_byte_cursor next = aws_byte_cursor_advance(&remaining, aws_min_size(piece, remaining.len));
+                ASSERT_SUCCESS(aws_xxhash_update(hash, next));
+                aws_byte_buf_reset(&result, false);
+                ASSERT_SUCCESS(aws_xxhash_finalize(hash, &result));
+            }
+            aws_byte_buf_reset(&result, false);
+            ASSERT_SUCCESS(aws_xxhash_finalize(hash, &result));
+            ASSERT_BIN_ARRAYS_EQUALS(expected.buffer, expected.len, result.buffer, result.len);
+            aws_xxhash_destroy(hash);
+        }
+    }
+
+    /* the digest is not plain XXH3_128, even for inputs of a single leaf */
+    uint8_t tree_storage[16] = {0};
+    struct aws_byte_buf tree = aws_byte_buf_from_empty_array(tree_storage, sizeof(tree_storage));
+    uint8_t plain_storage[16] = {0};
+    struct aws_byte_buf plain = aws_byte_buf_from_empty_array(plain_storage, sizeof(plain_storage));
+    ASSERT_SUCCESS(aws_xxhash3_tree_compute(allocator, 0, aws_byte_cursor_from_c_str(TEST_VECTOR), NULL, &tree));
+    ASSERT_SUCCESS(aws_xxhash3_128_compute(0, aws_byte_cursor_from_c_str(TEST_VECTOR), &plain));
+    ASSERT_FALSE(aws_byte_buf_eq(&tree, &plain));
+
+    /* invalid arguments */
+    struct aws_byte_buf too_small = aws_byte_buf_from_empty_array(tree_storage, 15);
+    ASSERT_ERROR(
+        AWS_ERROR_INVALID_BUFFER_SIZE,
+        aws_xxhash3_tree_compute(allocator, 0, aws_byte_cursor_from_c_str(TEST_VECTOR), NULL, &too_small));
+    ASSERT_ERROR(
+        AWS_ERROR_INVALID_ARGUMENT,
+        aws_xxhash3_tree_compute(allocator, 0, aws_byte_cursor_from_array(NULL, 1), NULL, &tree));
+
+    struct aws_xxhash *hash = aws_xxhash3_tree_new(allocator, 0);
+    struct aws_xxhash3_seeded_hasher hasher;
+    aws_xxhash3_seeded_hasher_init(&hasher, 0);
+    ASSERT_ERROR(AWS_ERROR_INVALID_ARGUMENT, aws_xxhash_reset_seeded(hash, &hasher));
+    aws_xxhash_destroy(hash);
+
+    aws_mem_release(allocator, buffer);
+    aws_checksums_library_clean_up();
+
+    return AWS_OP_SUCCESS;
+}
+AWS_TEST_CASE(test_xxhash3_tree, s_test_xxhash3_tree)